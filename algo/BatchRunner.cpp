@@ -0,0 +1,244 @@
+#include "BatchRunner.h"
+#include "../util/FileIO.h"
+#include "../util/Logger.h"
+#include "../util/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <sys/stat.h>
+
+namespace algo
+{
+    namespace
+    {
+        /**
+         * The result of a single sequence
+         */
+        struct BatchResult
+        {
+            double load_time;
+            double time;
+            TrackStatistics statistics;
+            std::string error;
+        };
+
+        size_t GetFileSize(const std::string& file_name)
+        {
+            struct stat info;
+            if (stat(file_name.c_str(), &info) != 0)
+            {
+                return 0;
+            }
+            return (size_t) info.st_size;
+        }
+    }
+
+    void BatchSequence::Set(const std::string& name, const std::string& value)
+    {
+        if (name == "input-file") input_file = value;
+        else if (name == "output-path") output_path = value;
+        else if (name == "input-header") input_header = value;
+        else if (name == "image-width") image_width = std::atof(value.c_str());
+        else if (name == "image-height") image_height = std::atof(value.c_str());
+        else parameters.Set(name, value);
+    }
+
+    BatchRunner::BatchRunner(const BatchSequence& base)
+            : base_(base)
+    {
+    }
+
+    void BatchRunner::ReadManifest(const std::string& file_name, char delimiter)
+    {
+        std::ifstream in(file_name);
+        if (!in.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        std::vector<std::string> keys;
+        std::string line;
+        size_t line_number = 0;
+        while (std::getline(in, line))
+        {
+            ++line_number;
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::vector<std::string> values = util::FileIO::split(line, delimiter);
+            if (keys.empty())
+            {
+                keys = values;
+                continue;
+            }
+
+            if (values.size() > keys.size())
+            {
+                throw "Too many values in line " + std::to_string(line_number) +
+                      " of file: " + file_name;
+            }
+
+            BatchSequence sequence = base_;
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                if (!values[i].empty())
+                {
+                    sequence.Set(keys[i], values[i]);
+                }
+            }
+
+            if (sequence.input_file.empty() || sequence.output_path.empty())
+            {
+                throw "No input file or output path in line " + std::to_string(line_number) +
+                      " of file: " + file_name;
+            }
+
+            AddSequence(sequence);
+        }
+    }
+
+    void BatchRunner::AddSequence(const BatchSequence& sequence)
+    {
+        sequences_.push_back(sequence);
+        sequences_.back().cost = GetFileSize(sequence.input_file);
+    }
+
+    size_t BatchRunner::GetSequenceCount() const
+    {
+        return sequences_.size();
+    }
+
+    void BatchRunner::Run(const BatchFunction& load, const std::string& output_format,
+                          char delimiter, size_t thread_count, size_t max_in_flight,
+                          const std::string& summary_file)
+    {
+        size_t count = sequences_.size();
+        std::vector<BatchResult> results(count);
+        std::atomic<size_t> finished(0);
+
+        // The most expensive sequences first (longest processing time first)
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+        {
+            return sequences_[a].cost > sequences_[b].cost;
+        });
+
+        GBMOT_LOG_INFO("Running " + std::to_string(count) + " sequences");
+
+        {
+            util::ThreadPool pool(thread_count);
+            if (max_in_flight == 0)
+            {
+                max_in_flight = 2 * pool.GetThreadCount();
+            }
+
+            // Every finished sequence submits the next one, thus at most
+            // max_in_flight sequences are queued or running
+            std::mutex order_mutex;
+            size_t next = 0;
+            std::function<void()> submit_next;
+            auto run = [&](size_t i)
+            {
+                typedef std::chrono::steady_clock Clock;
+                const BatchSequence& sequence = sequences_[i];
+                BatchResult& result = results[i];
+                result.load_time = 0.0;
+                result.time = 0.0;
+                result.statistics = { 0, 0, 0.0, 0, 0 };
+
+                try
+                {
+                    Clock::time_point begin = Clock::now();
+                    core::DetectionSequence detections;
+                    load(sequence, detections);
+                    Clock::time_point loaded = Clock::now();
+
+                    std::vector<core::TrackletPtr> tracks;
+                    ParameterSweep::RunTracker(sequence.parameters, detections, tracks);
+                    Clock::time_point end = Clock::now();
+
+                    result.load_time = std::chrono::duration<double>(loaded - begin).count();
+                    result.time = std::chrono::duration<double>(end - loaded).count();
+                    result.statistics = ParameterSweep::GetStatistics(tracks);
+
+                    ParameterSweep::WriteTracks(tracks, sequence.output_path, output_format,
+                                                delimiter);
+                }
+                catch (std::string& e)
+                {
+                    result.error = e;
+                    util::Logger::LogError("Sequence " + sequence.input_file + " failed: " + e);
+                }
+                catch (std::exception& e)
+                {
+                    result.error = e.what();
+                    util::Logger::LogError("Sequence " + sequence.input_file + " failed: " +
+                                           result.error);
+                }
+
+                GBMOT_LOG_INFO("Finished sequence " + sequence.input_file +
+                               " (" + std::to_string(++finished) + "/" +
+                               std::to_string(count) + ")");
+            };
+            submit_next = [&]()
+            {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(order_mutex);
+                    if (next >= count) return;
+                    i = order[next++];
+                }
+                pool.Submit([&, i]()
+                            {
+                                run(i);
+                                submit_next();
+                            });
+            };
+
+            for (size_t i = 0; i < std::min(max_in_flight, count); ++i)
+            {
+                submit_next();
+            }
+            pool.Wait();
+        }
+
+        if (summary_file.empty()) return;
+
+        // Write the summary, one line per sequence in manifest order
+        std::ofstream out(summary_file);
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + summary_file;
+        }
+
+        out << "sequence" << delimiter << "input_file" << delimiter << "output_path"
+            << delimiter << "cost" << delimiter << "load_time" << delimiter << "time"
+            << delimiter << "track_count" << delimiter << "object_count"
+            << delimiter << "mean_length" << delimiter << "min_length"
+            << delimiter << "max_length" << delimiter << "error" << "\n";
+        for (size_t i = 0; i < count; ++i)
+        {
+            const BatchSequence& sequence = sequences_[i];
+            const BatchResult& result = results[i];
+            out << i << delimiter << sequence.input_file << delimiter << sequence.output_path
+                << delimiter << sequence.cost
+                << delimiter << result.load_time << delimiter << result.time
+                << delimiter << result.statistics.track_count
+                << delimiter << result.statistics.object_count
+                << delimiter << result.statistics.mean_length
+                << delimiter << result.statistics.min_length
+                << delimiter << result.statistics.max_length
+                << delimiter << result.error << "\n";
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef GBMOT_BATCHRUNNER_H
+#define GBMOT_BATCHRUNNER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "ParameterSweep.h"
+
+namespace algo
+{
+    /**
+     * A single sequence of a batch with its own settings.
+     * The names of the settings are the names of the command line options.
+     */
+    struct BatchSequence
+    {
+        std::string input_file;
+        std::string output_path;
+
+        /**
+         * The header of the input file, empty if the file has a header
+         */
+        std::string input_header;
+
+        double image_width;
+        double image_height;
+
+        TrackerParameters parameters;
+
+        /**
+         * The estimated cost of the sequence, the size of the input file
+         */
+        size_t cost;
+
+        /**
+         * Sets the setting with the given command line option name.
+         *
+         * @param name The option name, e.g. input-file or penalty-value
+         * @param value The value as written on the command line
+         */
+        void Set(const std::string& name, const std::string& value);
+    };
+
+    /**
+     * Function loading the detections of the given batch sequence.
+     * Called concurrently for different sequences.
+     */
+    typedef std::function<void(const BatchSequence&, core::DetectionSequence&)>
+            BatchFunction;
+
+    /**
+     * Runs a tracking algorithm for many independent sequences in one
+     * process. The sequences are run on a work stealing thread pool, the
+     * most expensive ones first, thus the threads finish at about the same
+     * time. A sequence is only loaded when it starts and is released after
+     * its tracks are written, the number of sequences queued or running is
+     * limited to keep the memory bounded.
+     */
+    class BatchRunner
+    {
+    private:
+        /**
+         * The settings of sequences without their own value
+         */
+        BatchSequence base_;
+
+        /**
+         * The sequences in manifest order
+         */
+        std::vector<BatchSequence> sequences_;
+    public:
+        /**
+         * Creates a new runner without any sequences.
+         *
+         * @param base The settings of sequences without their own value
+         */
+        BatchRunner(const BatchSequence& base);
+
+        /**
+         * Reads the sequences from the given manifest file.
+         * The first line is a header with command line option names, every
+         * following line is a sequence with its values for these options,
+         * all separated by the delimiter. Empty values keep the base value,
+         * input-file and output-path are required. Empty lines and lines
+         * starting with # are ignored.
+         *
+         * @param file_name The name of the manifest file
+         * @param delimiter The delimiter between the values
+         */
+        void ReadManifest(const std::string& file_name, char delimiter);
+
+        /**
+         * Adds a sequence to the batch.
+         *
+         * @param sequence The sequence to add
+         */
+        void AddSequence(const BatchSequence& sequence);
+
+        /**
+         * Gets the number of sequences in the batch.
+         *
+         * @return The sequence count
+         */
+        size_t GetSequenceCount() const;
+
+        /**
+         * Runs every sequence and writes its tracks into its output path.
+         * A sequence that fails is logged and does not stop the others.
+         *
+         * @param load The function loading the detections of a sequence
+         * @param output_format The format of the track files: wide, long or binary
+         * @param delimiter The delimiter of the track files and the summary
+         * @param thread_count The number of threads, zero uses all available
+         *                     hardware threads
+         * @param max_in_flight The maximum number of sequences queued or
+         *                      running at once, zero uses twice the thread count
+         * @param summary_file The file to write the time and track statistics
+         *                     of every sequence into, empty to not write it
+         */
+        void Run(const BatchFunction& load, const std::string& output_format, char delimiter,
+                 size_t thread_count, size_t max_in_flight, const std::string& summary_file);
+    };
+}
+
+
+#endif //GBMOT_BATCHRUNNER_H
@@ -5,6 +5,9 @@
 #include "Berclaz.h"
 #include "../util/Parser.h"
 #include "../util/Logger.h"
+#include "../util/FileIO.h"
+#include "../util/Profiler.h"
+#include "../util/Memory.h"
 #include "KShortestPaths.h"
 
 namespace algo
@@ -16,9 +19,16 @@ namespace algo
         vicinity_size_ = vicinity_size;
     }
 
+    void Berclaz::SetGraphDumpPath(const std::string& path)
+    {
+        graph_dump_path_ = path;
+    }
+
     void Berclaz::CreateGraph(DirectedGraph& graph, Vertex& source, Vertex& sink, util::Grid& grid)
     {
-        util::Logger::LogDebug("add vertices");
+        util::ScopedTimer timer("graph");
+
+        GBMOT_LOG_DEBUG("add vertices");
 
         // Add grid vertices
         for (int z = 0; z < grid.GetDepthCount(); ++z)
@@ -38,7 +48,7 @@ namespace algo
 
 //        util::Logger::LogDebug("source index: " + std::to_string(source));
 //        util::Logger::LogDebug("sink index: " + std::to_string(sink));
-        util::Logger::LogDebug("add edges");
+        GBMOT_LOG_DEBUG("add edges");
 
         // Iterate all vertices but source and sink
         VertexIndexMap vertices = boost::get(boost::vertex_index, graph);
@@ -101,11 +111,11 @@ namespace algo
             }
         }
 
-        util::Logger::LogDebug("vertex count " + std::to_string(boost::num_vertices(graph)));
+        GBMOT_LOG_DEBUG("vertex count " + std::to_string(boost::num_vertices(graph)));
 //        util::Logger::LogDebug("calculated vertex count " + std::to_string(
 //           grid.GetWidthCount() * grid.GetHeightCount() * grid.GetDepthCount() + 2
 //        ));
-        util::Logger::LogDebug("edge count " + std::to_string(boost::num_edges(graph)));
+        GBMOT_LOG_DEBUG("edge count " + std::to_string(boost::num_edges(graph)));
 //        util::Logger::LogDebug("width count " + std::to_string(grid.GetWidthCount()));
 //        util::Logger::LogDebug("height count " + std::to_string(grid.GetHeightCount()));
 //        util::Logger::LogDebug("depth count " + std::to_string(grid.GetDepthCount()));
@@ -143,50 +153,120 @@ namespace algo
                       size_t batch_size, size_t max_track_count,
                       std::vector<core::TrackletPtr>& tracks)
     {
-        for (size_t i = 0; i < sequence.GetFrameCount(); i += batch_size)
-        {
-            util::Logger::LogDebug("batch offset: " + std::to_string(i));
+        util::ScopedTimer timer("berclaz");
 
-            util::Grid grid = util::Parser::ParseGrid(sequence, i, i + batch_size,
-                                                      0.0, 1.0, h_res_, 0.0, 1.0, v_res_);
+        // Released frames of the sequence are skipped
+        size_t first_frame = sequence.GetFirstFrameIndex();
+        for (size_t i = first_frame; i < sequence.GetFrameCount(); i += batch_size)
+        {
+            RunBatch(sequence, i, i + batch_size, max_track_count, tracks);
+        }
 
-            util::Logger::LogDebug("create graph");
-            DirectedGraph graph;
-            Vertex source, sink;
-            CreateGraph(graph, source, sink, grid);
+        // Only connect tracks if the sequence was split
+        if (batch_size < sequence.GetFrameCount() - first_frame)
+        {
+            //TODO find a better way to connect tracks (n-stage)
+            GBMOT_LOG_DEBUG("connect tracks");
+            ConnectTracks(tracks);
+        }
+    }
 
-            util::Logger::LogDebug("run ksp");
-            KShortestPaths ksp(graph, source, sink);
-            ksp.Run(max_track_count);
+    void Berclaz::Run(util::DetectionStream& stream,
+                      size_t batch_size, size_t max_track_count,
+                      std::vector<core::TrackletPtr>& tracks)
+    {
+        util::ScopedTimer timer("berclaz");
 
-            util::Logger::LogDebug("get paths");
-            std::vector<std::vector<Vertex>> paths;
-            ksp.GetPaths(paths);
+        core::DetectionSequence sequence;
+        size_t batch_count = 0;
+        while (!stream.IsEnd())
+        {
+            size_t start = stream.GetNextFrameIndex();
+            stream.Read(sequence, batch_size);
 
-            util::Logger::LogDebug("extract tracks");
-            VertexValueMap values = boost::get(boost::vertex_name, graph);
-            for (auto path : paths)
+            if (start < sequence.GetFrameCount())
             {
-                core::TrackletPtr tlt(new core::Tracklet());
-                for (auto v : path)
-                {
-                    tlt->AddPathObject(values[v]);
-                }
-                tracks.push_back(tlt);
+                RunBatch(sequence, start, start + batch_size, max_track_count, tracks);
+                ++batch_count;
             }
+
+            // Only the objects referenced by the tracks are kept
+            sequence.ReleaseFrames(stream.GetNextFrameIndex());
         }
 
         // Only connect tracks if the sequence was split
-        if (batch_size < sequence.GetFrameCount())
+        if (batch_count > 1)
         {
-            //TODO find a better way to connect tracks (n-stage)
-            util::Logger::LogDebug("connect tracks");
+            GBMOT_LOG_DEBUG("connect tracks");
             ConnectTracks(tracks);
         }
     }
 
+    void Berclaz::RunBatch(core::DetectionSequence& sequence, size_t start, size_t stop,
+                           size_t max_track_count, std::vector<core::TrackletPtr>& tracks)
+    {
+        util::ScopedTimer timer("batch");
+
+        GBMOT_LOG_DEBUG("batch offset: " + std::to_string(start));
+
+        util::Grid grid = util::Parser::ParseGrid(sequence, start, stop,
+                                                  0.0, 1.0, h_res_, 0.0, 1.0, v_res_);
+
+        GBMOT_LOG_DEBUG("create graph");
+        DirectedGraph graph;
+        Vertex source, sink;
+        CreateGraph(graph, source, sink, grid);
+
+        if (util::Profiler::IsEnabled())
+        {
+            util::Memory::Record("grid", util::Memory::EstimateSize(grid));
+            util::Memory::Record("graph", util::Memory::EstimateSize(graph));
+        }
+
+        if (!graph_dump_path_.empty())
+        {
+            try
+            {
+                util::FileIO::WriteGraphBinary(graph, source, sink,
+                                               util::FileIO::GRAPH_SOLVER_K_SHORTEST_PATHS,
+                                               graph_dump_path_ + "/berclaz_"
+                                               + std::to_string(start) + ".gbg");
+            }
+            catch (std::string& e)
+            {
+                util::Logger::LogError(e);
+            }
+        }
+
+        GBMOT_LOG_DEBUG("run ksp");
+        KShortestPaths ksp(graph, source, sink);
+        ksp.Run(max_track_count);
+
+        GBMOT_LOG_DEBUG("get paths");
+        std::vector<std::vector<Vertex>> paths;
+        ksp.GetPaths(paths);
+
+        // The shortest paths are the largest structure of a batch
+        util::Memory::RecordResident();
+
+        GBMOT_LOG_DEBUG("extract tracks");
+        util::ScopedTimer extract_timer("extract");
+        VertexValueMap values = boost::get(boost::vertex_name, graph);
+        for (auto path : paths)
+        {
+            core::TrackletPtr tlt(new core::Tracklet());
+            for (auto v : path)
+            {
+                tlt->AddPathObject(values[v]);
+            }
+            tracks.push_back(tlt);
+        }
+    }
+
     void Berclaz::ConnectTracks(std::vector<core::TrackletPtr>& tracks)
     {
+        util::ScopedTimer timer("connect");
+
         for (size_t i = 0; i < tracks.size(); ++i)
         {
             // find the best matching tracklet
@@ -9,6 +9,7 @@
 #include "../core/DetectionSequence.h"
 #include "../core/Tracklet.h"
 #include "../util/Grid.h"
+#include "../util/DetectionStream.h"
 
 namespace algo
 {
@@ -38,6 +39,12 @@ namespace algo
          */
         int vicinity_size_;
 
+        /**
+         * The folder to write every created graph into, empty to not write
+         * the graphs
+         */
+        std::string graph_dump_path_;
+
         /**
          * Creates a graph from the given sequence.
          *
@@ -61,6 +68,18 @@ namespace algo
                            MultiPredecessorMap& map, Vertex origin,
                            std::vector<core::TrackletPtr>& tracks);
 
+        /**
+         * Runs the algorithm on the given frame range of the sequence.
+         *
+         * @param sequence The detection to use
+         * @param start The first frame of the batch
+         * @param stop The frame after the last frame of the batch
+         * @param max_track_count The maximum number of tracks to extract
+         * @param tracks The vector to add the found tracks to
+         */
+        void RunBatch(core::DetectionSequence& sequence, size_t start, size_t stop,
+                      size_t max_track_count, std::vector<core::TrackletPtr>& tracks);
+
         //TODO comment
         void ConnectTracks(std::vector<core::TrackletPtr>& tracks);
     public:
@@ -74,6 +93,14 @@ namespace algo
          */
         Berclaz(int h_res, int v_res, int vicinity_size);
 
+        /**
+         * Sets the folder to write every created graph into as a binary graph
+         * file named berclaz_<first batch frame>.gbg.
+         *
+         * @param path The folder to write into, empty to not write the graphs
+         */
+        void SetGraphDumpPath(const std::string& path);
+
         /**
          * Runs the algorithm on the given sequence. Splits the sequence into
          * batches to allow faster processing.
@@ -85,6 +112,20 @@ namespace algo
          */
         void Run(core::DetectionSequence& sequence, size_t batch_size,
                  size_t max_track_count, std::vector<core::TrackletPtr>& tracks);
+
+        /**
+         * Runs the algorithm on the detections read from the given stream.
+         * Only the frames of the current batch are read, the frames of
+         * finished batches are released afterwards, thus the memory usage is
+         * bounded by the batch size instead of the sequence length.
+         *
+         * @param stream The stream to read the detections from
+         * @param batch_size The number of frames one batch will have at maximum
+         * @param max_track_count The maximum number of tracks to extract
+         * @param tracks The vector to store the found tracks into
+         */
+        void Run(util::DetectionStream& stream, size_t batch_size,
+                 size_t max_track_count, std::vector<core::TrackletPtr>& tracks);
     };
 }
 
@@ -0,0 +1,85 @@
+#include "IterativeDijkstra.h"
+#include "../util/Logger.h"
+#include "../util/Profiler.h"
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <limits>
+
+namespace algo
+{
+    IterativeDijkstra::IterativeDijkstra(DirectedGraph& graph, Vertex source, Vertex sink)
+            : graph_(graph), source_(source), sink_(sink)
+    {
+        /* EMPTY */
+    }
+
+    void IterativeDijkstra::Run(size_t max_path_count)
+    {
+        paths_.clear();
+        metrics_.Clear();
+
+        size_t graph_size = boost::num_vertices(graph_);
+        metrics_.graph_vertex_count = graph_size;
+        metrics_.graph_edge_count = boost::num_edges(graph_);
+
+        std::vector<Vertex> pred_list(graph_size);
+        std::vector<double> dist_list(graph_size);
+        VertexIndexMap indices = boost::get(boost::vertex_index, graph_);
+        PredecessorMap pred_map(&pred_list[0], indices);
+        DistanceMap dist_map(&dist_list[0], indices);
+        EdgeWeightMap weight_map = boost::get(boost::edge_weight, graph_);
+
+        for (size_t i = 0; i != max_path_count; ++i)
+        {
+            GBMOT_LOG_DEBUG("dijkstra iteration: " + std::to_string(i));
+
+            {
+                util::ScopedTimer dijkstra_timer("shortest_paths");
+                boost::dijkstra_shortest_paths(graph_, source_,
+                                               boost::predecessor_map(pred_map)
+                                                       .distance_map(dist_map)
+                                                       .visitor(DijkstraMetricsVisitor(metrics_)));
+            }
+            ++metrics_.searches;
+
+            // No path from source to sink could be found
+            if (dist_map[sink_] == std::numeric_limits<double>::max())
+            {
+                break;
+            }
+
+            // Store the path and remove it by setting all edges leaving its
+            // inner vertices to a weight of infinity
+            std::vector<Vertex> path;
+            path.push_back(sink_);
+            for (Vertex u = pred_map[sink_], v = sink_; u != v; v = u, u = pred_map[v])
+            {
+                path.insert(path.begin(), u);
+
+                if (u != source_)
+                {
+                    OutEdgeIter oei, oei_end;
+                    for (boost::tie(oei, oei_end) = boost::out_edges(u, graph_);
+                         oei != oei_end;
+                         ++oei)
+                    {
+                        weight_map[*oei] = std::numeric_limits<double>::infinity();
+                    }
+                }
+            }
+            paths_.push_back(path);
+            ++metrics_.path_count;
+        }
+
+        GBMOT_LOG_DEBUG(std::to_string(paths_.size()) + " paths have been found");
+    }
+
+    void IterativeDijkstra::GetPaths(std::vector<std::vector<Vertex>>& paths) const
+    {
+        paths.insert(paths.end(), paths_.begin(), paths_.end());
+    }
+
+    const SolverMetrics& IterativeDijkstra::GetMetrics() const
+    {
+        return metrics_;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef GBMOT_ITERATIVEDIJKSTRA_H
+#define GBMOT_ITERATIVEDIJKSTRA_H
+
+#include "../graph/Definitions.h"
+#include "SolverMetrics.h"
+
+namespace algo
+{
+    /**
+     * Finds paths from the source to the sink one after another with
+     * dijkstra, as done by the n-stage tracker. After every path the out
+     * edges of its inner vertices get an infinite weight, thus no later path
+     * uses them. The paths are greedy, the first path is the shortest one.
+     */
+    class IterativeDijkstra
+    {
+    private:
+        /**
+         * The graph to search in, the weights of the used edges are altered
+         */
+        DirectedGraph& graph_;
+
+        /**
+         * The source vertex. This is where all paths start from
+         */
+        Vertex source_;
+
+        /**
+         * The sink vertex. This is where all paths end
+         */
+        Vertex sink_;
+
+        /**
+         * The found paths, every path from the source to the sink
+         */
+        std::vector<std::vector<Vertex>> paths_;
+
+        /**
+         * The work done by the last run
+         */
+        SolverMetrics metrics_;
+    public:
+        /**
+         * Initializes the algorithm for the specified graph with the specified source and sink
+         * vertex to find paths between.
+         *
+         * @param graph The graph to work with, the weights of the used edges are altered
+         * @param source The vertex to start all path searches from
+         * @param sink The vertex to end all path searches at
+         */
+        IterativeDijkstra(DirectedGraph& graph, Vertex source, Vertex sink);
+
+        /**
+         * Runs dijkstra until the specified number of paths is found or the
+         * sink can not be reached anymore.
+         *
+         * @param max_path_count The maximal number of paths to find
+         */
+        void Run(size_t max_path_count);
+
+        /**
+         * Gets the last found paths.
+         *
+         * @param paths The vector to store all found paths in
+         */
+        void GetPaths(std::vector<std::vector<Vertex>>& paths) const;
+
+        /**
+         * Gets the work done by the last run.
+         * The metrics are not recorded in the profiler, the caller records
+         * them in its own scope.
+         *
+         * @return The metrics of the last run
+         */
+        const SolverMetrics& GetMetrics() const;
+    };
+}
+
+
+#endif //GBMOT_ITERATIVEDIJKSTRA_H
@@ -9,6 +9,8 @@
 #include <iomanip>
 #include "KShortestPaths.h"
 #include "../util/Logger.h"
+#include "../util/Profiler.h"
+#include "../util/Memory.h"
 
 namespace algo
 {
@@ -22,8 +24,13 @@ namespace algo
 
     void KShortestPaths::Run(size_t max_path_count)
     {
+        util::ScopedTimer timer("shortest_paths");
+
         paths_.clear();
         sink_neighbors_.clear();
+        metrics_.Clear();
+        metrics_.graph_vertex_count = boost::num_vertices(orig_graph_);
+        metrics_.graph_edge_count = boost::num_edges(orig_graph_);
         switch (max_path_count)
         {
             case 0:
@@ -40,7 +47,18 @@ namespace algo
                 break;
         }
 
-        util::Logger::LogDebug(std::to_string(sink_neighbors_.size()) + " paths have been found");
+        GBMOT_LOG_DEBUG(std::to_string(sink_neighbors_.size()) + " paths have been found");
+
+        metrics_.path_count = sink_neighbors_.size();
+        metrics_.Record();
+        util::Memory::Record("transformed_graph",
+                             util::Memory::EstimateGraphSize(metrics_.transformed_vertex_count,
+                                                             metrics_.transformed_edge_count));
+    }
+
+    const SolverMetrics& KShortestPaths::GetMetrics() const
+    {
+        return metrics_;
     }
 
     bool KShortestPaths::FindPath(DirectedGraph& graph, Vertex& source, Vertex& sink,
@@ -50,7 +68,7 @@ namespace algo
         std::vector<Vertex> p(boost::num_vertices(graph));
         std::vector<Weight> d(boost::num_vertices(graph));
 
-        util::Logger::LogDebug("scan the graph for negative edge weights");
+        GBMOT_LOG_DEBUG("scan the graph for negative edge weights");
 
         // Scan the graph for negative edge weights to use the proper algorithm
         bool negative_edges = false;
@@ -65,15 +83,25 @@ namespace algo
         }
 
         if (negative_edges)
-            util::Logger::LogDebug("the graph contains negative edges");
+            GBMOT_LOG_DEBUG("the graph contains negative edges");
         else
-            util::Logger::LogDebug("the graph contains only positive edges");
+            GBMOT_LOG_DEBUG("the graph contains only positive edges");
+
+        GBMOT_LOG_DEBUG("run a single-source shortest paths algorithm");
 
-        util::Logger::LogDebug("run a single-source shortest paths algorithm");
+        ++metrics_.searches;
+        if (&graph != &orig_graph_)
+        {
+            metrics_.transformed_vertex_count = std::max(metrics_.transformed_vertex_count,
+                                                         boost::num_vertices(graph));
+            metrics_.transformed_edge_count = std::max(metrics_.transformed_edge_count,
+                                                       boost::num_edges(graph));
+        }
 
         if (negative_edges)
         {
             // Run bellman ford to find the single-source shortest paths
+            size_t pass_edges_left = 0;
             boost::bellman_ford_shortest_paths(
                     graph,
                     boost::num_vertices(graph),
@@ -83,7 +111,8 @@ namespace algo
                                             p.begin(), boost::get(boost::vertex_index, graph)))
                             .distance_map(
                                     boost::make_iterator_property_map(
-                                            d.begin(), boost::get(boost::vertex_index, graph))));
+                                            d.begin(), boost::get(boost::vertex_index, graph)))
+                            .visitor(BellmanFordMetricsVisitor(metrics_, pass_edges_left)));
         }
         else
         {
@@ -98,10 +127,11 @@ namespace algo
                             .distance_map(
                                     boost::make_iterator_property_map(
                                             d.begin(),
-                                            boost::get(boost::vertex_index, graph))));
+                                            boost::get(boost::vertex_index, graph)))
+                            .visitor(DijkstraMetricsVisitor(metrics_)));
         }
 
-        util::Logger::LogDebug("prepare a map of visited vertices to detect negative cycles");
+        GBMOT_LOG_DEBUG("prepare a map of visited vertices to detect negative cycles");
 
         // Record the vertices already visited to detect negative cycles (and store the distances)
         std::unordered_map<Vertex, bool> visited_vertices;
@@ -113,7 +143,7 @@ namespace algo
             distances[*vi] = d[*vi];
         }
 
-        util::Logger::LogDebug("insert the path into the output map (and detect negative cycles)");
+        GBMOT_LOG_DEBUG("insert the path into the output map (and detect negative cycles)");
 
         // Insert the path from the specified source to target into the specified map
         for (auto u = sink, v = p[u]; u != source; u = v, v = p[u])
@@ -143,7 +173,7 @@ namespace algo
         VertexIter vi, vi_end;
         EdgeIter ei, ei_end;
 
-        util::Logger::LogDebug("find the first path (in the original graph)");
+        GBMOT_LOG_DEBUG("find the first path (in the original graph)");
 
         // Find the first path
         VertexPredecessorMap orig_first_path;
@@ -154,7 +184,7 @@ namespace algo
         // every edge pointing on the path should end in the newly created vertex in the splitting
         // process
 
-        util::Logger::LogDebug("copy the original graph");
+        GBMOT_LOG_DEBUG("copy the original graph");
 
         // Create the graph to transform and create the map to map from vertices in the transformed
         // graph to vertices in the original graph, at first every vertex is mapped to itself
@@ -167,7 +197,7 @@ namespace algo
         // Transform the first path by inverting edges (and weights) and splitting nodes along the
         // path
 
-        util::Logger::LogDebug("reverse the first path");
+        GBMOT_LOG_DEBUG("reverse the first path");
 
         // Reverse the first path
         VertexPredecessorMap trans_first_path;
@@ -176,7 +206,7 @@ namespace algo
             trans_first_path[v] = u;
         }
 
-        util::Logger::LogDebug("invert the edges along the first path");
+        GBMOT_LOG_DEBUG("invert the edges along the first path");
 
         // Invert edges
         for (auto u = sink_, v = orig_first_path[u]; u != source_; u = v, v = orig_first_path[u])
@@ -197,7 +227,7 @@ namespace algo
             }
         }
 
-        util::Logger::LogDebug("split the nodes along the first path");
+        GBMOT_LOG_DEBUG("split the nodes along the first path");
 
         // Split nodes
         VertexPredecessorMap old_to_new;
@@ -230,7 +260,7 @@ namespace algo
             boost::add_edge(new_u, v, -w, trans_graph);
         }
 
-        util::Logger::LogDebug("extend the copied graph with the remaining edges");
+        GBMOT_LOG_DEBUG("extend the copied graph with the remaining edges");
 
         // Add all remaining edges
         for (boost::tie(ei, ei_end) = boost::edges(orig_graph_); ei != ei_end; ++ei)
@@ -262,13 +292,13 @@ namespace algo
             boost::add_edge(source, target, weight, trans_graph);
         }
 
-        util::Logger::LogDebug("find the second path (in the copied and transformed graph)");
+        GBMOT_LOG_DEBUG("find the second path (in the copied and transformed graph)");
 
         // Find the second path in the transformed graph
         VertexPredecessorMap trans_second_path;
         FindPath(trans_graph, source_, sink_, trans_second_path);
 
-        util::Logger::LogDebug("map the second path into the original graph");
+        GBMOT_LOG_DEBUG("map the second path into the original graph");
 
         // Map the second path from the transformed graph into the original graph
         VertexPredecessorMap orig_second_path;
@@ -281,7 +311,7 @@ namespace algo
             orig_second_path[orig_u] = orig_v;
         }
 
-        util::Logger::LogDebug("check if the two paths are already vertex disjoint");
+        GBMOT_LOG_DEBUG("check if the two paths are already vertex disjoint");
 
         // Check if the two paths have vertices (except source and sink) in common
         bool vertex_disjoint = true;
@@ -297,7 +327,7 @@ namespace algo
         // If the paths are not vertex disjoint, we need to remove the edges common to both paths
         if (!vertex_disjoint)
         {
-            util::Logger::LogDebug("remove edges used by both paths to guarantee vertex disjointness");
+            GBMOT_LOG_DEBUG("remove edges used by both paths to guarantee vertex disjointness");
 
             for (auto u = sink_, v = orig_first_path[u];
                  u != source_;
@@ -311,7 +341,7 @@ namespace algo
             }
         }
 
-        util::Logger::LogDebug("add the first and second path to the map of all paths");
+        GBMOT_LOG_DEBUG("add the first and second path to the map of all paths");
 
         // Store the paths
         AddPath(orig_first_path);
@@ -372,7 +402,7 @@ namespace algo
         VertexPredecessorMap orig_first_path;
         if (!FindPath(orig_graph_, source_, sink_, orig_first_path, orig_distances))
         {
-            util::Logger::LogInfo("Not even a single path could have been found!");
+            GBMOT_LOG_INFO("Not even a single path could have been found!");
             return;
         }
         AddPath(orig_first_path, k_orig_paths);
@@ -389,7 +419,7 @@ namespace algo
         // Find the specified amount of paths iteratively
         for (size_t i = 1; i < count; ++i)
         {
-            util::Logger::LogDebug("copy the original graph");
+            GBMOT_LOG_DEBUG("copy the original graph");
 
             // Create a graph used for transformations and start by copying the vertices
             DirectedGraph trans_graph;
@@ -398,7 +428,7 @@ namespace algo
                 boost::add_vertex(trans_graph);
             }
 
-            util::Logger::LogDebug("invert the edges along all previous found paths");
+            GBMOT_LOG_DEBUG("invert the edges along all previous found paths");
 
             // Invert edges for all previous paths (also invert their weight)
             std::vector<EdgeIter> edge_queue;
@@ -419,7 +449,7 @@ namespace algo
                 }
             }
 
-            util::Logger::LogDebug("split the nodes along all previous found path");
+            GBMOT_LOG_DEBUG("split the nodes along all previous found path");
 
             // Split nodes
             VertexPredecessorMap old_to_new;
@@ -453,7 +483,7 @@ namespace algo
                 boost::add_edge(new_target, source, -weight, trans_graph);
             }
 
-            util::Logger::LogDebug("extend the copied graph with the remaining edges");
+            GBMOT_LOG_DEBUG("extend the copied graph with the remaining edges");
 
             // Add all remaining edges
             for (auto e : edge_queue)
@@ -481,17 +511,17 @@ namespace algo
                 boost::add_edge(source, target, weight, trans_graph);
             }
 
-            util::Logger::LogDebug("find the second path (in the copied and transformed graph)");
+            GBMOT_LOG_DEBUG("find the second path (in the copied and transformed graph)");
 
             // Find the next path in the transformed graph
             VertexPredecessorMap trans_next_path;
             if (!FindPath(trans_graph, source_, sink_, trans_next_path))
             {
-                util::Logger::LogInfo("No more paths may be found!");
+                GBMOT_LOG_INFO("No more paths may be found!");
                 return;
             }
 
-            util::Logger::LogDebug("map the second path into the original graph");
+            GBMOT_LOG_DEBUG("map the second path into the original graph");
 
             // Map the second path from the transformed graph into the original graph
             VertexPredecessorMap orig_next_path;
@@ -505,7 +535,7 @@ namespace algo
 
             AddPath(orig_next_path, k_orig_paths);
 
-            util::Logger::LogDebug("remove edges used by multiple paths to guarantee vertex disjointness");
+            GBMOT_LOG_DEBUG("remove edges used by multiple paths to guarantee vertex disjointness");
 
             // Remove edges used by multiple paths
             for (auto pair : k_orig_paths)
@@ -521,7 +551,7 @@ namespace algo
                 }
             }
 
-            util::Logger::LogDebug("remove vertices with no edges from the path");
+            GBMOT_LOG_DEBUG("remove vertices with no edges from the path");
 
             // Remove empty vertices from the paths
             for (auto iter = k_orig_paths.begin(); iter != k_orig_paths.end(); )
@@ -5,6 +5,7 @@
 #ifndef GBMOT_KSHORTESTPATHS_H
 #define GBMOT_KSHORTESTPATHS_H
 #include "../graph/Definitions.h"
+#include "SolverMetrics.h"
 
 namespace algo
 {
@@ -41,6 +42,11 @@ namespace algo
          */
         std::vector<Vertex> sink_neighbors_;
 
+        /**
+         * The work done by the last run
+         */
+        SolverMetrics metrics_;
+
         /**
          * Finds the shortest path in the specified graph from source to sink.
          * Stores the predecessor vertices and the distances of the vertices.
@@ -115,6 +121,14 @@ namespace algo
          * @param paths The vector to store all found paths in
          */
         void GetPaths(std::vector<std::vector<Vertex>>& paths);
+
+        /**
+         * Gets the work done by the last run.
+         * The metrics are also recorded in the profiler if it is enabled.
+         *
+         * @return The metrics of the last run
+         */
+        const SolverMetrics& GetMetrics() const;
     };
 }
 
@@ -3,14 +3,18 @@
 //
 
 #include "NStage.h"
+#include "IterativeDijkstra.h"
 #include "../util/Logger.h"
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include "../util/FileIO.h"
+#include "../util/Profiler.h"
+#include "../util/Memory.h"
 
 namespace algo
 {
-    NStage::NStage(std::vector<size_t> max_frame_skip,
-                   std::vector<double> penalty_value,
-                   std::vector<size_t> max_tracklet_count)
+    template<typename Model>
+    NStage<Model>::NStage(std::vector<size_t> max_frame_skip,
+                          std::vector<double> penalty_value,
+                          std::vector<size_t> max_tracklet_count)
     {
         max_frame_skips_ = max_frame_skip;
         penalty_values_ = penalty_value;
@@ -18,9 +22,39 @@ namespace algo
         iterations_ = std::min(max_tracklet_count.size(), penalty_value.size());
     }
 
-    void NStage::CreateObjectGraph(DirectedGraph& graph, const core::DetectionSequence& detections)
+    template<typename Model>
+    void NStage<Model>::SetGraphDumpPath(const std::string& path)
     {
-        util::Logger::LogInfo("Creating object graph");
+        graph_dump_path_ = path;
+    }
+
+    template<typename Model>
+    void NStage<Model>::DumpGraph(DirectedGraph& graph, const std::string& name)
+    {
+        if (graph_dump_path_.empty() || boost::num_vertices(graph) < 2)
+        {
+            return;
+        }
+
+        try
+        {
+            util::FileIO::WriteGraphBinary(graph, 0, boost::num_vertices(graph) - 1,
+                                           util::FileIO::GRAPH_SOLVER_ITERATIVE_DIJKSTRA,
+                                           graph_dump_path_ + "/" + name);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError(e);
+        }
+    }
+
+    template<typename Model>
+    void NStage<Model>::CreateObjectGraph(DirectedGraph& graph,
+                                          const core::DetectionSequence& detections)
+    {
+        util::ScopedTimer timer("object_graph");
+
+        GBMOT_LOG_INFO("Creating object graph");
 
         std::vector<std::vector<Vertex>> layers;
 
@@ -30,7 +64,8 @@ namespace algo
         // Add vertices from detection sequence to directed graph
         // Save the vertices which are in one frame/layer for later use to
         // link easily between vertices in adjacent frames/layers
-        for (size_t i = 0; i < detections.GetFrameCount(); ++i)
+        // Released frames of the sequence are skipped
+        for (size_t i = detections.GetFirstFrameIndex(); i < detections.GetFrameCount(); ++i)
         {
             std::vector<Vertex> layer;
 
@@ -67,7 +102,7 @@ namespace algo
                         Vertex v = layers[i + k][l];
 
                         boost::add_edge(u, v,
-                                        values[u]->CompareTo(values[v]),
+                                        Model::Compare(*values[u], *values[v]),
                                         graph);
                     }
                 }
@@ -83,82 +118,47 @@ namespace algo
             }
         }
 
-        util::Logger::LogDebug("vertex count " + std::to_string(boost::num_vertices(graph)));
-        util::Logger::LogDebug("edge count " + std::to_string(boost::num_edges(graph)));
+        GBMOT_LOG_DEBUG("vertex count " + std::to_string(boost::num_vertices(graph)));
+        GBMOT_LOG_DEBUG("edge count " + std::to_string(boost::num_edges(graph)));
+
+        util::Memory::Record("graph", util::Memory::EstimateSize(graph));
+        util::Memory::RecordResident();
     }
 
-    void NStage::CreateTrackletGraph(DirectedGraph& obj_graph, DirectedGraph& tlt_graph,
-                                     size_t frame_count, size_t iteration)
+    template<typename Model>
+    void NStage<Model>::CreateTrackletGraph(DirectedGraph& obj_graph, DirectedGraph& tlt_graph,
+                                            size_t first_frame, size_t frame_count,
+                                            size_t iteration)
     {
-        util::Logger::LogInfo("Creating tracklet graph");
+        util::ScopedTimer timer("iteration_" + std::to_string(iteration));
+
+        GBMOT_LOG_INFO("Creating tracklet graph");
 
         // Add source to tracklet graph
         Vertex tlt_src = boost::add_vertex(
                 core::ObjectDataPtr(new core::ObjectData()), tlt_graph);
 
-        // Prepare variables for dijkstra
+        // Source and sink of the object graph
         size_t obj_graph_size = boost::num_vertices(obj_graph);
-        std::vector<Vertex> obj_pred_list(obj_graph_size);
-        std::vector<double> obj_dist_list(obj_graph_size);
         VertexIndexMap obj_indices = boost::get(boost::vertex_index, obj_graph);
         VertexValueMap obj_values = boost::get(boost::vertex_name, obj_graph);
-        PredecessorMap obj_pred_map(&obj_pred_list[0], obj_indices);
-        DistanceMap obj_dist_map(&obj_dist_list[0], obj_indices);
-
-        // Source and sink of the object graph
         Vertex obj_src = obj_indices[0];
         Vertex obj_snk = obj_indices[obj_graph_size - 1];
 
-        //TODO experimental
-        EdgeWeightMap weight_map = boost::get(boost::edge_weight, obj_graph);
-
         // Iteratively run dijkstra to extract tracklets
-        for (size_t i = 0; i != max_tracklet_counts_[iteration]; ++i)
-        {
-            util::Logger::LogDebug("tracklet iteration: " + std::to_string(i));
-
-            boost::dijkstra_shortest_paths(obj_graph, obj_src,
-                                           boost::predecessor_map(obj_pred_map)
-                                                   .distance_map(obj_dist_map));
-
-            // No path from source to sink could be found
-            if (obj_dist_map[obj_snk] == std::numeric_limits<double>::max())
-            {
-                break;
-            }
+        IterativeDijkstra dijkstra(obj_graph, obj_src, obj_snk);
+        dijkstra.Run(max_tracklet_counts_[iteration]);
+        SolverMetrics metrics = dijkstra.GetMetrics();
 
-            // Create the tracklet
+        std::vector<std::vector<Vertex>> paths;
+        dijkstra.GetPaths(paths);
+        for (auto& path : paths)
+        {
+            // Create the tracklet, source and sink are virtual and not added
             core::TrackletPtr tracklet(new core::Tracklet);
-            for (Vertex u = obj_pred_map[obj_snk], v = obj_snk; u != v; v = u, u = obj_pred_map[v])
+            for (size_t i = path.size() - 1; i-- > 0;)
             {
-                tracklet->AddPathObject(obj_values[u]);
-
-                // Leave source and sink untouched
-                if (!obj_values[u]->IsVirtual())
-                {
-                    //TODO original
-                    // Remove the path by setting all used edges to a weight of
-                    // infinity
-//                    std::pair<DirectedGraph::out_edge_iterator,
-//                              DirectedGraph::out_edge_iterator> edge_iter = boost::out_edges(u, obj_graph);
-//
-//                    for (DirectedGraph::out_edge_iterator iter = edge_iter.first;
-//                         iter != edge_iter.second;
-//                         ++iter)
-//                    {
-//                        boost::get(boost::edge_weight, obj_graph, *iter)
-//                                = std::numeric_limits<double>::infinity();
-//                    }
-
-                    //TODO experimental
-                    OutEdgeIter oei, oei_end;
-                    for (boost::tie(oei, oei_end) = boost::out_edges(u, obj_graph);
-                         oei != oei_end;
-                         ++oei)
-                    {
-                        weight_map[*oei] = std::numeric_limits<double>::infinity();
-                    }
-                }
+                tracklet->AddPathObject(obj_values[path[i]]);
             }
             core::ObjectDataPtr tracklet_base = tracklet;
 
@@ -170,13 +170,34 @@ namespace algo
         Vertex tlt_snk = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()),
                                   tlt_graph);
 
-        util::Logger::LogDebug("adding edges");
+        GBMOT_LOG_DEBUG("adding edges");
+        util::ScopedTimer edge_timer("tracklet_graph");
 
         // Create edges
         size_t tlt_graph_size = boost::num_vertices(tlt_graph);
         VertexIndexMap tlt_indices = boost::get(boost::vertex_index, tlt_graph);
         VertexValueMap tlt_values = boost::get(boost::vertex_name, tlt_graph);
 
+        // The innermost objects at both ends of every tracklet, the
+        // comparison of two tracklets compares the last object of the first
+        // with the first object of the second
+        std::vector<const core::ObjectData*> first_objects(tlt_graph_size);
+        std::vector<const core::ObjectData*> last_objects(tlt_graph_size);
+        for (size_t i = 1; i < tlt_graph_size - 1; ++i)
+        {
+            core::ObjectData* first = tlt_values[tlt_indices[i]].get();
+            core::ObjectData* last = first;
+            for (size_t depth = 0; depth <= iteration; ++depth)
+            {
+                core::Tracklet* first_tlt = static_cast<core::Tracklet*>(first);
+                core::Tracklet* last_tlt = static_cast<core::Tracklet*>(last);
+                first = first_tlt->GetPathObject(0).get();
+                last = last_tlt->GetPathObject(last_tlt->GetPathObjectCount() - 1).get();
+            }
+            first_objects[i] = first;
+            last_objects[i] = last;
+        }
+
         // For every tracklet but source and sink
         for (size_t i = 1; i < tlt_graph_size - 1; ++i)
         {
@@ -200,15 +221,15 @@ namespace algo
                             (v_first_frame - u_last_frame < max_frame_skips_[iteration]))
                     {
                         boost::add_edge(u, v,
-                                        tlt_values[u]->CompareTo(tlt_values[v]),
+                                        Model::Compare(*last_objects[i], *first_objects[j]),
                                         tlt_graph);
                     }
                 }
             }
 
-            // From source
+            // From source, the penalties are relative to the first frame
             boost::add_edge(tlt_src, u,
-                            (u_first_frame + 1) * penalty_values_[iteration],
+                            (u_first_frame - first_frame + 1) * penalty_values_[iteration],
                             tlt_graph);
 
             // To sink
@@ -217,14 +238,30 @@ namespace algo
                             tlt_graph);
         }
 
-        util::Logger::LogDebug("vertex count " + std::to_string(boost::num_vertices(tlt_graph)));
-        util::Logger::LogDebug("edge count " + std::to_string(boost::num_edges(tlt_graph)));
+        GBMOT_LOG_DEBUG("vertex count " + std::to_string(boost::num_vertices(tlt_graph)));
+        GBMOT_LOG_DEBUG("edge count " + std::to_string(boost::num_edges(tlt_graph)));
+
+        // The metrics belong to the whole iteration
+        edge_timer.Stop();
+
+        metrics.transformed_vertex_count = boost::num_vertices(tlt_graph);
+        metrics.transformed_edge_count = boost::num_edges(tlt_graph);
+        metrics.Record();
+        metrics_.Add(metrics);
+
+        util::Memory::Record("tracklet_graph", util::Memory::EstimateSize(tlt_graph));
+        util::Memory::RecordResident();
+
+        DumpGraph(tlt_graph, "nstage_tracklets_" + std::to_string(iteration) + ".gbg");
     }
 
-    void NStage::ExtractTracks(DirectedGraph& tlt_graph, size_t depth,
-                               std::vector<core::TrackletPtr>& tracks)
+    template<typename Model>
+    void NStage<Model>::ExtractTracks(DirectedGraph& tlt_graph, size_t depth,
+                                      std::vector<core::TrackletPtr>& tracks)
     {
-        util::Logger::LogInfo("Extracting tracks");
+        util::ScopedTimer timer("extract");
+
+        GBMOT_LOG_INFO("Extracting tracks");
 
         VertexValueMap tlt_values = boost::get(boost::vertex_name, tlt_graph);
         for (size_t i = 0; i < boost::num_vertices(tlt_graph); ++i)
@@ -243,30 +280,43 @@ namespace algo
             }
         }
 
-        util::Logger::LogDebug("track count " + std::to_string(tracks.size()));
+        GBMOT_LOG_DEBUG("track count " + std::to_string(tracks.size()));
+    }
+
+    template<typename Model>
+    const SolverMetrics& NStage<Model>::GetMetrics() const
+    {
+        return metrics_;
     }
 
-    void NStage::Run(const core::DetectionSequence& sequence,
-                     std::vector<core::TrackletPtr>& tracks)
+    template<typename Model>
+    void NStage<Model>::Run(const core::DetectionSequence& sequence,
+                            std::vector<core::TrackletPtr>& tracks)
     {
+        util::ScopedTimer timer("n-stage");
+        metrics_.Clear();
+
         // Running the two stage graph algorithm
         DirectedGraph obj_graph;
         CreateObjectGraph(obj_graph, sequence);
+        DumpGraph(obj_graph, "nstage_objects.gbg");
 
         // Run the tracklet creation at least once
         DirectedGraph tlt_graph_1, tlt_graph_2;
-        CreateTrackletGraph(obj_graph, tlt_graph_1, sequence.GetFrameCount(), 0);
+        size_t first_frame = sequence.GetFirstFrameIndex();
+        size_t frame_count = sequence.GetFrameCount();
+        CreateTrackletGraph(obj_graph, tlt_graph_1, first_frame, frame_count, 0);
 
         // Run the tracklet creation iteratively
         for (size_t i = 1; i < iterations_; ++i)
         {
             if (i % 2 == 0)
             {
-                CreateTrackletGraph(tlt_graph_2, tlt_graph_1, sequence.GetFrameCount(), i);
+                CreateTrackletGraph(tlt_graph_2, tlt_graph_1, first_frame, frame_count, i);
             }
             else
             {
-                CreateTrackletGraph(tlt_graph_1, tlt_graph_2, sequence.GetFrameCount(), i);
+                CreateTrackletGraph(tlt_graph_1, tlt_graph_2, first_frame, frame_count, i);
             }
         }
 
@@ -280,4 +330,8 @@ namespace algo
             ExtractTracks(tlt_graph_1, iterations_ - 1, tracks);
         }
     }
+
+    template class NStage<core::ObjectModel2D>;
+    template class NStage<core::ObjectModelBox>;
+    template class NStage<core::ObjectModelAngular>;
 }
\ No newline at end of file
@@ -6,15 +6,23 @@
 #define GBMOT_NSTAGE_H
 
 #include "../core/DetectionSequence.h"
+#include "../core/ObjectModel.h"
 #include "../core/Tracklet.h"
 #include "../graph/Definitions.h"
+#include "SolverMetrics.h"
 
 namespace algo
 {
     /**
      * Implementation of the two-staged graph-based multi-object tracker.
      * Extended to allow N stages.
+     * The object model compares the detections when creating the edges, every
+     * detection needs to be of the type of the model. The algorithm is
+     * instantiated for the models in ObjectModel.h.
+     *
+     * @tparam Model The object model, e.g. core::ObjectModel2D
      */
+    template<typename Model>
     class NStage
     {
     private:
@@ -38,6 +46,25 @@ namespace algo
          */
         size_t iterations_;
 
+        /**
+         * The folder to write every created graph into, empty to not write
+         * the graphs
+         */
+        std::string graph_dump_path_;
+
+        /**
+         * The work done by the last run, summed over all iterations
+         */
+        SolverMetrics metrics_;
+
+        /**
+         * Writes the given graph into the graph dump folder, if set.
+         * The source is the first and the sink the last vertex of the graph.
+         * @param graph The graph to write
+         * @param name The file name of the graph inside the folder
+         */
+        void DumpGraph(DirectedGraph& graph, const std::string& name);
+
         /**
          * Creates a graph with vertices for every detected object
          * @param graph The graph to write into
@@ -49,11 +76,12 @@ namespace algo
          * Reduces the object graph into linked tracklets.
          * @param obj_graph The object graph to reduce
          * @param tlt_graph The graph to write the tracklets in
+         * @param first_frame The first frame of the object graph
          * @param frame_count The frame count of the object graph
          * @param iteration The current iteration
          */
         void CreateTrackletGraph(DirectedGraph& obj_graph, DirectedGraph& tlt_graph,
-                                 size_t frame_count, size_t iteration);
+                                 size_t first_frame, size_t frame_count, size_t iteration);
 
         /**
          * Extracts the finished tracks from the given tracklet graph.
@@ -76,6 +104,14 @@ namespace algo
                std::vector<double> penalty_value,
                std::vector<size_t> max_tracklet_count);
 
+        /**
+         * Sets the folder to write every created graph into as binary graph
+         * files, the object graph is named nstage_objects.gbg and the tracklet
+         * graph of every iteration nstage_tracklets_<iteration>.gbg.
+         * @param path The folder to write into, empty to not write the graphs
+         */
+        void SetGraphDumpPath(const std::string& path);
+
         /**
          * Runs the algorithm on the specified sequence and stores the found tracks into the
          * specified tracks vector.
@@ -85,6 +121,16 @@ namespace algo
          */
         void Run(const core::DetectionSequence& sequence,
                  std::vector<core::TrackletPtr>& tracks);
+
+        /**
+         * Gets the work done by the last run, summed over all iterations.
+         * The object graph is the input graph, the tracklet graph the
+         * transformed graph of an iteration. The metrics of every iteration
+         * are also recorded in the profiler if it is enabled.
+         *
+         * @return The metrics of the last run
+         */
+        const SolverMetrics& GetMetrics() const;
     };
 }
 
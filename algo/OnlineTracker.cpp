@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <unordered_set>
+#include "OnlineTracker.h"
+#include "../util/FileIO.h"
+#include "../util/Logger.h"
+
+namespace algo
+{
+    OnlineTracker::OnlineTracker(TrackingFunction run, size_t latency)
+    {
+        run_ = run;
+        latency_ = latency;
+        history_ = std::max(latency, (size_t) 1);
+        next_id_ = 0;
+        next_final_frame_ = 0;
+    }
+
+    void OnlineTracker::Run(util::DetectionStream& stream, std::ostream& out, char delimiter)
+    {
+        std::vector<TrackAssignment> assignments;
+        while (!stream.IsEnd())
+        {
+            assignments.clear();
+            AddFrames([&stream](core::DetectionSequence& window)
+                      {
+                          stream.Read(window, 1);
+                      }, assignments);
+            Write(assignments, out, delimiter);
+        }
+
+        assignments.clear();
+        Finish(assignments);
+        Write(assignments, out, delimiter);
+    }
+
+    void OnlineTracker::AddFrames(const FrameFunction& read,
+                                  std::vector<TrackAssignment>& assignments)
+    {
+        size_t first_frame = sequence_.GetFrameCount();
+        read(sequence_);
+        size_t end_frame = sequence_.GetFrameCount();
+
+        for (size_t frame = first_frame; frame < end_frame; ++frame)
+        {
+            for (size_t i = 0; i < sequence_.GetObjectCount(frame); ++i)
+            {
+                core::ObjectDataPtr obj = sequence_.GetObject(frame, i);
+                scores_[obj.get()] = obj->GetDetectionScore();
+            }
+        }
+
+        // Finalize the frames that just left the window
+        if (next_final_frame_ + latency_ < end_frame)
+        {
+            std::vector<core::TrackletPtr> tracks;
+            RunWindow(tracks);
+            while (next_final_frame_ + latency_ < end_frame)
+            {
+                Finalize(next_final_frame_, tracks, assignments);
+            }
+            ReleaseFrames();
+        }
+    }
+
+    void OnlineTracker::Finish(std::vector<TrackAssignment>& assignments)
+    {
+        // Finalize the remaining frames with the last window
+        if (next_final_frame_ < sequence_.GetFrameCount())
+        {
+            std::vector<core::TrackletPtr> tracks;
+            RunWindow(tracks);
+            while (next_final_frame_ < sequence_.GetFrameCount())
+            {
+                Finalize(next_final_frame_, tracks, assignments);
+            }
+        }
+
+        GBMOT_LOG_INFO("Online tracking finished with " + std::to_string(next_id_)
+                              + " tracks");
+    }
+
+    size_t OnlineTracker::GetNextFrameIndex() const
+    {
+        return sequence_.GetFrameCount();
+    }
+
+    void OnlineTracker::RunWindow(std::vector<core::TrackletPtr>& tracks)
+    {
+        GBMOT_LOG_DEBUG("window " + std::to_string(sequence_.GetFirstFrameIndex())
+                               + " to " + std::to_string(sequence_.GetFrameCount()));
+
+        // Every window starts with the original scores
+        for (auto& score : scores_)
+        {
+            score.first->SetDetectionScore(score.second);
+        }
+
+        tracks.clear();
+        run_(sequence_, tracks);
+    }
+
+    void OnlineTracker::Finalize(size_t frame, std::vector<core::TrackletPtr>& tracks,
+                                 std::vector<TrackAssignment>& assignments)
+    {
+        // Find the latest finalized object of every track
+        std::vector<std::pair<size_t, size_t>> order;
+        std::vector<size_t> track_ids(tracks.size(), 0);
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            for (size_t j = tracks[i]->GetPathObjectCount(); j > 0; --j)
+            {
+                core::ObjectDataPtr obj = tracks[i]->GetPathObject(j - 1);
+                auto id = ids_.find(obj.get());
+                if (obj->GetFrameIndex() < frame && id != ids_.end())
+                {
+                    order.push_back(std::make_pair(obj->GetFrameIndex(), i));
+                    track_ids[i] = id->second;
+                    break;
+                }
+            }
+        }
+
+        // The track with the most recent object keeps the id if two tracks
+        // claim the same id
+        std::sort(order.begin(), order.end(), std::greater<std::pair<size_t, size_t>>());
+        std::unordered_set<size_t> used_ids;
+        std::vector<bool> has_id(tracks.size(), false);
+        for (auto& entry : order)
+        {
+            if (used_ids.insert(track_ids[entry.second]).second)
+            {
+                has_id[entry.second] = true;
+            }
+        }
+
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            core::ObjectDataPtr obj = tracks[i]->GetFrameObject(frame);
+            if (obj == nullptr)
+            {
+                continue;
+            }
+
+            if (!has_id[i])
+            {
+                track_ids[i] = next_id_++;
+            }
+
+            // Only detections can be part of later windows, interpolated
+            // objects are created anew with every window
+            if (scores_.count(obj.get()) > 0)
+            {
+                ids_[obj.get()] = track_ids[i];
+            }
+
+            assignments.push_back({ frame, track_ids[i], obj });
+        }
+
+        next_final_frame_ = frame + 1;
+    }
+
+    void OnlineTracker::Write(const std::vector<TrackAssignment>& assignments,
+                              std::ostream& out, char delimiter) const
+    {
+        std::string buffer;
+        for (auto& assignment : assignments)
+        {
+            util::FileIO::AppendTrackObject(buffer, assignment.frame, assignment.id,
+                                            assignment.object, delimiter);
+        }
+
+        out << buffer;
+        out.flush();
+    }
+
+    void OnlineTracker::ReleaseFrames()
+    {
+        if (next_final_frame_ <= history_)
+        {
+            return;
+        }
+
+        size_t first_frame = next_final_frame_ - history_;
+        for (size_t frame = sequence_.GetFirstFrameIndex(); frame < first_frame; ++frame)
+        {
+            for (size_t i = 0; i < sequence_.GetObjectCount(frame); ++i)
+            {
+                core::ObjectData* obj = sequence_.GetObject(frame, i).get();
+                scores_.erase(obj);
+                ids_.erase(obj);
+            }
+        }
+
+        sequence_.ReleaseFrames(first_frame);
+    }
+}
@@ -0,0 +1,175 @@
+#ifndef GBMOT_ONLINETRACKER_H
+#define GBMOT_ONLINETRACKER_H
+
+#include <functional>
+#include <ostream>
+#include <unordered_map>
+#include "../core/DetectionSequence.h"
+#include "../core/Tracklet.h"
+#include "../util/DetectionStream.h"
+
+namespace algo
+{
+    /**
+     * Function running an offline tracking algorithm on the given sequence
+     * and storing the found tracks into the given vector.
+     */
+    typedef std::function<void(core::DetectionSequence&, std::vector<core::TrackletPtr>&)>
+            TrackingFunction;
+
+    /**
+     * Function adding the detections of the next frames to the given window.
+     */
+    typedef std::function<void(core::DetectionSequence&)> FrameFunction;
+
+    /**
+     * The final track id of an object.
+     */
+    struct TrackAssignment
+    {
+        size_t frame;
+        size_t id;
+        core::ObjectDataPtr object;
+    };
+
+    /**
+     * Tracks objects online with a fixed latency.
+     * The detections are read frame by frame and an offline algorithm is run
+     * on a sliding window over the last frames. A frame is finalized as soon
+     * as the given number of later frames is known, its track assignments are
+     * written and never changed again.
+     * The track ids stay stable because the finalized objects are kept inside
+     * the window for some frames and a track containing such an object
+     * inherits its id.
+     */
+    class OnlineTracker
+    {
+    private:
+        /**
+         * The algorithm to run on the window
+         */
+        TrackingFunction run_;
+
+        /**
+         * The number of frames read after a frame before it is finalized
+         */
+        size_t latency_;
+
+        /**
+         * The number of finalized frames kept in the window
+         */
+        size_t history_;
+
+        /**
+         * The id of the next new track
+         */
+        size_t next_id_;
+
+        /**
+         * The first frame that is not finalized
+         */
+        size_t next_final_frame_;
+
+        /**
+         * The detections inside the window
+         */
+        core::DetectionSequence sequence_;
+
+        /**
+         * The original detection scores of the objects inside the window,
+         * the algorithms may modify the scores
+         */
+        std::unordered_map<core::ObjectData*, double> scores_;
+
+        /**
+         * The track ids of the finalized objects inside the window
+         */
+        std::unordered_map<core::ObjectData*, size_t> ids_;
+
+        /**
+         * Runs the algorithm on the current window.
+         *
+         * @param tracks The vector to store the found tracks into
+         */
+        void RunWindow(std::vector<core::TrackletPtr>& tracks);
+
+        /**
+         * Assigns ids to all tracks containing an object in the specified
+         * frame.
+         *
+         * @param frame The frame to finalize
+         * @param tracks The tracks found in the current window
+         * @param assignments The vector to append the assignments to
+         */
+        void Finalize(size_t frame, std::vector<core::TrackletPtr>& tracks,
+                      std::vector<TrackAssignment>& assignments);
+
+        /**
+         * Writes the given assignments in the long track format and flushes
+         * the stream.
+         *
+         * @param assignments The assignments to write
+         * @param out The stream to write the assignments to
+         * @param delimiter The value delimiter
+         */
+        void Write(const std::vector<TrackAssignment>& assignments, std::ostream& out,
+                   char delimiter) const;
+
+        /**
+         * Removes all frames from the window that are no longer needed to
+         * keep the track ids stable.
+         */
+        void ReleaseFrames();
+    public:
+        /**
+         * Instantiates with the given parameters.
+         *
+         * @param run The algorithm to run on every window
+         * @param latency The number of frames read after a frame before it is
+         *                finalized
+         */
+        OnlineTracker(TrackingFunction run, size_t latency);
+
+        /**
+         * Reads the stream frame by frame until its end and writes the track
+         * assignments of every finalized frame in the long track format
+         * (frame, id, x, y, width, height, score). The output is flushed after
+         * every frame.
+         *
+         * @param stream The stream to read the detections from
+         * @param out The stream to write the assignments to
+         * @param delimiter The value delimiter
+         */
+        void Run(util::DetectionStream& stream, std::ostream& out, char delimiter);
+
+        /**
+         * Adds the detections of the next frames and finalizes every frame
+         * that has enough later frames. The read function has to add only
+         * objects in frames at or after the next frame index and extends the
+         * frame count to include frames without detections.
+         *
+         * @param read The function adding the detections to the window
+         * @param assignments The vector to append the assignments of the
+         *                    finalized frames to
+         */
+        void AddFrames(const FrameFunction& read, std::vector<TrackAssignment>& assignments);
+
+        /**
+         * Finalizes all remaining frames with the current window.
+         *
+         * @param assignments The vector to append the assignments of the
+         *                    finalized frames to
+         */
+        void Finish(std::vector<TrackAssignment>& assignments);
+
+        /**
+         * Gets the index of the first frame that was not added yet.
+         *
+         * @return The index of the next frame
+         */
+        size_t GetNextFrameIndex() const;
+    };
+}
+
+
+#endif //GBMOT_ONLINETRACKER_H
@@ -0,0 +1,412 @@
+#include "ParameterSweep.h"
+#include "NStage.h"
+#include "Berclaz.h"
+#include "../util/FileIO.h"
+#include "../util/Logger.h"
+#include "../util/Profiler.h"
+#include "../util/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace algo
+{
+    namespace
+    {
+        /**
+         * The result of a single configuration
+         */
+        struct SweepResult
+        {
+            TrackerParameters parameters;
+            double load_time;
+            double time;
+            TrackStatistics statistics;
+            util::EvaluationMetrics metrics;
+            std::string error;
+        };
+
+        /**
+         * Parses comma separated values, like the command line does.
+         */
+        std::vector<size_t> ParseCounts(const std::string& values)
+        {
+            std::vector<size_t> counts;
+            for (auto& part : util::FileIO::split(values, ','))
+            {
+                if (part.size() > 0)
+                {
+                    counts.push_back((size_t) atoi(part.c_str()));
+                }
+            }
+            return counts;
+        }
+
+        std::vector<double> ParseValues(const std::string& values)
+        {
+            std::vector<double> parsed;
+            for (auto& part : util::FileIO::split(values, ','))
+            {
+                if (part.size() > 0)
+                {
+                    parsed.push_back(std::atof(part.c_str()));
+                }
+            }
+            return parsed;
+        }
+
+        std::string ToString(double value)
+        {
+            std::ostringstream out;
+            out << value;
+            return out.str();
+        }
+
+        template<typename Model>
+        void RunNStage(const TrackerParameters& parameters,
+                       const core::DetectionSequence& sequence,
+                       std::vector<core::TrackletPtr>& tracks,
+                       const std::string& graph_dump_path)
+        {
+            std::vector<size_t> max_frame_skips = ParseCounts(parameters.max_frame_skip);
+            std::vector<double> penalty_values = ParseValues(parameters.penalty_value);
+            std::vector<size_t> max_tracklet_counts = ParseCounts(parameters.max_tracklet_count);
+
+            // Every stage needs all of its values
+            if (max_frame_skips.empty() || penalty_values.size() != max_frame_skips.size() ||
+                max_tracklet_counts.size() != max_frame_skips.size())
+            {
+                throw "The n-stage values max-frame-skip (" + parameters.max_frame_skip +
+                      "), penalty-value (" + parameters.penalty_value +
+                      ") and max-tracklet-count (" + parameters.max_tracklet_count +
+                      ") need the same number of stages";
+            }
+
+            NStage<Model> n_stage(max_frame_skips, penalty_values, max_tracklet_counts);
+            n_stage.SetGraphDumpPath(graph_dump_path);
+            n_stage.Run(sequence, tracks);
+        }
+    }
+
+    void TrackerParameters::Set(const std::string& name, const std::string& value)
+    {
+        if (name == "algorithm") algorithm = value;
+        else if (name == "input-format") input_format = value;
+        else if (name == "max-frame-skip") max_frame_skip = value;
+        else if (name == "penalty-value") penalty_value = value;
+        else if (name == "max-tracklet-count") max_tracklet_count = value;
+        else if (name == "temporal-weight") temporal_weight = std::atof(value.c_str());
+        else if (name == "spatial-weight") spatial_weight = std::atof(value.c_str());
+        else if (name == "angular-weight") angular_weight = std::atof(value.c_str());
+        else if (name == "horizontal-resolution") h_res = std::atoi(value.c_str());
+        else if (name == "vertical-resolution") v_res = std::atoi(value.c_str());
+        else if (name == "vicinity-size") vicinity_size = std::atoi(value.c_str());
+        else if (name == "batch-size") batch_size = (size_t) std::atol(value.c_str());
+        else if (name == "max-track-count") max_track_count = (size_t) std::atol(value.c_str());
+        else throw "Unknown tracker parameter: " + name;
+    }
+
+    std::string TrackerParameters::Get(const std::string& name) const
+    {
+        if (name == "algorithm") return algorithm;
+        if (name == "input-format") return input_format;
+        if (name == "max-frame-skip") return max_frame_skip;
+        if (name == "penalty-value") return penalty_value;
+        if (name == "max-tracklet-count") return max_tracklet_count;
+        if (name == "temporal-weight") return ToString(temporal_weight);
+        if (name == "spatial-weight") return ToString(spatial_weight);
+        if (name == "angular-weight") return ToString(angular_weight);
+        if (name == "horizontal-resolution") return std::to_string(h_res);
+        if (name == "vertical-resolution") return std::to_string(v_res);
+        if (name == "vicinity-size") return std::to_string(vicinity_size);
+        if (name == "batch-size") return std::to_string(batch_size);
+        if (name == "max-track-count") return std::to_string(max_track_count);
+        throw "Unknown tracker parameter: " + name;
+    }
+
+    ParameterSweep::ParameterSweep(const TrackerParameters& base)
+            : base_(base)
+    {
+    }
+
+    void ParameterSweep::ReadGrid(const std::string& file_name, char delimiter)
+    {
+        std::ifstream in(file_name);
+        if (!in.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+
+            std::vector<std::string> parts = util::FileIO::split(line, delimiter);
+            std::vector<std::string> values(parts.begin() + 1, parts.end());
+            AddParameter(parts[0], values);
+        }
+    }
+
+    void ParameterSweep::AddParameter(const std::string& name,
+                                      const std::vector<std::string>& values)
+    {
+        if (values.empty())
+        {
+            throw "No values for sweep parameter: " + name;
+        }
+
+        // Fails for unknown names
+        TrackerParameters parameters = base_;
+        parameters.Set(name, values[0]);
+
+        grid_.push_back(std::make_pair(name, values));
+    }
+
+    void ParameterSweep::SetEvaluator(util::EvaluatorPtr evaluator)
+    {
+        evaluator_ = evaluator;
+    }
+
+    size_t ParameterSweep::GetConfigurationCount() const
+    {
+        size_t count = 1;
+        for (auto& parameter : grid_)
+        {
+            count *= parameter.second.size();
+        }
+        return count;
+    }
+
+    TrackerParameters ParameterSweep::CreateConfiguration(size_t index) const
+    {
+        // The last parameter changes fastest
+        TrackerParameters parameters = base_;
+        for (size_t i = grid_.size(); i-- > 0;)
+        {
+            const std::vector<std::string>& values = grid_[i].second;
+            parameters.Set(grid_[i].first, values[index % values.size()]);
+            index /= values.size();
+        }
+        return parameters;
+    }
+
+    void ParameterSweep::Run(const SequenceFunction& load, const std::string& output_path,
+                             const std::string& output_format, char delimiter,
+                             size_t thread_count)
+    {
+        size_t count = GetConfigurationCount();
+        std::vector<SweepResult> results(count);
+        std::atomic<size_t> finished(0);
+
+        mkdir(output_path.c_str(), 0755);
+
+        GBMOT_LOG_INFO("Running " + std::to_string(count) + " configurations");
+
+        {
+            util::ThreadPool pool(thread_count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                pool.Submit([&, i]()
+                            {
+                                typedef std::chrono::steady_clock Clock;
+                                SweepResult& result = results[i];
+                                result.parameters = CreateConfiguration(i);
+                                result.load_time = 0.0;
+                                result.time = 0.0;
+                                result.statistics = { 0, 0, 0.0, 0, 0 };
+                                result.metrics = util::EvaluationMetrics();
+
+                                try
+                                {
+                                    // Every configuration gets its own objects
+                                    Clock::time_point begin = Clock::now();
+                                    core::DetectionSequence sequence;
+                                    load(result.parameters, sequence);
+                                    Clock::time_point loaded = Clock::now();
+
+                                    std::vector<core::TrackletPtr> tracks;
+                                    RunTracker(result.parameters, sequence, tracks);
+                                    Clock::time_point end = Clock::now();
+
+                                    result.load_time =
+                                            std::chrono::duration<double>(loaded - begin).count();
+                                    result.time =
+                                            std::chrono::duration<double>(end - loaded).count();
+                                    result.statistics = GetStatistics(tracks);
+                                    if (evaluator_)
+                                    {
+                                        result.metrics = evaluator_->Evaluate(tracks);
+                                    }
+
+                                    WriteTracks(tracks, output_path + "/" + std::to_string(i),
+                                                output_format, delimiter);
+                                }
+                                catch (std::string& e)
+                                {
+                                    result.error = e;
+                                    util::Logger::LogError("Configuration " + std::to_string(i) +
+                                                           " failed: " + e);
+                                }
+                                catch (std::exception& e)
+                                {
+                                    result.error = e.what();
+                                    util::Logger::LogError("Configuration " + std::to_string(i) +
+                                                           " failed: " + result.error);
+                                }
+
+                                GBMOT_LOG_INFO("Finished configuration " + std::to_string(i) +
+                                               " (" + std::to_string(++finished) + "/" +
+                                               std::to_string(count) + ")");
+                            });
+            }
+            pool.Wait();
+        }
+
+        // Write the summary, one line per configuration
+        std::string summary_file = output_path + "/sweep.csv";
+        std::ofstream out(summary_file);
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + summary_file;
+        }
+
+        out << "configuration";
+        for (auto& parameter : grid_)
+        {
+            out << delimiter << parameter.first;
+        }
+        out << delimiter << "load_time" << delimiter << "time"
+            << delimiter << "track_count" << delimiter << "object_count"
+            << delimiter << "mean_length" << delimiter << "min_length"
+            << delimiter << "max_length";
+        if (evaluator_)
+        {
+            for (auto& name : util::Evaluator::GetMetricNames())
+            {
+                out << delimiter << name;
+            }
+        }
+        out << delimiter << "error" << "\n";
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const SweepResult& result = results[i];
+            out << i;
+            for (auto& parameter : grid_)
+            {
+                out << delimiter << result.parameters.Get(parameter.first);
+            }
+            out << delimiter << result.load_time << delimiter << result.time
+                << delimiter << result.statistics.track_count
+                << delimiter << result.statistics.object_count
+                << delimiter << result.statistics.mean_length
+                << delimiter << result.statistics.min_length
+                << delimiter << result.statistics.max_length;
+            if (evaluator_)
+            {
+                for (double value : util::Evaluator::GetMetricValues(result.metrics))
+                {
+                    out << delimiter << value;
+                }
+            }
+            out << delimiter << result.error << "\n";
+        }
+    }
+
+    void ParameterSweep::RunTracker(const TrackerParameters& parameters,
+                                    core::DetectionSequence& sequence,
+                                    std::vector<core::TrackletPtr>& tracks,
+                                    const std::string& graph_dump_path)
+    {
+        if (parameters.algorithm == "n-stage")
+        {
+            // The object model is chosen once, the costs are compared statically
+            if (parameters.input_format == "2D")
+            {
+                RunNStage<core::ObjectModel2D>(parameters, sequence, tracks, graph_dump_path);
+            }
+            else if (parameters.input_format == "Box")
+            {
+                RunNStage<core::ObjectModelBox>(parameters, sequence, tracks, graph_dump_path);
+            }
+            else if (parameters.input_format == "Angular")
+            {
+                RunNStage<core::ObjectModelAngular>(parameters, sequence, tracks,
+                                                    graph_dump_path);
+            }
+            else
+            {
+                throw "Unknown input format: " + parameters.input_format;
+            }
+        }
+        else if (parameters.algorithm == "berclaz")
+        {
+            Berclaz berclaz(parameters.h_res, parameters.v_res, parameters.vicinity_size);
+            berclaz.SetGraphDumpPath(graph_dump_path);
+            berclaz.Run(sequence, parameters.batch_size, parameters.max_track_count, tracks);
+        }
+        else
+        {
+            throw "Unknown algorithm: " + parameters.algorithm;
+        }
+
+        util::ScopedTimer timer("interpolate");
+        for (auto track : tracks)
+        {
+            track->InterpolateMissingFrames();
+        }
+    }
+
+    void ParameterSweep::WriteTracks(std::vector<core::TrackletPtr>& tracks,
+                                     const std::string& output_path,
+                                     const std::string& output_format, char delimiter)
+    {
+        mkdir(output_path.c_str(), 0755);
+        if (output_format == "long")
+        {
+            util::FileIO::WriteTracksLong(tracks, output_path + "/tracks.csv", delimiter);
+        }
+        else if (output_format == "binary")
+        {
+            util::FileIO::WriteTracksBinary(tracks, output_path + "/tracks.gbt");
+        }
+        else
+        {
+            util::FileIO::WriteTracks(tracks, output_path + "/tracks.csv", delimiter);
+        }
+    }
+
+    TrackStatistics ParameterSweep::GetStatistics(std::vector<core::TrackletPtr>& tracks)
+    {
+        TrackStatistics statistics = { tracks.size(), 0, 0.0, 0, 0 };
+        if (tracks.empty())
+        {
+            return statistics;
+        }
+
+        statistics.min_length = std::numeric_limits<size_t>::max();
+        for (auto track : tracks)
+        {
+            size_t length = track->GetLastFrameIndex() - track->GetFirstFrameIndex() + 1;
+            statistics.object_count += track->GetPathObjectCount();
+            statistics.mean_length += length;
+            statistics.min_length = std::min(statistics.min_length, length);
+            statistics.max_length = std::max(statistics.max_length, length);
+        }
+        statistics.mean_length /= tracks.size();
+
+        return statistics;
+    }
+}
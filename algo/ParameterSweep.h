@@ -0,0 +1,221 @@
+#ifndef GBMOT_PARAMETERSWEEP_H
+#define GBMOT_PARAMETERSWEEP_H
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../core/DetectionSequence.h"
+#include "../core/Tracklet.h"
+#include "../util/Evaluator.h"
+
+namespace algo
+{
+    /**
+     * The parameters of a single tracking run.
+     * The names of the parameters are the names of the command line options.
+     */
+    struct TrackerParameters
+    {
+        /**
+         * The algorithm to run, n-stage or berclaz
+         */
+        std::string algorithm;
+
+        /**
+         * The type of the detected objects: 2D, Box or Angular, selects the
+         * object model the algorithm is instantiated for
+         */
+        std::string input_format;
+
+        /**
+         * (n stage) Comma separated values for every stage
+         */
+        std::string max_frame_skip;
+        std::string penalty_value;
+        std::string max_tracklet_count;
+
+        /**
+         * The weights used when parsing the sequence
+         */
+        double temporal_weight;
+        double spatial_weight;
+        double angular_weight;
+
+        /**
+         * (berclaz)
+         */
+        int h_res;
+        int v_res;
+        int vicinity_size;
+        size_t batch_size;
+        size_t max_track_count;
+
+        /**
+         * Sets the parameter with the given command line option name.
+         *
+         * @param name The option name, e.g. penalty-value
+         * @param value The value as written on the command line
+         */
+        void Set(const std::string& name, const std::string& value);
+
+        /**
+         * Gets the parameter with the given command line option name.
+         *
+         * @param name The option name, e.g. penalty-value
+         * @return The value as written on the command line
+         */
+        std::string Get(const std::string& name) const;
+    };
+
+    /**
+     * Function loading the sequence for the given parameters.
+     * Called concurrently, every call needs to create new objects because the
+     * algorithms may modify them.
+     */
+    typedef std::function<void(const TrackerParameters&, core::DetectionSequence&)>
+            SequenceFunction;
+
+    /**
+     * Statistics of the tracks found by a single configuration.
+     */
+    struct TrackStatistics
+    {
+        size_t track_count;
+        size_t object_count;
+        double mean_length;
+        size_t min_length;
+        size_t max_length;
+    };
+
+    /**
+     * Runs a tracking algorithm for every configuration of a parameter grid.
+     * The grid is the cartesian product of the values of every parameter,
+     * parameters not in the grid keep their base value. The configurations
+     * are run in parallel, each on its own copy of the sequence, and their
+     * tracks are written into numbered sub folders of the output folder
+     * together with one summary table.
+     */
+    class ParameterSweep
+    {
+    private:
+        /**
+         * The values of the parameters not in the grid
+         */
+        TrackerParameters base_;
+
+        /**
+         * The swept parameters with their values
+         */
+        std::vector<std::pair<std::string, std::vector<std::string>>> grid_;
+
+        /**
+         * The evaluator for the tracks of every configuration, may be null
+         */
+        util::EvaluatorPtr evaluator_;
+
+        /**
+         * Creates the parameters of the configuration with the given index.
+         *
+         * @param index The index in [0, GetConfigurationCount())
+         * @return The parameters of the configuration
+         */
+        TrackerParameters CreateConfiguration(size_t index) const;
+    public:
+        /**
+         * Creates a new sweep with an empty grid.
+         *
+         * @param base The values of the parameters not in the grid
+         */
+        ParameterSweep(const TrackerParameters& base);
+
+        /**
+         * Reads the parameter grid from the given file.
+         * Every line contains a parameter name followed by its values, all
+         * separated by the delimiter, e.g. penalty-value;50,50;100,100.
+         * Empty lines and lines starting with # are ignored.
+         *
+         * @param file_name The name of the grid file
+         * @param delimiter The delimiter between the name and the values
+         */
+        void ReadGrid(const std::string& file_name, char delimiter);
+
+        /**
+         * Adds a parameter to the grid.
+         *
+         * @param name The command line option name of the parameter
+         * @param values The values to run
+         */
+        void AddParameter(const std::string& name, const std::vector<std::string>& values);
+
+        /**
+         * Sets the evaluator to compare the tracks of every configuration
+         * with the ground truth, the metrics are added to the summary table.
+         * The evaluator is used by all configurations concurrently.
+         *
+         * @param evaluator The evaluator, null to not evaluate
+         */
+        void SetEvaluator(util::EvaluatorPtr evaluator);
+
+        /**
+         * Gets the number of configurations in the grid.
+         *
+         * @return The product of the value counts of all parameters
+         */
+        size_t GetConfigurationCount() const;
+
+        /**
+         * Runs every configuration and writes the results.
+         * The tracks of configuration i are written into <output_path>/<i>,
+         * the summary table into <output_path>/sweep.csv.
+         *
+         * @param load The function loading the sequence of a configuration
+         * @param output_path The folder to write into
+         * @param output_format The format of the track files: wide, long or binary
+         * @param delimiter The delimiter of the track files and the summary
+         * @param thread_count The number of configurations run in parallel,
+         *                     zero uses all available hardware threads
+         */
+        void Run(const SequenceFunction& load, const std::string& output_path,
+                 const std::string& output_format, char delimiter, size_t thread_count);
+
+        /**
+         * Runs the algorithm of the given parameters on the given sequence
+         * and interpolates the found tracks.
+         *
+         * @param parameters The parameters
+         * @param sequence The sequence to track
+         * @param tracks The vector to store the found tracks in
+         * @param graph_dump_path The folder to write the created graphs into,
+         *                        empty to not write the graphs
+         */
+        static void RunTracker(const TrackerParameters& parameters,
+                               core::DetectionSequence& sequence,
+                               std::vector<core::TrackletPtr>& tracks,
+                               const std::string& graph_dump_path = "");
+
+        /**
+         * Writes the given tracks into the given folder, the folder is
+         * created if it does not exist.
+         *
+         * @param tracks The tracks to write
+         * @param output_path The folder to write tracks.csv or tracks.gbt into
+         * @param output_format The format of the track file: wide, long or binary
+         * @param delimiter The delimiter of the track file
+         */
+        static void WriteTracks(std::vector<core::TrackletPtr>& tracks,
+                                const std::string& output_path,
+                                const std::string& output_format, char delimiter);
+
+        /**
+         * Calculates the statistics of the given tracks.
+         *
+         * @param tracks The tracks
+         * @return The statistics
+         */
+        static TrackStatistics GetStatistics(std::vector<core::TrackletPtr>& tracks);
+    };
+}
+
+
+#endif //GBMOT_PARAMETERSWEEP_H
@@ -0,0 +1,59 @@
+#include "SolverMetrics.h"
+#include "../util/Profiler.h"
+#include <algorithm>
+
+namespace algo
+{
+    SolverMetrics::SolverMetrics()
+    {
+        Clear();
+    }
+
+    void SolverMetrics::Clear()
+    {
+        searches = 0;
+        edge_relaxations = 0;
+        heap_pushes = 0;
+        heap_pops = 0;
+        vertices_settled = 0;
+        bellman_ford_passes = 0;
+        graph_vertex_count = 0;
+        graph_edge_count = 0;
+        transformed_vertex_count = 0;
+        transformed_edge_count = 0;
+        path_count = 0;
+    }
+
+    void SolverMetrics::Add(const SolverMetrics& other)
+    {
+        searches += other.searches;
+        edge_relaxations += other.edge_relaxations;
+        heap_pushes += other.heap_pushes;
+        heap_pops += other.heap_pops;
+        vertices_settled += other.vertices_settled;
+        bellman_ford_passes += other.bellman_ford_passes;
+        graph_vertex_count = std::max(graph_vertex_count, other.graph_vertex_count);
+        graph_edge_count = std::max(graph_edge_count, other.graph_edge_count);
+        transformed_vertex_count = std::max(transformed_vertex_count,
+                                            other.transformed_vertex_count);
+        transformed_edge_count = std::max(transformed_edge_count, other.transformed_edge_count);
+        path_count += other.path_count;
+    }
+
+    void SolverMetrics::Record() const
+    {
+        if (!util::Profiler::IsEnabled()) return;
+
+        util::Profiler::RecordCounter("searches", searches);
+        util::Profiler::RecordCounter("edge_relaxations", edge_relaxations);
+        util::Profiler::RecordCounter("heap_pushes", heap_pushes);
+        util::Profiler::RecordCounter("heap_pops", heap_pops);
+        util::Profiler::RecordCounter("vertices_settled", vertices_settled);
+        util::Profiler::RecordCounter("bellman_ford_passes", bellman_ford_passes);
+        util::Profiler::RecordCounter("graph_vertex_count", graph_vertex_count);
+        util::Profiler::RecordCounter("graph_edge_count", graph_edge_count);
+        util::Profiler::RecordCounter("transformed_vertex_count", transformed_vertex_count);
+        util::Profiler::RecordCounter("transformed_edge_count", transformed_edge_count);
+        util::Profiler::RecordCounter("path_count", path_count);
+    }
+}
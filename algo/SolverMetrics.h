@@ -0,0 +1,169 @@
+#ifndef GBMOT_SOLVERMETRICS_H
+#define GBMOT_SOLVERMETRICS_H
+
+#include <cstddef>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/graph/bellman_ford_shortest_paths.hpp>
+
+namespace algo
+{
+    /**
+     * Counts the work done by a shortest path solver.
+     */
+    struct SolverMetrics
+    {
+        /**
+         * The number of single-source shortest path searches
+         */
+        size_t searches;
+
+        /**
+         * The number of edges that lowered the distance of their target
+         */
+        size_t edge_relaxations;
+
+        /**
+         * The number of vertices pushed into the priority queue (dijkstra)
+         */
+        size_t heap_pushes;
+
+        /**
+         * The number of vertices popped from the priority queue (dijkstra)
+         */
+        size_t heap_pops;
+
+        /**
+         * The number of vertices with a final distance (dijkstra)
+         */
+        size_t vertices_settled;
+
+        /**
+         * The number of passes over all edges (bellman ford)
+         */
+        size_t bellman_ford_passes;
+
+        /**
+         * The vertex count of the input graph
+         */
+        size_t graph_vertex_count;
+
+        /**
+         * The edge count of the input graph
+         */
+        size_t graph_edge_count;
+
+        /**
+         * The vertex count of the largest transformed graph
+         */
+        size_t transformed_vertex_count;
+
+        /**
+         * The edge count of the largest transformed graph
+         */
+        size_t transformed_edge_count;
+
+        /**
+         * The number of paths found
+         */
+        size_t path_count;
+
+        /**
+         * Creates metrics with all counters set to zero.
+         */
+        SolverMetrics();
+
+        /**
+         * Resets all counters to zero.
+         */
+        void Clear();
+
+        /**
+         * Adds the counters of the given metrics, the graph sizes are the
+         * maximum of both.
+         * @param other The metrics to add
+         */
+        void Add(const SolverMetrics& other);
+
+        /**
+         * Records all counters in the profiler, relative to the current scope.
+         */
+        void Record() const;
+    };
+
+    /**
+     * Dijkstra visitor counting the queue operations and relaxations.
+     */
+    class DijkstraMetricsVisitor : public boost::default_dijkstra_visitor
+    {
+    private:
+        SolverMetrics* metrics_;
+    public:
+        DijkstraMetricsVisitor(SolverMetrics& metrics) : metrics_(&metrics) { }
+
+        template<typename V, typename G>
+        void discover_vertex(V, const G&)
+        {
+            ++metrics_->heap_pushes;
+        }
+
+        template<typename V, typename G>
+        void examine_vertex(V, const G&)
+        {
+            ++metrics_->heap_pops;
+        }
+
+        template<typename V, typename G>
+        void finish_vertex(V, const G&)
+        {
+            ++metrics_->vertices_settled;
+        }
+
+        template<typename E, typename G>
+        void edge_relaxed(E, const G&)
+        {
+            ++metrics_->edge_relaxations;
+        }
+    };
+
+    /**
+     * Bellman ford visitor counting the passes and relaxations.
+     * Bellman ford examines every edge once per pass, a pass starts whenever
+     * all edges of the previous pass have been examined. The final check for
+     * negative cycles does not examine edges and is not counted.
+     */
+    class BellmanFordMetricsVisitor : public boost::default_bellman_visitor
+    {
+    private:
+        SolverMetrics* metrics_;
+        size_t* pass_edges_left_;
+    public:
+        /**
+         * @param metrics The metrics to count in
+         * @param pass_edges_left The edges left to examine in the current
+         *                        pass, zero before the first pass, shared by
+         *                        all copies of the visitor
+         */
+        BellmanFordMetricsVisitor(SolverMetrics& metrics, size_t& pass_edges_left)
+                : metrics_(&metrics), pass_edges_left_(&pass_edges_left) { }
+
+        template<typename E, typename G>
+        void examine_edge(E, const G& g)
+        {
+            if (*pass_edges_left_ == 0)
+            {
+                ++metrics_->bellman_ford_passes;
+                *pass_edges_left_ = num_edges(g);
+            }
+            --(*pass_edges_left_);
+        }
+
+        template<typename E, typename G>
+        void edge_relaxed(E, const G&)
+        {
+            ++metrics_->edge_relaxations;
+        }
+    };
+}
+
+
+#endif //GBMOT_SOLVERMETRICS_H
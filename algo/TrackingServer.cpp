@@ -0,0 +1,360 @@
+#include "TrackingServer.h"
+#include "../core/FrameIndex.h"
+#include "../util/FileIO.h"
+#include "../util/Logger.h"
+#include "../util/Parser.h"
+#include "../util/ThreadPool.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace algo
+{
+    namespace
+    {
+        /**
+         * The maximum size of a response read by a client
+         */
+        const size_t MAX_RESPONSE_SIZE = 1024 * 1024 * 1024;
+
+        /**
+         * The number of connections the kernel queues until they are accepted
+         */
+        const int LISTEN_BACKLOG = 64;
+
+        /**
+         * The seconds to wait for the next part of a request
+         */
+        const long RECEIVE_TIMEOUT = 60;
+
+        sockaddr_un CreateAddress(const std::string& socket_path)
+        {
+            sockaddr_un address;
+            std::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (socket_path.size() >= sizeof(address.sun_path))
+            {
+                throw "Socket path too long: " + socket_path;
+            }
+            std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+            return address;
+        }
+
+        void SendAll(int socket, const std::string& data)
+        {
+            size_t sent = 0;
+            while (sent < data.size())
+            {
+                ssize_t count = send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if (count < 0)
+                {
+                    if (errno == EINTR) continue;
+                    throw "Failed to send: " + std::string(std::strerror(errno));
+                }
+                sent += (size_t) count;
+            }
+        }
+
+        void ReceiveAll(int socket, std::string& data, size_t max_size)
+        {
+            char chunk[64 * 1024];
+            while (true)
+            {
+                ssize_t count = recv(socket, chunk, sizeof(chunk), 0);
+                if (count < 0)
+                {
+                    if (errno == EINTR) continue;
+                    throw "Failed to receive: " + std::string(std::strerror(errno));
+                }
+                if (count == 0) break;
+
+                data.append(chunk, (size_t) count);
+                if (data.size() > max_size)
+                {
+                    throw "Message too large: more than " + std::to_string(max_size) + " bytes";
+                }
+            }
+        }
+    }
+
+    TrackingServer::TrackingServer(const std::string& socket_path, const BatchSequence& base,
+                                   char delimiter, size_t thread_count,
+                                   size_t max_request_size)
+            : socket_path_(socket_path),
+              base_(base),
+              delimiter_(delimiter),
+              thread_count_(thread_count),
+              max_request_size_(max_request_size),
+              connection_count_(0),
+              listen_socket_(-1),
+              stop_(false)
+    {
+    }
+
+    void TrackingServer::Run()
+    {
+        sockaddr_un address = CreateAddress(socket_path_);
+
+        // Remove the socket file of a previous server
+        struct stat info;
+        if (stat(socket_path_.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+        {
+            unlink(socket_path_.c_str());
+        }
+
+        int listen_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_socket < 0)
+        {
+            throw "Unable to create socket: " + std::string(std::strerror(errno));
+        }
+        if (bind(listen_socket, (sockaddr*) &address, sizeof(address)) != 0 ||
+            listen(listen_socket, LISTEN_BACKLOG) != 0)
+        {
+            std::string error = std::strerror(errno);
+            close(listen_socket);
+            throw "Unable to listen on " + socket_path_ + ": " + error;
+        }
+        listen_socket_ = listen_socket;
+
+        GBMOT_LOG_INFO("Listening on " + socket_path_);
+
+        {
+            util::ThreadPool pool(thread_count_);
+            size_t max_connections = 2 * pool.GetThreadCount();
+            while (!stop_)
+            {
+                // Further connections wait in the listen backlog until a
+                // handled connection is closed
+                {
+                    std::unique_lock<std::mutex> lock(connection_mutex_);
+                    connection_closed_.wait_for(lock, std::chrono::milliseconds(100), [&]()
+                    {
+                        return connection_count_ < max_connections;
+                    });
+                    if (connection_count_ >= max_connections) continue;
+                }
+
+                int connection = accept(listen_socket, nullptr, nullptr);
+                if (connection < 0)
+                {
+                    if (stop_) break;
+                    if (errno != EINTR)
+                    {
+                        util::Logger::LogError("Failed to accept a connection: " +
+                                               std::string(std::strerror(errno)));
+                    }
+                    continue;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(connection_mutex_);
+                    ++connection_count_;
+                }
+                pool.Submit([this, connection]()
+                            {
+                                HandleConnection(connection);
+
+                                std::lock_guard<std::mutex> lock(connection_mutex_);
+                                --connection_count_;
+                                connection_closed_.notify_one();
+                            });
+            }
+            pool.Wait();
+        }
+
+        listen_socket_ = -1;
+        close(listen_socket);
+        unlink(socket_path_.c_str());
+
+        GBMOT_LOG_INFO("Stopped listening on " + socket_path_);
+    }
+
+    void TrackingServer::Stop()
+    {
+        stop_ = true;
+
+        // Wakes up the blocking accept
+        int listen_socket = listen_socket_;
+        if (listen_socket >= 0)
+        {
+            shutdown(listen_socket, SHUT_RDWR);
+        }
+    }
+
+    void TrackingServer::HandleConnection(int connection) const
+    {
+        std::string error;
+        // Every thread keeps its buffers, thus their memory is reused
+        thread_local std::string request;
+        thread_local std::string response;
+        request.clear();
+        response.clear();
+
+        try
+        {
+            timeval timeout;
+            timeout.tv_sec = RECEIVE_TIMEOUT;
+            timeout.tv_usec = 0;
+            setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            ReceiveAll(connection, request, max_request_size_);
+            HandleRequest(request, response);
+            SendAll(connection, response);
+        }
+        catch (std::string& e)
+        {
+            error = e;
+        }
+        catch (std::exception& e)
+        {
+            error = e.what();
+        }
+        catch (...)
+        {
+            error = "Unknown error";
+        }
+
+        // A failed connection must not stop the server
+        if (!error.empty())
+        {
+            // Release the memory of a failed large request
+            std::string().swap(request);
+            std::string().swap(response);
+
+            util::Logger::LogError(error);
+            try
+            {
+                SendAll(connection, "ERROR " + error + "\n");
+            }
+            catch (...)
+            {
+                // The client is gone
+            }
+        }
+
+        close(connection);
+    }
+
+    void TrackingServer::HandleRequest(const std::string& request, std::string& response) const
+    {
+        response.clear();
+        try
+        {
+            // The settings end with an empty line
+            BatchSequence settings = base_;
+            size_t position = 0;
+            while (true)
+            {
+                size_t line_end = request.find('\n', position);
+                if (line_end == std::string::npos)
+                {
+                    throw "Missing empty line after the parameters of a request with " +
+                          std::to_string(request.size()) + " bytes";
+                }
+
+                std::string line = request.substr(position, line_end - position);
+                position = line_end + 1;
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line.pop_back();
+                }
+                if (line.empty()) break;
+
+                size_t equals = line.find('=');
+                if (equals == std::string::npos)
+                {
+                    throw "Invalid parameter line: " + line;
+                }
+                settings.Set(line.substr(0, equals), line.substr(equals + 1));
+            }
+
+            util::ValueTable values;
+            util::FileIO::ParseCSV(values, settings.input_header, request.data() + position,
+                                   request.data() + request.size(), delimiter_);
+
+            core::DetectionSequence sequence;
+            const TrackerParameters& params = settings.parameters;
+            util::Parser::ParseObjectData(values, sequence, params.input_format,
+                                          settings.image_width, settings.image_height,
+                                          params.temporal_weight, params.spatial_weight,
+                                          params.angular_weight);
+
+            std::vector<core::TrackletPtr> tracks;
+            ParameterSweep::RunTracker(params, sequence, tracks);
+
+            response = "OK " + std::to_string(tracks.size()) + "\n";
+            core::FrameIndex index(tracks);
+            for (size_t frame = index.GetFirstFrameIndex(); frame < index.GetEndFrameIndex();
+                 ++frame)
+            {
+                for (auto& entry : index.GetFrame(frame))
+                {
+                    util::FileIO::AppendTrackObject(response, frame, entry.track, entry.object,
+                                                    delimiter_);
+                }
+            }
+        }
+        catch (std::string& e)
+        {
+            response = "ERROR " + e + "\n";
+        }
+        catch (std::exception& e)
+        {
+            response = "ERROR " + std::string(e.what()) + "\n";
+        }
+    }
+
+    std::string TrackingServer::CreateRequest(
+            const std::vector<std::pair<std::string, std::string>>& parameters,
+            const std::string& detections)
+    {
+        std::string request;
+        for (auto& parameter : parameters)
+        {
+            request += parameter.first + "=" + parameter.second + "\n";
+        }
+        request += "\n";
+        request += detections;
+        return request;
+    }
+
+    void TrackingServer::SendRequest(const std::string& socket_path, const std::string& request,
+                                     std::string& response)
+    {
+        sockaddr_un address = CreateAddress(socket_path);
+
+        int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connection < 0)
+        {
+            throw "Unable to create socket: " + std::string(std::strerror(errno));
+        }
+        if (connect(connection, (sockaddr*) &address, sizeof(address)) != 0)
+        {
+            std::string error = std::strerror(errno);
+            close(connection);
+            throw "Unable to connect to " + socket_path + ": " + error;
+        }
+
+        try
+        {
+            // Shutting down the sending side marks the end of the request
+            SendAll(connection, request);
+            shutdown(connection, SHUT_WR);
+
+            response.clear();
+            ReceiveAll(connection, response, MAX_RESPONSE_SIZE);
+        }
+        catch (std::string& e)
+        {
+            close(connection);
+            throw;
+        }
+
+        close(connection);
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef GBMOT_TRACKINGSERVER_H
+#define GBMOT_TRACKINGSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BatchRunner.h"
+
+namespace algo
+{
+    /**
+     * A long running process tracking the detections sent over a Unix
+     * domain socket. Every connection carries one request and its response:
+     *
+     * The request starts with one option=value line per setting, using the
+     * command line option names, followed by an empty line and the detections
+     * as CSV text. The client shuts down its sending side after the request.
+     *
+     * The response is a status line, either "OK <track count>" followed by
+     * the tracks in the long track format (frame, id, x, y, width, height,
+     * score), or "ERROR <message>". The server closes the connection after
+     * the response.
+     *
+     * The requests are handled on a fixed pool of threads, the threads keep
+     * their buffers and allocator state between requests. At most twice as
+     * many connections as threads are accepted at once, further connections
+     * wait in the listen backlog.
+     */
+    class TrackingServer
+    {
+    private:
+        /**
+         * The path of the socket file
+         */
+        std::string socket_path_;
+
+        /**
+         * The settings of requests without their own value
+         */
+        BatchSequence base_;
+
+        /**
+         * The delimiter of the detections and the tracks
+         */
+        char delimiter_;
+
+        /**
+         * The number of threads handling requests
+         */
+        size_t thread_count_;
+
+        /**
+         * The maximum size of a request in bytes, larger requests are rejected
+         */
+        size_t max_request_size_;
+
+        /**
+         * The number of accepted connections not closed yet
+         */
+        size_t connection_count_;
+        std::mutex connection_mutex_;
+        std::condition_variable connection_closed_;
+
+        /**
+         * The listening socket, -1 if not listening
+         */
+        std::atomic<int> listen_socket_;
+
+        /**
+         * True, if no more connections should be accepted
+         */
+        std::atomic<bool> stop_;
+
+        /**
+         * Reads the request of the given connection, handles it and sends
+         * the response. The connection is closed afterwards.
+         *
+         * @param connection The socket of the connection
+         */
+        void HandleConnection(int connection) const;
+    public:
+        /**
+         * Creates a new server, the socket is created by Run.
+         *
+         * @param socket_path The path of the socket file
+         * @param base The settings of requests without their own value
+         * @param delimiter The delimiter of the detections and the tracks
+         * @param thread_count The number of threads handling requests, zero
+         *                     uses all available hardware threads
+         * @param max_request_size The maximum size of a request in bytes,
+         *                         larger requests are rejected
+         */
+        TrackingServer(const std::string& socket_path, const BatchSequence& base,
+                       char delimiter, size_t thread_count, size_t max_request_size);
+
+        /**
+         * Accepts connections until Stop is called. Running requests are
+         * finished and the socket file is removed before returning.
+         */
+        void Run();
+
+        /**
+         * Stops accepting connections.
+         * Only sets a flag and shuts down the socket, thus it can be called
+         * from a signal handler.
+         */
+        void Stop();
+
+        /**
+         * Handles a single request.
+         *
+         * @param request The request text
+         * @param response The string to store the response text in
+         */
+        void HandleRequest(const std::string& request, std::string& response) const;
+
+        /**
+         * Creates the text of a request.
+         *
+         * @param parameters The option names and values of the request
+         * @param detections The detections as CSV text
+         * @return The request text
+         */
+        static std::string CreateRequest(
+                const std::vector<std::pair<std::string, std::string>>& parameters,
+                const std::string& detections);
+
+        /**
+         * Sends a request to the server listening on the given socket and
+         * waits for the response.
+         *
+         * @param socket_path The path of the socket file
+         * @param request The request text
+         * @param response The string to store the response text in
+         */
+        static void SendRequest(const std::string& socket_path, const std::string& request,
+                                std::string& response);
+    };
+}
+
+
+#endif //GBMOT_TRACKINGSERVER_H
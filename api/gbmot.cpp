@@ -0,0 +1,349 @@
+#include "gbmot.h"
+#include "../algo/OnlineTracker.h"
+#include "../algo/ParameterSweep.h"
+#include "../core/FrameIndex.h"
+#include "../core/ObjectDataBox.h"
+#include "../util/DetectionArrays.h"
+#include "../util/Logger.h"
+#include "../util/Parser.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+struct gbmot_tracker
+{
+    algo::TrackerParameters parameters;
+    double image_width;
+    double image_height;
+    size_t latency;
+    double score_min;
+    double score_max;
+
+    /**
+     * The tracker of the current stream, null if no frame was pushed
+     */
+    std::unique_ptr<algo::OnlineTracker> online;
+
+    /**
+     * The track objects of the last call and the number already copied,
+     * the memory is reused by the next call
+     */
+    std::vector<gbmot_track_object> pending;
+    size_t read_count;
+
+    std::string error;
+};
+
+namespace
+{
+    util::DetectionArrays CreateArrays(const gbmot_detections* detections)
+    {
+        // No detections in any frame
+        if (detections == nullptr)
+        {
+            return util::DetectionArrays(0);
+        }
+
+        util::DetectionArrays arrays(detections->count);
+        arrays.SetColumn(util::Parser::KEY_FRAME, detections->frame, detections->frame_stride);
+        arrays.SetColumn(util::Parser::KEY_X, detections->x, detections->x_stride);
+        arrays.SetColumn(util::Parser::KEY_Y, detections->y, detections->y_stride);
+        arrays.SetColumn(util::Parser::KEY_WIDTH, detections->width, detections->width_stride);
+        arrays.SetColumn(util::Parser::KEY_HEIGHT, detections->height, detections->height_stride);
+        arrays.SetColumn(util::Parser::KEY_ANGLE, detections->angle, detections->angle_stride);
+        arrays.SetColumn(util::Parser::KEY_SCORE, detections->score, detections->score_stride);
+        return arrays;
+    }
+
+    gbmot_track_object CreateTrackObject(size_t frame, size_t id, const core::ObjectDataPtr& obj)
+    {
+        core::ObjectData2DPtr obj_2d = std::static_pointer_cast<core::ObjectData2D>(obj);
+        core::ObjectDataBoxPtr obj_box = std::dynamic_pointer_cast<core::ObjectDataBox>(obj);
+
+        gbmot_track_object object;
+        object.frame = frame;
+        object.track_id = id;
+        object.x = obj_2d->GetPosition().x;
+        object.y = obj_2d->GetPosition().y;
+        object.width = obj_box ? obj_box->GetSize().x : 0.0;
+        object.height = obj_box ? obj_box->GetSize().y : 0.0;
+        object.score = obj->GetDetectionScore();
+        return object;
+    }
+
+    int CopyObjects(gbmot_tracker* tracker, gbmot_track_object* objects, size_t capacity,
+                    size_t* count)
+    {
+        size_t copy_count = std::min(capacity, tracker->pending.size() - tracker->read_count);
+        if (objects != nullptr && copy_count > 0)
+        {
+            std::memcpy(objects, tracker->pending.data() + tracker->read_count,
+                        copy_count * sizeof(gbmot_track_object));
+        }
+        else
+        {
+            copy_count = 0;
+        }
+        tracker->read_count += copy_count;
+
+        if (count != nullptr)
+        {
+            *count = copy_count;
+        }
+
+        return tracker->read_count < tracker->pending.size() ? GBMOT_BUFFER_TOO_SMALL : GBMOT_OK;
+    }
+
+    /**
+     * Runs the given function, stores the message of a thrown error in the
+     * tracker and copies the track objects into the buffer.
+     */
+    template<typename Function>
+    int Call(gbmot_tracker* tracker, gbmot_track_object* objects, size_t capacity,
+             size_t* count, Function function)
+    {
+        if (count != nullptr)
+        {
+            *count = 0;
+        }
+        if (tracker == nullptr)
+        {
+            return GBMOT_ERROR;
+        }
+
+        tracker->error.clear();
+        tracker->pending.clear();
+        tracker->read_count = 0;
+        try
+        {
+            function();
+        }
+        catch (std::string& e)
+        {
+            tracker->error = e;
+        }
+        catch (std::exception& e)
+        {
+            tracker->error = e.what();
+        }
+        catch (...)
+        {
+            // No exception may leave the C interface
+            tracker->error = "Unknown error";
+        }
+
+        if (!tracker->error.empty())
+        {
+            tracker->pending.clear();
+            return GBMOT_ERROR;
+        }
+
+        return CopyObjects(tracker, objects, capacity, count);
+    }
+}
+
+void gbmot_config_init(gbmot_config* config)
+{
+    if (config == nullptr) return;
+
+    config->algorithm = "n-stage";
+    config->input_format = "2D";
+    config->image_width = 1.0;
+    config->image_height = 1.0;
+    config->temporal_weight = 1.0;
+    config->spatial_weight = 1.0;
+    config->angular_weight = 1.0;
+    config->max_frame_skip = "1,1";
+    config->penalty_value = "0,0";
+    config->max_tracklet_count = "-1,1";
+    config->horizontal_resolution = 10;
+    config->vertical_resolution = 10;
+    config->vicinity_size = 1;
+    config->batch_size = 100;
+    config->max_track_count = 1;
+    config->latency = 10;
+    config->score_min = 0.0;
+    config->score_max = 1.0;
+}
+
+gbmot_tracker* gbmot_create(const gbmot_config* config)
+{
+    if (config == nullptr || config->algorithm == nullptr || config->input_format == nullptr)
+    {
+        util::Logger::LogError("No algorithm or input format");
+        return nullptr;
+    }
+
+    std::string algorithm = config->algorithm;
+    std::string input_format = config->input_format;
+    if (algorithm != "n-stage" && algorithm != "berclaz")
+    {
+        util::Logger::LogError("Unknown algorithm: " + algorithm);
+        return nullptr;
+    }
+    if (input_format != "2D" && input_format != "Box" && input_format != "Angular")
+    {
+        util::Logger::LogError("Unknown input format: " + input_format);
+        return nullptr;
+    }
+
+    std::unique_ptr<gbmot_tracker> tracker(new gbmot_tracker());
+    algo::TrackerParameters& params = tracker->parameters;
+    params.algorithm = algorithm;
+    params.input_format = input_format;
+    params.max_frame_skip = config->max_frame_skip != nullptr ? config->max_frame_skip : "";
+    params.penalty_value = config->penalty_value != nullptr ? config->penalty_value : "";
+    params.max_tracklet_count =
+            config->max_tracklet_count != nullptr ? config->max_tracklet_count : "";
+    params.temporal_weight = config->temporal_weight;
+    params.spatial_weight = config->spatial_weight;
+    params.angular_weight = config->angular_weight;
+    params.h_res = config->horizontal_resolution;
+    params.v_res = config->vertical_resolution;
+    params.vicinity_size = config->vicinity_size;
+    params.batch_size = config->batch_size;
+    params.max_track_count = config->max_track_count;
+
+    tracker->image_width = config->image_width;
+    tracker->image_height = config->image_height;
+    tracker->latency = config->latency;
+    tracker->score_min = config->score_min;
+    tracker->score_max = config->score_max;
+    tracker->read_count = 0;
+
+    return tracker.release();
+}
+
+void gbmot_destroy(gbmot_tracker* tracker)
+{
+    delete tracker;
+}
+
+int gbmot_track(gbmot_tracker* tracker, const gbmot_detections* detections,
+                gbmot_track_object* objects, size_t capacity, size_t* count)
+{
+    return Call(tracker, objects, capacity, count, [&]()
+    {
+        const algo::TrackerParameters& params = tracker->parameters;
+        core::DetectionSequence sequence;
+        util::Parser::ParseObjectData(CreateArrays(detections), sequence, params.input_format,
+                                      tracker->image_width, tracker->image_height,
+                                      params.temporal_weight, params.spatial_weight,
+                                      params.angular_weight);
+
+        std::vector<core::TrackletPtr> tracks;
+        algo::ParameterSweep::RunTracker(params, sequence, tracks);
+
+        core::FrameIndex index(tracks);
+        for (size_t frame = index.GetFirstFrameIndex(); frame < index.GetEndFrameIndex();
+             ++frame)
+        {
+            for (auto& entry : index.GetFrame(frame))
+            {
+                tracker->pending.push_back(CreateTrackObject(frame, entry.track, entry.object));
+            }
+        }
+    });
+}
+
+int gbmot_push(gbmot_tracker* tracker, const gbmot_detections* detections, size_t frame_count,
+               gbmot_track_object* objects, size_t capacity, size_t* count)
+{
+    return Call(tracker, objects, capacity, count, [&]()
+    {
+        const algo::TrackerParameters& params = tracker->parameters;
+        if (!tracker->online)
+        {
+            tracker->online.reset(new algo::OnlineTracker(
+                    [params](core::DetectionSequence& window,
+                             std::vector<core::TrackletPtr>& tracks)
+                    {
+                        algo::ParameterSweep::RunTracker(params, window, tracks);
+                    }, tracker->latency));
+        }
+
+        // Finalized frames can not change anymore
+        util::DetectionArrays arrays = CreateArrays(detections);
+        size_t first_frame = tracker->online->GetNextFrameIndex();
+        size_t end_frame = first_frame + frame_count;
+        util::StridedColumn frames = arrays.GetColumn(util::Parser::KEY_FRAME);
+        for (size_t i = 0; i < arrays.GetRowCount(); ++i)
+        {
+            size_t frame = (size_t) std::fabs(frames[i]);
+            if (frame < first_frame || frame >= end_frame)
+            {
+                throw "Detection in frame " + std::to_string(frame) +
+                      " outside of the pushed frames " + std::to_string(first_frame) +
+                      " to " + std::to_string(end_frame - 1);
+            }
+        }
+
+        std::vector<algo::TrackAssignment> assignments;
+        tracker->online->AddFrames([&](core::DetectionSequence& window)
+                                   {
+                                       util::Parser::ParseObjectData(
+                                               arrays, window, params.input_format,
+                                               tracker->image_width, tracker->image_height,
+                                               params.temporal_weight, params.spatial_weight,
+                                               params.angular_weight,
+                                               tracker->score_min, tracker->score_max);
+                                       window.ExtendFrameCount(end_frame);
+                                   }, assignments);
+
+        for (auto& assignment : assignments)
+        {
+            tracker->pending.push_back(CreateTrackObject(assignment.frame, assignment.id,
+                                                         assignment.object));
+        }
+    });
+}
+
+int gbmot_finish(gbmot_tracker* tracker, gbmot_track_object* objects, size_t capacity,
+                 size_t* count)
+{
+    return Call(tracker, objects, capacity, count, [&]()
+    {
+        if (!tracker->online) return;
+
+        std::vector<algo::TrackAssignment> assignments;
+        tracker->online->Finish(assignments);
+        tracker->online.reset();
+
+        for (auto& assignment : assignments)
+        {
+            tracker->pending.push_back(CreateTrackObject(assignment.frame, assignment.id,
+                                                         assignment.object));
+        }
+    });
+}
+
+int gbmot_read(gbmot_tracker* tracker, gbmot_track_object* objects, size_t capacity,
+               size_t* count)
+{
+    if (count != nullptr)
+    {
+        *count = 0;
+    }
+    if (tracker == nullptr)
+    {
+        return GBMOT_ERROR;
+    }
+
+    return CopyObjects(tracker, objects, capacity, count);
+}
+
+size_t gbmot_pending(const gbmot_tracker* tracker)
+{
+    return tracker != nullptr ? tracker->pending.size() - tracker->read_count : 0;
+}
+
+size_t gbmot_next_frame(const gbmot_tracker* tracker)
+{
+    return tracker != nullptr && tracker->online ? tracker->online->GetNextFrameIndex() : 0;
+}
+
+const char* gbmot_last_error(const gbmot_tracker* tracker)
+{
+    return tracker != nullptr ? tracker->error.c_str() : "No tracker";
+}
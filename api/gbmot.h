@@ -0,0 +1,232 @@
+#ifndef GBMOT_API_GBMOT_H
+#define GBMOT_API_GBMOT_H
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+#define GBMOT_API __attribute__((visibility("default")))
+#else
+#define GBMOT_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The call succeeded and all track objects were copied.
+ */
+#define GBMOT_OK 0
+
+/**
+ * The call failed, gbmot_last_error describes why.
+ */
+#define GBMOT_ERROR 1
+
+/**
+ * The call succeeded but more track objects are left than fit into the
+ * buffer, they are copied by gbmot_read.
+ */
+#define GBMOT_BUFFER_TOO_SMALL 2
+
+/**
+ * The settings of a tracker, the names match the command line options.
+ * gbmot_config_init sets the command line defaults.
+ */
+typedef struct gbmot_config
+{
+    /** The algorithm to run: n-stage or berclaz */
+    const char* algorithm;
+
+    /** The object model: 2D, Box or Angular */
+    const char* input_format;
+
+    /** The image size, the positions are divided by it */
+    double image_width;
+    double image_height;
+
+    double temporal_weight;
+    double spatial_weight;
+    double angular_weight;
+
+    /** (n stage) Comma separated values for every stage, e.g. "1,1" */
+    const char* max_frame_skip;
+    const char* penalty_value;
+    const char* max_tracklet_count;
+
+    /** (berclaz) */
+    int horizontal_resolution;
+    int vertical_resolution;
+    int vicinity_size;
+    size_t batch_size;
+    size_t max_track_count;
+
+    /** (streaming) The number of frames pushed after a frame before its tracks are final */
+    size_t latency;
+
+    /** (streaming) The detection scores normalized to zero and one, others are clamped */
+    double score_min;
+    double score_max;
+} gbmot_config;
+
+/**
+ * Detections in memory owned by the caller, they are read in place.
+ * Every value of a detection is found the stride in bytes after the value of
+ * the previous detection, thus both separate arrays (stride zero or
+ * sizeof(double)) and arrays of structs (stride of the struct) can be passed.
+ * Values not needed by the object model may be null and are read as zero.
+ */
+typedef struct gbmot_detections
+{
+    size_t count;
+
+    const double* frame;
+    size_t frame_stride;
+    const double* x;
+    size_t x_stride;
+    const double* y;
+    size_t y_stride;
+    const double* width;
+    size_t width_stride;
+    const double* height;
+    size_t height_stride;
+    const double* angle;
+    size_t angle_stride;
+    const double* score;
+    size_t score_stride;
+} gbmot_detections;
+
+/**
+ * A single object of a track, the values of the long track format.
+ * The position and size are divided by the image size.
+ */
+typedef struct gbmot_track_object
+{
+    size_t frame;
+    size_t track_id;
+    double x;
+    double y;
+    double width;
+    double height;
+    double score;
+} gbmot_track_object;
+
+/**
+ * A tracker with its settings, the streaming state and the track objects not
+ * yet copied to the caller. A tracker must only be used by one thread at a
+ * time, different trackers can be used concurrently.
+ */
+typedef struct gbmot_tracker gbmot_tracker;
+
+/**
+ * Sets the command line defaults, the algorithm is n-stage and the object
+ * model 2D.
+ *
+ * @param config The settings to initialize
+ */
+GBMOT_API void gbmot_config_init(gbmot_config* config);
+
+/**
+ * Creates a tracker, the settings are copied.
+ *
+ * @param config The settings
+ * @return The tracker or null if the algorithm or object model is unknown
+ */
+GBMOT_API gbmot_tracker* gbmot_create(const gbmot_config* config);
+
+/**
+ * Destroys the tracker and releases all of its memory.
+ *
+ * @param tracker The tracker, may be null
+ */
+GBMOT_API void gbmot_destroy(gbmot_tracker* tracker);
+
+/**
+ * Tracks the given detections at once, the scores are normalized with their
+ * range. The track objects are ordered by frame and copied into the given
+ * buffer, the remaining ones are copied by gbmot_read.
+ *
+ * @param tracker The tracker
+ * @param detections The detections of all frames, null for none
+ * @param objects The buffer to copy the track objects into, may be null
+ * @param capacity The number of objects fitting into the buffer
+ * @param count Set to the number of copied objects, may be null
+ * @return GBMOT_OK, GBMOT_BUFFER_TOO_SMALL or GBMOT_ERROR
+ */
+GBMOT_API int gbmot_track(gbmot_tracker* tracker, const gbmot_detections* detections,
+                          gbmot_track_object* objects, size_t capacity, size_t* count);
+
+/**
+ * Adds the detections of the next frames to the stream and tracks every frame
+ * that has latency later frames. The scores are normalized with the score
+ * range of the settings. The objects of the finalized frames are copied like
+ * by gbmot_track, their track ids never change.
+ *
+ * @param tracker The tracker
+ * @param detections The detections, all of them in the pushed frames, null
+ *                   if the pushed frames contain no detection
+ * @param frame_count The number of pushed frames, including the frames
+ *                    without detections, they start at gbmot_next_frame
+ * @param objects The buffer to copy the track objects into, may be null
+ * @param capacity The number of objects fitting into the buffer
+ * @param count Set to the number of copied objects, may be null
+ * @return GBMOT_OK, GBMOT_BUFFER_TOO_SMALL or GBMOT_ERROR
+ */
+GBMOT_API int gbmot_push(gbmot_tracker* tracker, const gbmot_detections* detections,
+                         size_t frame_count, gbmot_track_object* objects, size_t capacity,
+                         size_t* count);
+
+/**
+ * Tracks the remaining frames of the stream and starts a new stream.
+ *
+ * @param tracker The tracker
+ * @param objects The buffer to copy the track objects into, may be null
+ * @param capacity The number of objects fitting into the buffer
+ * @param count Set to the number of copied objects, may be null
+ * @return GBMOT_OK, GBMOT_BUFFER_TOO_SMALL or GBMOT_ERROR
+ */
+GBMOT_API int gbmot_finish(gbmot_tracker* tracker, gbmot_track_object* objects,
+                           size_t capacity, size_t* count);
+
+/**
+ * Copies the track objects left by the last call.
+ *
+ * @param tracker The tracker
+ * @param objects The buffer to copy the track objects into
+ * @param capacity The number of objects fitting into the buffer
+ * @param count Set to the number of copied objects, may be null
+ * @return GBMOT_OK or GBMOT_BUFFER_TOO_SMALL
+ */
+GBMOT_API int gbmot_read(gbmot_tracker* tracker, gbmot_track_object* objects,
+                         size_t capacity, size_t* count);
+
+/**
+ * Gets the number of track objects not yet copied.
+ *
+ * @param tracker The tracker
+ * @return The object count
+ */
+GBMOT_API size_t gbmot_pending(const gbmot_tracker* tracker);
+
+/**
+ * Gets the index of the first frame of the next push.
+ *
+ * @param tracker The tracker
+ * @return The frame index
+ */
+GBMOT_API size_t gbmot_next_frame(const gbmot_tracker* tracker);
+
+/**
+ * Gets the message of the last error.
+ *
+ * @param tracker The tracker
+ * @return The message, empty if the last call succeeded, valid until the
+ *         next call with the tracker
+ */
+GBMOT_API const char* gbmot_last_error(const gbmot_tracker* tracker);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //GBMOT_API_GBMOT_H
@@ -0,0 +1,324 @@
+#include "Benchmarks.h"
+#include "Fixtures.h"
+#include "../algo/KShortestPaths.h"
+#include "../algo/NStage.h"
+#include "../algo/Berclaz.h"
+#include "../util/Generator.h"
+#include "../util/Memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace bench
+{
+    namespace
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        long long Nanoseconds(Clock::time_point begin, Clock::time_point end)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        }
+
+        std::string CreateName(const std::string& family, const std::string& size,
+                               const std::vector<std::pair<std::string, double>>& params)
+        {
+            std::string name = family + "/" + size;
+            for (auto& param : params)
+            {
+                char value[32];
+                snprintf(value, sizeof(value), "%g", param.second);
+                name += "/" + param.first + "=" + value;
+            }
+            return name;
+        }
+
+        void AddCase(std::vector<BenchmarkCase>& cases, const std::string& family,
+                     const std::string& size,
+                     const std::vector<std::pair<std::string, double>>& params,
+                     std::function<long long()> run)
+        {
+            BenchmarkCase benchmark;
+            benchmark.name = CreateName(family, size, params);
+            benchmark.family = family;
+            benchmark.params = params;
+            benchmark.run = run;
+            cases.push_back(benchmark);
+        }
+
+        long long RunKShortestPaths(DirectedGraph& graph, Vertex source, Vertex sink,
+                                    size_t path_count)
+        {
+            // The solver copies the graph, the copy is not part of the timing
+            algo::KShortestPaths ksp(graph, source, sink);
+
+            Clock::time_point begin = Clock::now();
+            ksp.Run(path_count);
+            std::vector<std::vector<Vertex>> paths;
+            ksp.GetPaths(paths);
+            return Nanoseconds(begin, Clock::now());
+        }
+
+        void CreateSequence(core::DetectionSequence& sequence, size_t frame_count,
+                            size_t track_count, double false_positive_rate, unsigned int seed)
+        {
+            util::Generator generator(track_count, frame_count, seed);
+            generator.SetFalsePositiveRate(false_positive_rate);
+            generator.Generate(sequence, "2D");
+        }
+
+        long long RunNStage(size_t frame_count, size_t track_count,
+                            double false_positive_rate, size_t max_frame_skip,
+                            unsigned int seed)
+        {
+            core::DetectionSequence sequence;
+            CreateSequence(sequence, frame_count, track_count, false_positive_rate, seed);
+
+            Clock::time_point begin = Clock::now();
+            algo::NStage<core::ObjectModel2D> n_stage({ max_frame_skip, max_frame_skip },
+                                                      { 50.0, 50.0 },
+                                                      { std::numeric_limits<size_t>::max(),
+                                                        track_count });
+            std::vector<core::TrackletPtr> result;
+            n_stage.Run(sequence, result);
+            return Nanoseconds(begin, Clock::now());
+        }
+
+        long long RunBerclaz(size_t frame_count, size_t track_count,
+                             double false_positive_rate, int resolution, size_t batch_size,
+                             unsigned int seed)
+        {
+            core::DetectionSequence sequence;
+            CreateSequence(sequence, frame_count, track_count, false_positive_rate, seed);
+
+            Clock::time_point begin = Clock::now();
+            algo::Berclaz berclaz(resolution, resolution, 1);
+            std::vector<core::TrackletPtr> result;
+            berclaz.Run(sequence, batch_size, track_count, result);
+            return Nanoseconds(begin, Clock::now());
+        }
+    }
+
+    void CreateBenchmarks(std::vector<BenchmarkCase>& cases, unsigned int seed,
+                          size_t max_detection_count)
+    {
+        const std::vector<std::string> sizes = { "small", "medium", "large" };
+
+        // The example graphs, both contain only two disjoint paths
+        for (int first = 1; first >= 0; --first)
+        {
+            AddCase(cases, "ksp_suurballe", first ? "first" : "second",
+                    { { "k", 2 } },
+                    [first]()
+                    {
+                        DirectedGraph graph;
+                        Vertex source, sink;
+                        CreateSuurballeGraph(graph, source, sink, first == 1);
+                        return RunKShortestPaths(graph, source, sink, 2);
+                    });
+        }
+        for (int two_paths = 1; two_paths >= 0; --two_paths)
+        {
+            AddCase(cases, "ksp_presentation", two_paths ? "two_paths" : "three_paths",
+                    { { "k", 2 } },
+                    [two_paths]()
+                    {
+                        DirectedGraph graph;
+                        Vertex source, sink;
+                        CreatePresentationGraph(graph, source, sink, two_paths == 1);
+                        return RunKShortestPaths(graph, source, sink, 2);
+                    });
+        }
+
+        // Negative edge weights, solved with bellman ford
+        const size_t layer_counts[] = { 10, 50, 100 };
+        const size_t layer_sizes[] = { 10, 20, 50 };
+        const size_t layered_path_counts[] = { 3, 5, 10 };
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            size_t layer_count = layer_counts[i];
+            size_t layer_size = layer_sizes[i];
+            size_t k = layered_path_counts[i];
+            AddCase(cases, "ksp_layered", sizes[i],
+                    { { "layers", layer_count }, { "layer_size", layer_size }, { "k", k } },
+                    [=]()
+                    {
+                        DirectedGraph graph;
+                        Vertex source, sink;
+                        CreateLayeredGraph(graph, source, sink, layer_count, layer_size, seed);
+                        return RunKShortestPaths(graph, source, sink, k);
+                    });
+        }
+
+        // Berclaz grid graphs
+        const int grid_widths[] = { 8, 16, 24 };
+        const int grid_depths[] = { 10, 20, 40 };
+        const size_t grid_path_counts[] = { 3, 5, 10 };
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            int width = grid_widths[i];
+            int depth = grid_depths[i];
+            size_t k = grid_path_counts[i];
+            AddCase(cases, "ksp_grid", sizes[i],
+                    { { "width", width }, { "height", width }, { "depth", depth },
+                      { "vicinity", 1 }, { "k", k } },
+                    [=]()
+                    {
+                        DirectedGraph graph;
+                        Vertex source, sink;
+                        CreateGridGraph(graph, source, sink, width, width, depth, 1, k, seed);
+                        return RunKShortestPaths(graph, source, sink, k);
+                    });
+        }
+
+        // The full algorithms on synthetic detections
+        const size_t frame_counts[] = { 50, 100, 200 };
+        const size_t track_counts[] = { 5, 10, 15 };
+        const double false_positive_rates[] = { 5.0, 10.0, 15.0 };
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            size_t frames = frame_counts[i];
+            size_t tracks = track_counts[i];
+            double false_positives = false_positive_rates[i];
+            AddCase(cases, "nstage", sizes[i],
+                    { { "frames", frames }, { "tracks", tracks },
+                      { "false_positives", false_positives },
+                      { "max_frame_skip", 3 }, { "penalty", 50 } },
+                    [=]()
+                    {
+                        return RunNStage(frames, tracks, false_positives, 3, seed);
+                    });
+        }
+
+        const int resolutions[] = { 16, 20, 24 };
+        const size_t batch_sizes[] = { 25, 25, 50 };
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            size_t frames = frame_counts[i];
+            size_t tracks = track_counts[i];
+            double false_positives = false_positive_rates[i];
+            int resolution = resolutions[i];
+            size_t batch_size = batch_sizes[i];
+            AddCase(cases, "berclaz", sizes[i],
+                    { { "frames", frames }, { "tracks", tracks },
+                      { "false_positives", false_positives },
+                      { "resolution", resolution }, { "vicinity", 1 },
+                      { "batch_size", batch_size } },
+                    [=]()
+                    {
+                        return RunBerclaz(frames, tracks, false_positives, resolution,
+                                          batch_size, seed);
+                    });
+        }
+
+        // The growth with the number of detections, ten objects and eleven
+        // false positives result in about 20 detections per frame
+        for (size_t detections = 100; detections <= max_detection_count; detections *= 10)
+        {
+            size_t frames = detections / 20;
+            AddCase(cases, "scaling_nstage", std::to_string(detections),
+                    { { "frames", frames }, { "tracks", 10 }, { "false_positives", 11 },
+                      { "max_frame_skip", 1 }, { "penalty", 50 } },
+                    [=]()
+                    {
+                        return RunNStage(frames, 10, 11.0, 1, seed);
+                    });
+            AddCase(cases, "scaling_berclaz", std::to_string(detections),
+                    { { "frames", frames }, { "tracks", 10 }, { "false_positives", 11 },
+                      { "resolution", 16 }, { "vicinity", 1 }, { "batch_size", 50 } },
+                    [=]()
+                    {
+                        return RunBerclaz(frames, 10, 11.0, 16, 50, seed);
+                    });
+        }
+    }
+
+    BenchmarkResult Measure(const BenchmarkCase& benchmark, size_t warmup, size_t repeat)
+    {
+        for (size_t i = 0; i < warmup; ++i)
+        {
+            benchmark.run();
+        }
+
+        std::vector<long long> times;
+        size_t peak_rss = 0;
+        for (size_t i = 0; i < repeat; ++i)
+        {
+            util::Memory::ResetPeakResidentSize();
+            times.push_back(benchmark.run());
+            peak_rss = std::max(peak_rss, util::Memory::GetPeakResidentSize());
+        }
+        std::sort(times.begin(), times.end());
+
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.family = benchmark.family;
+        result.params = benchmark.params;
+        result.repeat = repeat;
+        result.min = 0;
+        result.median = 0;
+        result.mean = 0;
+        result.max = 0;
+        result.stddev = 0.0;
+        result.peak_rss_bytes = peak_rss;
+        if (times.empty())
+        {
+            return result;
+        }
+
+        double sum = 0.0;
+        for (long long time : times)
+        {
+            sum += time;
+        }
+        double mean = sum / times.size();
+
+        double squares = 0.0;
+        for (long long time : times)
+        {
+            squares += (time - mean) * (time - mean);
+        }
+
+        result.min = times.front();
+        result.max = times.back();
+        result.median = times[times.size() / 2];
+        result.mean = (long long) mean;
+        result.stddev = std::sqrt(squares / times.size());
+
+        return result;
+    }
+
+    void WriteJSON(std::ostream& out, const std::vector<BenchmarkResult>& results,
+                   size_t warmup, unsigned int seed)
+    {
+        out << "{\n  \"warmup\": " << warmup << ",\n  \"seed\": " << seed
+            << ",\n  \"benchmarks\": [";
+
+        // The names and parameters contain no quotes, thus need no escaping
+        bool first = true;
+        for (auto& result : results)
+        {
+            out << (first ? "\n" : ",\n");
+            out << "    {\"name\": \"" << result.name << "\""
+                << ", \"family\": \"" << result.family << "\""
+                << ", \"params\": {";
+            for (size_t i = 0; i < result.params.size(); ++i)
+            {
+                out << (i > 0 ? ", " : "") << "\"" << result.params[i].first << "\": "
+                    << result.params[i].second;
+            }
+            out << "}"
+                << ", \"repeat\": " << result.repeat
+                << ", \"min_ns\": " << result.min
+                << ", \"median_ns\": " << result.median
+                << ", \"mean_ns\": " << result.mean
+                << ", \"max_ns\": " << result.max
+                << ", \"stddev_ns\": " << (long long) result.stddev
+                << ", \"peak_rss_bytes\": " << result.peak_rss_bytes << "}";
+            first = false;
+        }
+
+        out << "\n  ]\n}\n";
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef GBMOT_BENCHMARKS_H
+#define GBMOT_BENCHMARKS_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    /**
+     * A benchmark with a fixed set of parameters.
+     */
+    struct BenchmarkCase
+    {
+        /**
+         * The unique name, made of the family and the parameters
+         */
+        std::string name;
+
+        /**
+         * The name of the measured algorithm and input
+         */
+        std::string family;
+
+        /**
+         * The parameters of the input and the algorithm
+         */
+        std::vector<std::pair<std::string, double>> params;
+
+        /**
+         * Creates the input, runs the measured code once and returns the
+         * measured time in nanoseconds. The input is created anew for every
+         * run, thus every run starts with the same state.
+         */
+        std::function<long long()> run;
+    };
+
+    /**
+     * The times measured for one benchmark case in nanoseconds.
+     */
+    struct BenchmarkResult
+    {
+        std::string name;
+        std::string family;
+        std::vector<std::pair<std::string, double>> params;
+        size_t repeat;
+        long long min;
+        long long median;
+        long long mean;
+        long long max;
+        double stddev;
+
+        /**
+         * The largest peak resident set size of a single run in bytes,
+         * includes the memory kept by the allocator from previous runs
+         */
+        size_t peak_rss_bytes;
+    };
+
+    /**
+     * Creates the micro-benchmarks for KShortestPaths, NStage and Berclaz,
+     * each with a small, medium and large input, and the scaling benchmarks
+     * of NStage and Berclaz with 100 to the maximum number of detections,
+     * growing by factors of ten.
+     *
+     * @param cases The vector to add the benchmarks to
+     * @param seed The seed of all random inputs
+     * @param max_detection_count The maximum number of detections of the
+     *                            scaling benchmarks
+     */
+    void CreateBenchmarks(std::vector<BenchmarkCase>& cases, unsigned int seed,
+                          size_t max_detection_count);
+
+    /**
+     * Runs the given benchmark and aggregates the measured times.
+     * The peak resident set size is reset before every run.
+     *
+     * @param benchmark The benchmark to run
+     * @param warmup The number of runs before measuring
+     * @param repeat The number of measured runs
+     * @return The aggregated times
+     */
+    BenchmarkResult Measure(const BenchmarkCase& benchmark, size_t warmup, size_t repeat);
+
+    /**
+     * Writes the given results as JSON.
+     *
+     * @param out The stream to write into
+     * @param results The results to write
+     * @param warmup The number of runs before measuring
+     * @param seed The seed of all random inputs
+     */
+    void WriteJSON(std::ostream& out, const std::vector<BenchmarkResult>& results,
+                   size_t warmup, unsigned int seed);
+}
+
+
+#endif //GBMOT_BENCHMARKS_H
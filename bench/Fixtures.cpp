@@ -0,0 +1,227 @@
+#include "Fixtures.h"
+#include "../util/Random.h"
+#include <algorithm>
+#include <cmath>
+
+namespace bench
+{
+    void CreateSuurballeGraph(DirectedGraph& graph, Vertex& source, Vertex& sink, bool first)
+    {
+        std::vector<Vertex> vertices;
+
+        if (first)
+        {
+            // First example graph
+            for (int i = 0; i < 7; ++i)
+            {
+                vertices.push_back(boost::add_vertex(graph));
+            }
+
+            source = vertices[0];
+            sink = vertices[6];
+
+            boost::add_edge(vertices[0], vertices[1], 5.0, graph);
+            boost::add_edge(vertices[0], vertices[4], 2.0, graph);
+            boost::add_edge(vertices[1], vertices[2], 1.0, graph);
+            boost::add_edge(vertices[1], vertices[4], 1.0, graph);
+            boost::add_edge(vertices[2], vertices[6], 1.0, graph);
+            boost::add_edge(vertices[3], vertices[2], 1.0, graph);
+            boost::add_edge(vertices[4], vertices[3], 2.0, graph);
+            boost::add_edge(vertices[4], vertices[5], 1.0, graph);
+            boost::add_edge(vertices[5], vertices[2], 1.0, graph);
+            boost::add_edge(vertices[5], vertices[6], 1.0, graph);
+        }
+        else
+        {
+            // Second example graph
+            for (int i = 0; i < 8; ++i)
+            {
+                vertices.push_back(boost::add_vertex(graph));
+            }
+            source = vertices[0];
+            sink = vertices[7];
+            boost::add_edge(vertices[0], vertices[1], 1.0, graph);
+            boost::add_edge(vertices[0], vertices[4], 8.0, graph);
+            boost::add_edge(vertices[0], vertices[5], 1.0, graph);
+            boost::add_edge(vertices[1], vertices[2], 1.0, graph);
+            boost::add_edge(vertices[1], vertices[7], 8.0, graph);
+            boost::add_edge(vertices[2], vertices[3], 1.0, graph);
+            boost::add_edge(vertices[3], vertices[4], 1.0, graph);
+            boost::add_edge(vertices[3], vertices[6], 2.0, graph);
+            boost::add_edge(vertices[4], vertices[7], 1.0, graph);
+            boost::add_edge(vertices[5], vertices[2], 2.0, graph);
+            boost::add_edge(vertices[5], vertices[6], 6.0, graph);
+            boost::add_edge(vertices[6], vertices[7], 1.0, graph);
+        }
+    }
+
+    void CreatePresentationGraph(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                                 bool two_paths)
+    {
+        std::vector<Vertex> vertices;
+
+        size_t vertex_count = two_paths ? 10 : 14;
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            vertices.push_back(
+                    boost::add_vertex(core::ObjectDataPtr(new core::ObjectData(i)), graph));
+        }
+
+        source = vertices[0];
+        sink = vertices[9];
+
+        boost::add_edge(vertices[0], vertices[1], 1.0, graph);
+        boost::add_edge(vertices[0], vertices[2], 1.0, graph);
+        boost::add_edge(vertices[1], vertices[3], 12.0, graph);
+        boost::add_edge(vertices[1], vertices[4], 15.0, graph);
+        boost::add_edge(vertices[2], vertices[3], 15.0, graph);
+        boost::add_edge(vertices[2], vertices[4], 10.0, graph);
+        boost::add_edge(vertices[3], vertices[5], 15.0, graph);
+        boost::add_edge(vertices[3], vertices[6], 12.0, graph);
+        boost::add_edge(vertices[4], vertices[5], 12.0, graph);
+        boost::add_edge(vertices[4], vertices[6], 11.0, graph);
+        boost::add_edge(vertices[5], vertices[7], 12.0, graph);
+        boost::add_edge(vertices[5], vertices[8], 12.0, graph);
+        boost::add_edge(vertices[6], vertices[7], 11.0, graph);
+        boost::add_edge(vertices[6], vertices[8], 10.0, graph);
+        boost::add_edge(vertices[7], vertices[9], 1.0, graph);
+        boost::add_edge(vertices[8], vertices[9], 1.0, graph);
+
+        if (!two_paths)
+        {
+            boost::add_edge(vertices[0], vertices[10], 20.0, graph);
+            boost::add_edge(vertices[10], vertices[11], 20.0, graph);
+            boost::add_edge(vertices[10], vertices[3], 20.0, graph);
+            boost::add_edge(vertices[10], vertices[4], 20.0, graph);
+            boost::add_edge(vertices[11], vertices[12], 20.0, graph);
+            boost::add_edge(vertices[11], vertices[5], 20.0, graph);
+            boost::add_edge(vertices[12], vertices[6], 20.0, graph);
+            boost::add_edge(vertices[13], vertices[9], 20.0, graph);
+        }
+    }
+
+    void CreateLayeredGraph(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                            size_t layer_count, size_t layer_size, unsigned int seed)
+    {
+        util::Random random(seed);
+
+        source = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()), graph);
+
+        std::vector<Vertex> vertices;
+        for (size_t i = 0; i < layer_count * layer_size; ++i)
+        {
+            vertices.push_back(boost::add_vertex(
+                    core::ObjectDataPtr(new core::ObjectData(i / layer_size)), graph));
+        }
+
+        sink = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()), graph);
+
+        for (size_t l = 0; l < layer_count; ++l)
+        {
+            for (size_t i = 0; i < layer_size; ++i)
+            {
+                Vertex u = vertices[l * layer_size + i];
+                boost::add_edge(source, u, 0.0, graph);
+                boost::add_edge(u, sink, 0.0, graph);
+
+                // Connect with the vertex at the same position and the two
+                // following vertices in the next layer
+                if (l + 1 < layer_count)
+                {
+                    for (size_t j = i; j < std::min(i + 3, layer_size); ++j)
+                    {
+                        boost::add_edge(u, vertices[(l + 1) * layer_size + j],
+                                        -random.Uniform(1.0, 3.0), graph);
+                    }
+                }
+            }
+        }
+    }
+
+    void CreateGridGraph(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                         int width, int height, int depth, int vicinity_size,
+                         size_t path_count, unsigned int seed)
+    {
+        util::Random random(seed);
+
+        // Low scores everywhere
+        int layer_size = width * height;
+        std::vector<double> scores((size_t) (layer_size * depth));
+        for (auto& score : scores)
+        {
+            score = random.Uniform(0.0, 0.5);
+        }
+
+        // High scores along random walks through the frames
+        for (size_t p = 0; p < path_count; ++p)
+        {
+            int x = random.UniformInt(0, width - 1);
+            int y = random.UniformInt(0, height - 1);
+            for (int z = 0; z < depth; ++z)
+            {
+                scores[x + y * width + z * layer_size] = random.Uniform(0.6, 1.0);
+                x = std::min(std::max(x + random.UniformInt(-vicinity_size, vicinity_size), 0),
+                             width - 1);
+                y = std::min(std::max(y + random.UniformInt(-vicinity_size, vicinity_size), 0),
+                             height - 1);
+            }
+        }
+
+        // Add grid vertices
+        std::vector<Vertex> vertices;
+        for (int i = 0; i < layer_size * depth; ++i)
+        {
+            core::ObjectDataPtr value(new core::ObjectData((size_t) (i / layer_size)));
+            value->SetDetectionScore(scores[i]);
+            vertices.push_back(boost::add_vertex(value, graph));
+        }
+
+        // Add source and sink vertex
+        source = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()), graph);
+        sink = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()), graph);
+
+        for (int z = 0; z < depth; ++z)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    int vi = x + y * width + z * layer_size;
+
+                    // Clamp the score to prevent division by zero and
+                    // logarithm of zero
+                    double score = std::min(std::max(scores[vi], 0.000001), 0.999999);
+                    double weight = -std::log(score / (1 - score));
+
+                    // Connect with the vicinity in the next frame, the last
+                    // frame with the sink
+                    if (z < depth - 1)
+                    {
+                        for (int ny = std::max(0, y - vicinity_size);
+                             ny < std::min(height, y + vicinity_size + 1);
+                             ++ny)
+                        {
+                            for (int nx = std::max(0, x - vicinity_size);
+                                 nx < std::min(width, x + vicinity_size + 1);
+                                 ++nx)
+                            {
+                                int vj = nx + ny * width + (z + 1) * layer_size;
+                                boost::add_edge(vertices[vi], vertices[vj], weight, graph);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        boost::add_edge(vertices[vi], sink, weight, graph);
+                    }
+
+                    // Connect the first frame with the source
+                    if (z == 0)
+                    {
+                        boost::add_edge(source, vertices[vi], 0.0, graph);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef GBMOT_FIXTURES_H
+#define GBMOT_FIXTURES_H
+
+#include "../graph/Definitions.h"
+
+namespace bench
+{
+    /**
+     * Creates one of the two example graphs of the suurballe algorithm.
+     *
+     * @param graph The graph to add the vertices and edges to
+     * @param source The created source vertex
+     * @param sink The created sink vertex
+     * @param first True, for the first example, false for the second
+     */
+    void CreateSuurballeGraph(DirectedGraph& graph, Vertex& source, Vertex& sink, bool first);
+
+    /**
+     * Creates the example graph of the presentation, with two crossing paths
+     * and optionally a third, more expensive branch.
+     *
+     * @param graph The graph to add the vertices and edges to
+     * @param source The created source vertex
+     * @param sink The created sink vertex
+     * @param two_paths True, to only add the two crossing paths
+     */
+    void CreatePresentationGraph(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                                 bool two_paths);
+
+    /**
+     * Creates a graph with layers of vertices and negative edge weights.
+     * Every vertex is connected with the source, the sink and up to three
+     * vertices in the next layer, thus the shortest paths need bellman ford.
+     *
+     * @param graph The graph to add the vertices and edges to
+     * @param source The created source vertex
+     * @param sink The created sink vertex
+     * @param layer_count The number of layers
+     * @param layer_size The number of vertices in every layer
+     * @param seed The seed of the random edge weights
+     */
+    void CreateLayeredGraph(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                            size_t layer_count, size_t layer_size, unsigned int seed);
+
+    /**
+     * Creates a graph like the berclaz algorithm does, with one vertex per
+     * grid cell and frame, connected with the cells in the vicinity in the
+     * next frame. The cells have low random scores, except for the cells of
+     * the given number of random walks through the grid.
+     *
+     * @param graph The graph to add the vertices and edges to
+     * @param source The created source vertex
+     * @param sink The created sink vertex
+     * @param width The number of cells in x direction
+     * @param height The number of cells in y direction
+     * @param depth The number of frames
+     * @param vicinity_size The number of cells to connect in every direction
+     * @param path_count The number of random walks with high scores
+     * @param seed The seed of the random scores and walks
+     */
+    void CreateGridGraph(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                         int width, int height, int depth, int vicinity_size,
+                         size_t path_count, unsigned int seed);
+}
+
+
+#endif //GBMOT_FIXTURES_H
@@ -0,0 +1,423 @@
+#include "Regression.h"
+#include "../core/ObjectData2D.h"
+#include "../algo/Berclaz.h"
+#include "../algo/NStage.h"
+#include "../util/FileIO.h"
+#include "../util/Generator.h"
+#include "../util/Memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sys/stat.h>
+
+namespace bench
+{
+    namespace
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        /**
+         * An object of a track in a form independent of the object model
+         */
+        struct TrackRow
+        {
+            size_t track;
+            size_t frame;
+            bool is_virtual;
+            double x;
+            double y;
+            double score;
+        };
+
+        /**
+         * The measured values of a case
+         */
+        struct Baseline
+        {
+            long long min_ns;
+            size_t peak_rss_bytes;
+        };
+
+        const std::string BASELINE_FILE = "baseline.csv";
+
+        std::string GetTrackFile(const std::string& golden_path, const std::string& name)
+        {
+            return golden_path + "/" + name + ".tracks.csv";
+        }
+
+        template<typename Model>
+        void RunNStage(const RegressionCase& regression_case,
+                       const core::DetectionSequence& sequence,
+                       std::vector<core::TrackletPtr>& tracks)
+        {
+            algo::NStage<Model> n_stage({ 3, 3 }, { 50.0, 50.0 },
+                                        { std::numeric_limits<size_t>::max(),
+                                          regression_case.object_count });
+            n_stage.Run(sequence, tracks);
+        }
+
+        long long RunCase(const RegressionCase& regression_case,
+                          std::vector<core::TrackletPtr>& tracks)
+        {
+            util::Generator generator(regression_case.object_count,
+                                      regression_case.frame_count, regression_case.seed);
+            generator.SetMotionModel(regression_case.motion_model, 0.01);
+            generator.SetFalsePositiveRate(regression_case.false_positive_rate);
+            generator.SetPositionNoise(regression_case.position_noise);
+
+            core::DetectionSequence sequence;
+            generator.Generate(sequence, regression_case.input_format);
+
+            tracks.clear();
+            Clock::time_point begin = Clock::now();
+            if (regression_case.algorithm == "berclaz")
+            {
+                algo::Berclaz berclaz(16, 16, 1);
+                berclaz.Run(sequence, 25, regression_case.object_count, tracks);
+            }
+            else if (regression_case.input_format == "2D")
+            {
+                RunNStage<core::ObjectModel2D>(regression_case, sequence, tracks);
+            }
+            else if (regression_case.input_format == "Box")
+            {
+                RunNStage<core::ObjectModelBox>(regression_case, sequence, tracks);
+            }
+            else
+            {
+                RunNStage<core::ObjectModelAngular>(regression_case, sequence, tracks);
+            }
+            Clock::time_point end = Clock::now();
+
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        }
+
+        void CreateRows(std::vector<core::TrackletPtr>& tracks, std::vector<TrackRow>& rows)
+        {
+            for (size_t t = 0; t < tracks.size(); ++t)
+            {
+                for (size_t i = 0; i < tracks[t]->GetPathObjectCount(); ++i)
+                {
+                    core::ObjectDataPtr obj = tracks[t]->GetPathObject(i);
+                    core::ObjectData2DPtr obj_2d =
+                            std::dynamic_pointer_cast<core::ObjectData2D>(obj);
+
+                    TrackRow row;
+                    row.track = t;
+                    row.frame = obj->GetFrameIndex();
+                    row.is_virtual = !obj_2d;
+                    row.x = obj_2d ? obj_2d->GetPosition().x : 0.0;
+                    row.y = obj_2d ? obj_2d->GetPosition().y : 0.0;
+                    row.score = obj->GetDetectionScore();
+                    rows.push_back(row);
+                }
+            }
+        }
+
+        void WriteRows(const std::vector<TrackRow>& rows, const std::string& file_name)
+        {
+            std::ofstream out(file_name);
+            if (!out.is_open())
+            {
+                throw "Unable to open file: " + file_name;
+            }
+
+            // Full precision, thus the values are read back unchanged
+            char line[256];
+            for (auto& row : rows)
+            {
+                if (row.is_virtual)
+                {
+                    snprintf(line, sizeof(line), "%zu;%zu;;;%.17g\n",
+                             row.track, row.frame, row.score);
+                }
+                else
+                {
+                    snprintf(line, sizeof(line), "%zu;%zu;%.17g;%.17g;%.17g\n",
+                             row.track, row.frame, row.x, row.y, row.score);
+                }
+                out << line;
+            }
+        }
+
+        void ReadRows(std::vector<TrackRow>& rows, const std::string& file_name)
+        {
+            std::ifstream in(file_name);
+            if (!in.is_open())
+            {
+                throw "Unable to open file: " + file_name;
+            }
+
+            std::string line;
+            while (std::getline(in, line))
+            {
+                std::vector<std::string> values = util::FileIO::split(line, ';');
+                if (values.size() != 5)
+                {
+                    throw "Invalid track file: " + file_name;
+                }
+
+                TrackRow row;
+                row.track = std::stoul(values[0]);
+                row.frame = std::stoul(values[1]);
+                row.is_virtual = values[2].empty();
+                row.x = row.is_virtual ? 0.0 : std::stod(values[2]);
+                row.y = row.is_virtual ? 0.0 : std::stod(values[3]);
+                row.score = std::stod(values[4]);
+                rows.push_back(row);
+            }
+        }
+
+        bool CompareRows(const std::vector<TrackRow>& expected,
+                         const std::vector<TrackRow>& actual, double tolerance,
+                         std::string& message)
+        {
+            size_t count = std::min(expected.size(), actual.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                const TrackRow& e = expected[i];
+                const TrackRow& a = actual[i];
+                if (e.track != a.track || e.frame != a.frame || e.is_virtual != a.is_virtual ||
+                    std::fabs(e.x - a.x) > tolerance || std::fabs(e.y - a.y) > tolerance ||
+                    std::fabs(e.score - a.score) > tolerance)
+                {
+                    message = "track " + std::to_string(e.track) + " differs at frame " +
+                              std::to_string(e.frame);
+                    return false;
+                }
+            }
+
+            if (expected.size() != actual.size())
+            {
+                message = std::to_string(actual.size()) + " track objects instead of " +
+                          std::to_string(expected.size());
+                return false;
+            }
+
+            return true;
+        }
+
+        void ReadBaseline(std::map<std::string, Baseline>& baseline,
+                          const std::string& file_name)
+        {
+            std::ifstream in(file_name);
+            if (!in.is_open())
+            {
+                return;
+            }
+
+            // Skip the header
+            std::string line;
+            std::getline(in, line);
+            while (std::getline(in, line))
+            {
+                std::vector<std::string> values = util::FileIO::split(line, ';');
+                if (values.size() != 3)
+                {
+                    throw "Invalid baseline file: " + file_name;
+                }
+
+                Baseline& entry = baseline[values[0]];
+                entry.min_ns = std::stoll(values[1]);
+                entry.peak_rss_bytes = std::stoul(values[2]);
+            }
+        }
+
+        void WriteBaseline(const std::map<std::string, Baseline>& baseline,
+                           const std::string& file_name)
+        {
+            std::ofstream out(file_name);
+            if (!out.is_open())
+            {
+                throw "Unable to open file: " + file_name;
+            }
+
+            out << "name;min_ns;peak_rss_bytes\n";
+            for (auto& entry : baseline)
+            {
+                out << entry.first << ";" << entry.second.min_ns << ";"
+                    << entry.second.peak_rss_bytes << "\n";
+            }
+        }
+
+        /**
+         * Runs the case the given number of times, every run has to create
+         * the same tracks as the first one.
+         */
+        bool MeasureCase(const RegressionCase& regression_case, size_t repeat,
+                         std::vector<TrackRow>& rows, Baseline& measured, std::string& message)
+        {
+            std::vector<long long> times;
+            measured.peak_rss_bytes = 0;
+            for (size_t i = 0; i < std::max(repeat, (size_t) 1); ++i)
+            {
+                std::vector<core::TrackletPtr> tracks;
+                util::Memory::ResetPeakResidentSize();
+                times.push_back(RunCase(regression_case, tracks));
+                measured.peak_rss_bytes = std::max(measured.peak_rss_bytes,
+                                                   util::Memory::GetPeakResidentSize());
+
+                std::vector<TrackRow> run_rows;
+                CreateRows(tracks, run_rows);
+                if (i == 0)
+                {
+                    rows = run_rows;
+                }
+                else if (!CompareRows(rows, run_rows, 0.0, message))
+                {
+                    message = "nondeterministic, run " + std::to_string(i) + ": " + message;
+                    return false;
+                }
+            }
+
+            // The fastest run is the least disturbed by other processes
+            measured.min_ns = *std::min_element(times.begin(), times.end());
+            return true;
+        }
+
+        std::string FormatChange(double value, double baseline)
+        {
+            char change[32];
+            snprintf(change, sizeof(change), "%+.1f%%",
+                     baseline > 0.0 ? (value / baseline - 1.0) * 100.0 : 0.0);
+            return change;
+        }
+    }
+
+    void CreateRegressionCases(std::vector<RegressionCase>& cases)
+    {
+        // name, algorithm, format, motion, objects, frames, false positives,
+        // position noise, seed
+        cases.push_back({ "nstage_2D", "n-stage", "2D", "linear", 8, 100, 4.0, 0.0, 1 });
+        cases.push_back({ "nstage_box_random_walk", "n-stage", "Box", "random-walk",
+                          8, 100, 4.0, 0.002, 2 });
+        cases.push_back({ "nstage_angular", "n-stage", "Angular", "linear",
+                          8, 100, 4.0, 0.001, 3 });
+        cases.push_back({ "nstage_crowded", "n-stage", "2D", "random-walk",
+                          20, 60, 10.0, 0.002, 4 });
+        cases.push_back({ "berclaz_2D", "berclaz", "2D", "linear", 8, 100, 4.0, 0.0, 1 });
+        cases.push_back({ "berclaz_box_random_walk", "berclaz", "Box", "random-walk",
+                          8, 100, 4.0, 0.002, 2 });
+    }
+
+    void RecordRegression(const std::vector<RegressionCase>& cases,
+                          const RegressionOptions& options, bool write_tracks,
+                          std::ostream& report)
+    {
+        mkdir(options.golden_path.c_str(), 0755);
+
+        // Keep the baseline of the cases not run
+        std::map<std::string, Baseline> baseline;
+        std::string baseline_file = options.golden_path + "/" + BASELINE_FILE;
+        ReadBaseline(baseline, baseline_file);
+
+        for (auto& regression_case : cases)
+        {
+            if (regression_case.name.find(options.filter) == std::string::npos) continue;
+
+            std::vector<TrackRow> rows;
+            Baseline measured;
+            std::string message;
+            if (!MeasureCase(regression_case, options.repeat, rows, measured, message))
+            {
+                throw regression_case.name + " " + message;
+            }
+
+            if (write_tracks)
+            {
+                WriteRows(rows, GetTrackFile(options.golden_path, regression_case.name));
+            }
+            baseline[regression_case.name] = measured;
+
+            report << "RECORDED " << regression_case.name
+                   << " objects " << rows.size()
+                   << " time " << measured.min_ns / 1000000.0 << " ms"
+                   << " peak rss " << measured.peak_rss_bytes / 1048576.0 << " MB"
+                   << std::endl;
+        }
+
+        WriteBaseline(baseline, baseline_file);
+    }
+
+    bool CheckRegression(const std::vector<RegressionCase>& cases,
+                         const RegressionOptions& options, std::ostream& report)
+    {
+        std::map<std::string, Baseline> baseline;
+        ReadBaseline(baseline, options.golden_path + "/" + BASELINE_FILE);
+
+        bool passed = true;
+        for (auto& regression_case : cases)
+        {
+            if (regression_case.name.find(options.filter) == std::string::npos) continue;
+
+            std::vector<std::string> failures;
+
+            std::vector<TrackRow> rows;
+            Baseline measured;
+            std::string message;
+            if (!MeasureCase(regression_case, options.repeat, rows, measured, message))
+            {
+                failures.push_back(message);
+            }
+
+            // Compare the tracks
+            std::vector<TrackRow> expected;
+            try
+            {
+                ReadRows(expected, GetTrackFile(options.golden_path, regression_case.name));
+                if (!CompareRows(expected, rows, options.tolerance, message))
+                {
+                    failures.push_back("tracks changed, " + message);
+                }
+            }
+            catch (std::string& e)
+            {
+                failures.push_back("no golden tracks, " + e);
+            }
+
+            // Compare the time and memory, the baseline depends on the machine
+            // and is thus optional
+            std::string change;
+            auto entry = baseline.find(regression_case.name);
+            if (entry == baseline.end())
+            {
+                change = " (no baseline)";
+            }
+            else
+            {
+                const Baseline& expected_values = entry->second;
+                if (measured.min_ns > expected_values.min_ns * (1.0 + options.max_slowdown))
+                {
+                    failures.push_back("slower than baseline");
+                }
+                if (measured.peak_rss_bytes >
+                    expected_values.peak_rss_bytes * (1.0 + options.max_memory_growth))
+                {
+                    failures.push_back("more memory than baseline");
+                }
+
+                change = " (" + FormatChange(measured.min_ns, expected_values.min_ns) +
+                         ", " + FormatChange(measured.peak_rss_bytes,
+                                             expected_values.peak_rss_bytes) + ")";
+            }
+
+            report << (failures.empty() ? "PASS " : "FAIL ") << regression_case.name
+                   << " objects " << rows.size()
+                   << " time " << measured.min_ns / 1000000.0 << " ms"
+                   << " peak rss " << measured.peak_rss_bytes / 1048576.0 << " MB"
+                   << change << std::endl;
+            for (auto& failure : failures)
+            {
+                report << "  " << failure << std::endl;
+            }
+
+            passed = passed && failures.empty();
+        }
+
+        return passed;
+    }
+}
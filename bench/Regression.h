@@ -0,0 +1,117 @@
+#ifndef GBMOT_REGRESSION_H
+#define GBMOT_REGRESSION_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../core/Tracklet.h"
+
+namespace bench
+{
+    /**
+     * A tracker run on a fixed synthetic sequence.
+     * The seeds are part of the case, thus the sequence never changes.
+     */
+    struct RegressionCase
+    {
+        std::string name;
+
+        /**
+         * The tracker to run, n-stage or berclaz
+         */
+        std::string algorithm;
+
+        /**
+         * The object model of the sequence, 2D, Box or Angular
+         */
+        std::string input_format;
+
+        /**
+         * The settings of the generated sequence
+         */
+        std::string motion_model;
+        size_t object_count;
+        size_t frame_count;
+        double false_positive_rate;
+        double position_noise;
+        unsigned int seed;
+    };
+
+    /**
+     * The settings of a regression run.
+     */
+    struct RegressionOptions
+    {
+        /**
+         * The folder containing the golden tracks and the baseline
+         */
+        std::string golden_path;
+
+        /**
+         * The only cases to run are the ones with names containing this string
+         */
+        std::string filter;
+
+        /**
+         * The number of measured runs of every case
+         */
+        size_t repeat;
+
+        /**
+         * The maximum absolute difference of the track values
+         */
+        double tolerance;
+
+        /**
+         * The maximum relative increase of the fastest run, e.g. 0.2 for 20%
+         */
+        double max_slowdown;
+
+        /**
+         * The maximum relative increase of the peak resident set size
+         */
+        double max_memory_growth;
+    };
+
+    /**
+     * Creates the fixed regression cases for NStage and Berclaz.
+     *
+     * @param cases The vector to add the cases to
+     */
+    void CreateRegressionCases(std::vector<RegressionCase>& cases);
+
+    /**
+     * Runs all cases and stores their tracks as golden outputs and the time
+     * of their fastest run and their peak resident set size as baseline.
+     * The tracks are stored as <golden_path>/<name>.tracks.csv, the
+     * baseline as <golden_path>/baseline.csv. The tracks do not depend on
+     * the machine or the standard library, the detections are generated
+     * with util::Random. The baseline does and is only valid on the machine
+     * it was recorded on.
+     *
+     * @param cases The cases to run
+     * @param options The settings of the run
+     * @param write_tracks True, to store the tracks, false to only store the
+     *                     baseline
+     * @param report The stream to write the progress into
+     */
+    void RecordRegression(const std::vector<RegressionCase>& cases,
+                          const RegressionOptions& options, bool write_tracks,
+                          std::ostream& report);
+
+    /**
+     * Runs all cases and compares their tracks with the golden outputs and
+     * their time and memory with the baseline, if one was recorded.
+     *
+     * @param cases The cases to run
+     * @param options The settings of the run
+     * @param report The stream to write the result of every case into
+     * @return True, if all cases match the golden outputs and stay within
+     *         the thresholds
+     */
+    bool CheckRegression(const std::vector<RegressionCase>& cases,
+                         const RegressionOptions& options, std::ostream& report);
+}
+
+
+#endif //GBMOT_REGRESSION_H
@@ -0,0 +1,175 @@
+#include "Benchmarks.h"
+#include "Regression.h"
+#include "../util/Logger.h"
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
+
+void RunRegression(const std::string& mode, const bench::RegressionOptions& options)
+{
+    std::vector<bench::RegressionCase> cases;
+    bench::CreateRegressionCases(cases);
+
+    try
+    {
+        if (mode == "record" || mode == "baseline")
+        {
+            bench::RecordRegression(cases, options, mode == "record", std::cout);
+        }
+        else if (mode == "check")
+        {
+            if (!bench::CheckRegression(cases, options, std::cout))
+            {
+                util::Logger::LogError("Regression check failed");
+                exit(1);
+            }
+        }
+        else
+        {
+            util::Logger::LogError("Unknown regression mode: " + mode);
+            exit(1);
+        }
+    }
+    catch (std::string& e)
+    {
+        util::Logger::LogError(e);
+        exit(1);
+    }
+}
+
+void Run(int argc, char** argv)
+{
+    std::string filter, output_file, regression, golden_path;
+    size_t repeat_count, warmup_count, max_detection_count;
+    unsigned int seed;
+    double tolerance, max_slowdown, max_memory_growth;
+
+    boost::program_options::options_description opts("Allowed options");
+    opts.add_options()
+            ("help",
+             "produce help message")
+            ("list",
+             "list the benchmarks without running them")
+            ("filter",
+             boost::program_options::value<std::string>(&filter)
+                    ->default_value(""),
+             "only run the benchmarks with names containing this string")
+            ("repeat",
+             boost::program_options::value<size_t>(&repeat_count)
+                    ->default_value(10),
+             "the number of measured runs of every benchmark")
+            ("warmup",
+             boost::program_options::value<size_t>(&warmup_count)
+                    ->default_value(1),
+             "the number of runs of every benchmark before measuring")
+            ("seed",
+             boost::program_options::value<unsigned int>(&seed)
+                    ->default_value(42),
+             "the seed of all random inputs, equal seeds create equal inputs")
+            ("max-detections",
+             boost::program_options::value<size_t>(&max_detection_count)
+                    ->default_value(10000),
+             "the maximum number of detections of the scaling benchmarks, 10000000 for the full sweep")
+            ("output",
+             boost::program_options::value<std::string>(&output_file)
+                    ->default_value(""),
+             "the JSON file to write the results into, empty to write to stdout")
+            ("regression",
+             boost::program_options::value<std::string>(&regression)
+                    ->default_value(""),
+             "runs the regression cases instead of the benchmarks, "
+             "record to store the golden tracks and the baseline, "
+             "baseline to only store the time and memory of this machine, "
+             "check to compare against them (exits with 1 on any failure)")
+            ("golden-path",
+             boost::program_options::value<std::string>(&golden_path)
+                    ->default_value("bench/golden"),
+             "the folder containing the golden tracks and the baseline")
+            ("tolerance",
+             boost::program_options::value<double>(&tolerance)
+                    ->default_value(1e-9),
+             "the maximum absolute difference of the track values to the golden tracks")
+            ("max-slowdown",
+             boost::program_options::value<double>(&max_slowdown)
+                    ->default_value(0.2),
+             "the maximum relative increase of the time of the fastest run, e.g. 0.2 for 20%")
+            ("max-memory-growth",
+             boost::program_options::value<double>(&max_memory_growth)
+                    ->default_value(0.25),
+             "the maximum relative increase of the peak resident set size");
+
+    boost::program_options::variables_map opt_var_map;
+    boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, opts),
+            opt_var_map);
+    boost::program_options::notify(opt_var_map);
+
+    if (opt_var_map.count("help") != 0)
+    {
+        std::cout << opts << std::endl;
+        exit(0);
+    }
+
+    if (!regression.empty())
+    {
+        RunRegression(regression, { golden_path, filter, repeat_count, tolerance,
+                                    max_slowdown, max_memory_growth });
+        return;
+    }
+
+    std::vector<bench::BenchmarkCase> cases;
+    bench::CreateBenchmarks(cases, seed, max_detection_count);
+
+    std::vector<bench::BenchmarkCase> selected;
+    for (auto& benchmark : cases)
+    {
+        if (benchmark.name.find(filter) != std::string::npos)
+        {
+            selected.push_back(benchmark);
+        }
+    }
+
+    if (opt_var_map.count("list") != 0)
+    {
+        for (auto& benchmark : selected)
+        {
+            std::cout << benchmark.name << std::endl;
+        }
+        exit(0);
+    }
+
+    // Run the benchmarks one after another, progress goes to stderr to keep
+    // stdout clean for the results
+    std::vector<bench::BenchmarkResult> results;
+    for (auto& benchmark : selected)
+    {
+        bench::BenchmarkResult result = bench::Measure(benchmark, warmup_count, repeat_count);
+        std::cerr << benchmark.name
+                  << " median " << result.median / 1000000.0 << " ms"
+                  << " stddev " << result.stddev / 1000000.0 << " ms"
+                  << " peak rss " << result.peak_rss_bytes / 1048576.0 << " MB" << std::endl;
+        results.push_back(result);
+    }
+
+    if (output_file.empty())
+    {
+        bench::WriteJSON(std::cout, results, warmup_count, seed);
+    }
+    else
+    {
+        std::ofstream out(output_file);
+        if (!out.is_open())
+        {
+            util::Logger::LogError("Failed to open result file " + output_file);
+            exit(1);
+        }
+        bench::WriteJSON(out, results, warmup_count, seed);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Run(argc, argv);
+
+    return 0;
+}
@@ -2,28 +2,58 @@
 // Created by wrede on 19.04.16.
 //
 
+#include <algorithm>
 #include "DetectionSequence.h"
+#include "../util/Logger.h"
 
 namespace core
 {
     DetectionSequence::DetectionSequence(const std::string& name)
     {
         name_ = name;
-        objects_ = std::vector<std::vector<ObjectDataPtr>>();
+        objects_ = std::deque<std::vector<ObjectDataPtr>>();
+        frame_offset_ = 0;
     }
 
     void DetectionSequence::AddObject(ObjectDataPtr object_data)
     {
-        while (object_data->GetFrameIndex() >= objects_.size())
+        if (object_data->GetFrameIndex() < frame_offset_)
         {
-            objects_.push_back(std::vector<ObjectDataPtr>());
+            util::Logger::LogError("Object added to released frame "
+                                   + std::to_string(object_data->GetFrameIndex()));
+            return;
         }
-        objects_[object_data->GetFrameIndex()].push_back(object_data);
+
+        ExtendFrameCount(object_data->GetFrameIndex() + 1);
+        objects_[object_data->GetFrameIndex() - frame_offset_].push_back(object_data);
     }
 
     void DetectionSequence::Clear()
     {
         objects_.clear();
+        frame_offset_ = 0;
+    }
+
+    void DetectionSequence::ExtendFrameCount(size_t frame_count)
+    {
+        while (frame_count > GetFrameCount())
+        {
+            objects_.push_back(std::vector<ObjectDataPtr>());
+        }
+    }
+
+    void DetectionSequence::ReleaseFrames(size_t frame_index)
+    {
+        if (frame_index <= frame_offset_) return;
+
+        size_t count = std::min(frame_index - frame_offset_, objects_.size());
+        objects_.erase(objects_.begin(), objects_.begin() + count);
+        frame_offset_ = frame_index;
+    }
+
+    size_t DetectionSequence::GetFirstFrameIndex() const
+    {
+        return frame_offset_;
     }
 
     std::string DetectionSequence::GetName() const
@@ -34,24 +64,29 @@ namespace core
     ObjectDataPtr DetectionSequence::GetObject
             (size_t frame_index, size_t object_index) const
     {
-        return objects_[frame_index][object_index];
+        return objects_[frame_index - frame_offset_][object_index];
     }
 
     size_t DetectionSequence::GetFrameCount() const
     {
-        return objects_.size();
+        return frame_offset_ + objects_.size();
     }
 
     size_t DetectionSequence::GetObjectCount(size_t frame_index) const
     {
-        return objects_[frame_index].size();
+        if (frame_index < frame_offset_)
+        {
+            return 0;
+        }
+
+        return objects_[frame_index - frame_offset_].size();
     }
 
     std::ostream& operator<<(std::ostream& os, const DetectionSequence& obj)
     {
         for (size_t frame = 0; frame < obj.objects_.size(); ++frame)
         {
-            os << "Frame: " << frame << std::endl;
+            os << "Frame: " << (frame + obj.frame_offset_) << std::endl;
 
             for (auto obj_in_frame : obj.objects_[frame])
             {
@@ -7,6 +7,7 @@
 
 
 #include <string>
+#include <deque>
 #include "ObjectData.h"
 
 namespace core
@@ -25,10 +26,15 @@ namespace core
 
         /**
          * Two dimensional vector of pointers to all detected objects.
-         * The first dimension is the frame.
+         * The first dimension is the frame (shifted by the frame offset).
          * The second dimension is the object in that frame.
          */
-        std::vector<std::vector<ObjectDataPtr>> objects_;
+        std::deque<std::vector<ObjectDataPtr>> objects_;
+
+        /**
+         * The index of the first frame that is not released
+         */
+        size_t frame_offset_;
     public:
         /**
          * Creates a detection sequence with the given name.
@@ -48,6 +54,29 @@ namespace core
          */
         void Clear();
 
+        /**
+         * Appends empty frames until the sequence has the given frame count.
+         *
+         * @param frame_count The minimal frame count
+         */
+        void ExtendFrameCount(size_t frame_count);
+
+        /**
+         * Releases all frames before the given frame index.
+         * The frame indices of the remaining frames are not changed, released
+         * frames contain no objects.
+         *
+         * @param frame_index The first frame to keep
+         */
+        void ReleaseFrames(size_t frame_index);
+
+        /**
+         * Gets the index of the first frame that is not released.
+         *
+         * @return The first frame index
+         */
+        size_t GetFirstFrameIndex() const;
+
         /**
          * Gets the name of this sequence.
          * @return The name
@@ -63,7 +92,7 @@ namespace core
         ObjectDataPtr GetObject(size_t frame_index, size_t object_index) const;
 
         /**
-         * Gets the frame count.
+         * Gets the frame count, including released frames.
          * @return The frame count
          */
         size_t GetFrameCount() const;
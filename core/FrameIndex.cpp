@@ -0,0 +1,69 @@
+#include "FrameIndex.h"
+
+namespace core
+{
+    FrameIndex::FrameIndex(const std::vector<TrackletPtr>& tracks)
+    {
+        first_frame_ = 0;
+
+        // Get the frame range
+        bool empty = true;
+        size_t last_frame = 0;
+        for (auto track : tracks)
+        {
+            if (track->GetPathObjectCount() == 0) continue;
+
+            if (empty || track->GetFirstFrameIndex() < first_frame_)
+                first_frame_ = track->GetFirstFrameIndex();
+            if (empty || track->GetLastFrameIndex() > last_frame)
+                last_frame = track->GetLastFrameIndex();
+            empty = false;
+        }
+
+        if (empty) return;
+
+        // Invert the tracks, the entries of every frame are sorted by track
+        // because the tracks are visited in order
+        frames_.resize(last_frame - first_frame_ + 1);
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            for (size_t j = 0; j < tracks[i]->GetPathObjectCount(); ++j)
+            {
+                ObjectDataPtr obj = tracks[i]->GetPathObject(j);
+                frames_[obj->GetFrameIndex() - first_frame_].push_back(FrameEntry{ i, obj });
+            }
+        }
+    }
+
+    size_t FrameIndex::GetFirstFrameIndex() const
+    {
+        return first_frame_;
+    }
+
+    size_t FrameIndex::GetEndFrameIndex() const
+    {
+        return first_frame_ + frames_.size();
+    }
+
+    const std::vector<FrameEntry>& FrameIndex::GetFrame(size_t frame) const
+    {
+        static const std::vector<FrameEntry> empty_frame;
+
+        if (frame < first_frame_ || frame >= GetEndFrameIndex())
+        {
+            return empty_frame;
+        }
+
+        return frames_[frame - first_frame_];
+    }
+
+    size_t FrameIndex::GetEntryCount() const
+    {
+        size_t count = 0;
+        for (auto& frame : frames_)
+        {
+            count += frame.size();
+        }
+        return count;
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef GBMOT_FRAMEINDEX_H
+#define GBMOT_FRAMEINDEX_H
+
+#include <vector>
+#include "ObjectData.h"
+#include "Tracklet.h"
+
+namespace core
+{
+    /**
+     * An object of a track in a single frame.
+     */
+    struct FrameEntry
+    {
+        /**
+         * The index of the track in the indexed track vector
+         */
+        size_t track;
+
+        /**
+         * The object of the track in the frame
+         */
+        ObjectDataPtr object;
+    };
+
+    /**
+     * Class for looking up the objects of multiple tracks frame by frame.
+     * The tracks are inverted into one entry list per frame once, thus the
+     * objects of a frame can be found without scanning every track.
+     */
+    class FrameIndex
+    {
+    private:
+        /**
+         * The lowest frame index of all tracks
+         */
+        size_t first_frame_;
+
+        /**
+         * The entries, the first dimension is the frame (shifted by the first
+         * frame), the second the entry in that frame sorted by track index.
+         */
+        std::vector<std::vector<FrameEntry>> frames_;
+    public:
+        /**
+         * Creates the index for the given tracks.
+         *
+         * @param tracks The tracks to index
+         */
+        FrameIndex(const std::vector<TrackletPtr>& tracks);
+
+        /**
+         * Gets the lowest frame index of all tracks.
+         *
+         * @return The first frame index
+         */
+        size_t GetFirstFrameIndex() const;
+
+        /**
+         * Gets the frame index after the highest frame index of all tracks.
+         *
+         * @return The last frame index plus one, or the first frame index if
+         *         no track contains any object
+         */
+        size_t GetEndFrameIndex() const;
+
+        /**
+         * Gets the entries of the specified frame.
+         *
+         * @param frame The frame index
+         * @return The entries sorted by track index, empty if the frame is
+         *         outside of the indexed range
+         */
+        const std::vector<FrameEntry>& GetFrame(size_t frame) const;
+
+        /**
+         * Gets the number of entries in all frames.
+         *
+         * @return The entry count
+         */
+        size_t GetEntryCount() const;
+    };
+}
+
+
+#endif //GBMOT_FRAMEINDEX_H
@@ -20,11 +20,6 @@ namespace core
         /* EMPTY */
     }
 
-    std::size_t ObjectData::GetFrameIndex() const
-    {
-        return frame_index_;
-    }
-
     bool ObjectData::IsVirtual() const
     {
         return is_virtual_;
@@ -126,6 +126,11 @@ namespace core
          */
         friend std::ostream& operator<<(std::ostream& os, const ObjectData& obj);
     };
+
+    inline std::size_t ObjectData::GetFrameIndex() const
+    {
+        return frame_index_;
+    }
 }
 
 
@@ -25,29 +25,9 @@ namespace core
         spatial_weight_ = weight;
     }
 
-    cv::Point2d ObjectData2D::GetPosition() const
-    {
-        return position_;
-    }
-
-    double ObjectData2D::GetTemporalWeight() const
-    {
-        return temporal_weight_;
-    }
-
-    double ObjectData2D::GetSpatialWeight() const
-    {
-        return spatial_weight_;
-    }
-
     double ObjectData2D::CompareTo(ObjectDataPtr obj) const
     {
-        ObjectData2DPtr obj_2d = std::static_pointer_cast<ObjectData2D>(obj);
-
-        double d_temp = obj_2d->GetFrameIndex() - GetFrameIndex();
-        double d_spat = util::MyMath::EuclideanDistance(position_, obj_2d->position_);
-
-        return d_temp * temporal_weight_ + d_spat * spatial_weight_;
+        return Compare(static_cast<const ObjectData2D&>(*obj));
     }
 
     ObjectDataPtr ObjectData2D::Interpolate(ObjectDataPtr obj,
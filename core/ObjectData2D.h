@@ -5,6 +5,7 @@
 #ifndef GBMOT_OBJECTDATA2D_H
 #define GBMOT_OBJECTDATA2D_H
 
+#include <cmath>
 #include "ObjectData.h"
 
 namespace core
@@ -74,11 +75,44 @@ namespace core
          */
         double GetSpatialWeight() const;
 
+        /**
+         * Compares this object with the given object of the same type without
+         * dynamic dispatch, the result equals the result of CompareTo.
+         * @param obj The object to compare with
+         * @return The weighted sum of the temporal and the spatial distance
+         */
+        double Compare(const ObjectData2D& obj) const;
+
         virtual double CompareTo(ObjectDataPtr obj) const override;
         virtual ObjectDataPtr Interpolate(ObjectDataPtr obj,
                                           double fraction) const override;
         virtual void Visualize(cv::Mat& image, cv::Scalar& color) const override;
     };
+
+    inline cv::Point2d ObjectData2D::GetPosition() const
+    {
+        return position_;
+    }
+
+    inline double ObjectData2D::GetTemporalWeight() const
+    {
+        return temporal_weight_;
+    }
+
+    inline double ObjectData2D::GetSpatialWeight() const
+    {
+        return spatial_weight_;
+    }
+
+    inline double ObjectData2D::Compare(const ObjectData2D& obj) const
+    {
+        double d_temp = obj.GetFrameIndex() - GetFrameIndex();
+        double dx = obj.position_.x - position_.x;
+        double dy = obj.position_.y - position_.y;
+        double d_spat = std::sqrt(dx * dx + dy * dy);
+
+        return d_temp * temporal_weight_ + d_spat * spatial_weight_;
+    }
 }
 
 
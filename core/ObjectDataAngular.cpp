@@ -47,12 +47,7 @@ namespace core
 
     double ObjectDataAngular::CompareTo(ObjectDataPtr obj) const
     {
-        ObjectDataAngularPtr obj_ang =
-                std::static_pointer_cast<ObjectDataAngular>(obj);
-
-        double d_ang = std::abs(obj_ang->angle_ - angle_);
-
-        return ObjectData2D::CompareTo(obj) + d_ang * angular_weight_;
+        return Compare(static_cast<const ObjectDataAngular&>(*obj));
     }
 
     ObjectDataPtr ObjectDataAngular::Interpolate(ObjectDataPtr obj,
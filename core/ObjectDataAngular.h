@@ -72,10 +72,25 @@ namespace core
          */
         double GetAngularWeight() const;
 
+        /**
+         * Compares this object with the given object of the same type without
+         * dynamic dispatch, the result equals the result of CompareTo.
+         * @param obj The object to compare with
+         * @return The weighted sum of the temporal, spatial and angular distance
+         */
+        double Compare(const ObjectDataAngular& obj) const;
+
         virtual double CompareTo(ObjectDataPtr obj) const override;
         virtual ObjectDataPtr Interpolate(ObjectDataPtr obj, double fraction) const override;
         virtual void Visualize(cv::Mat& image, cv::Scalar& color) const override;
     };
+
+    inline double ObjectDataAngular::Compare(const ObjectDataAngular& obj) const
+    {
+        double d_ang = std::abs(obj.angle_ - angle_);
+
+        return ObjectData2D::Compare(obj) + d_ang * angular_weight_;
+    }
 }
 
 
@@ -27,16 +27,7 @@ namespace core
 
     double ObjectDataBox::CompareTo(ObjectDataPtr obj) const
     {
-        ObjectDataBoxPtr other = std::static_pointer_cast<ObjectDataBox>(obj);
-
-        cv::Point2d this_center = GetPosition() + size_ * 0.5;
-        cv::Point2d other_center = other->GetPosition() + other->size_ * 0.5;
-
-        double d_temp = other->GetFrameIndex() - GetFrameIndex();
-        double d_spat = util::MyMath::EuclideanDistance(this_center,
-                                                        other_center);
-
-        return d_temp * GetTemporalWeight() + d_spat * GetSpatialWeight();
+        return Compare(static_cast<const ObjectDataBox&>(*obj));
     }
 
     ObjectDataPtr ObjectDataBox::Interpolate(ObjectDataPtr obj,
@@ -41,11 +41,33 @@ namespace core
          */
         cv::Point2d GetSize() const;
 
+        /**
+         * Compares the centers of this and the given bounding box without
+         * dynamic dispatch, the result equals the result of CompareTo.
+         *
+         * @param obj The bounding box to compare with
+         * @return The weighted sum of the temporal and the spatial distance
+         */
+        double Compare(const ObjectDataBox& obj) const;
+
         virtual double CompareTo(ObjectDataPtr obj) const override;
         virtual ObjectDataPtr Interpolate(ObjectDataPtr obj,
                                           double fraction) const override;
         virtual void Visualize(cv::Mat& image, cv::Scalar& color) const override;
     };
+
+    inline double ObjectDataBox::Compare(const ObjectDataBox& obj) const
+    {
+        cv::Point2d this_center = GetPosition() + size_ * 0.5;
+        cv::Point2d other_center = obj.GetPosition() + obj.size_ * 0.5;
+
+        double d_temp = obj.GetFrameIndex() - GetFrameIndex();
+        double dx = other_center.x - this_center.x;
+        double dy = other_center.y - this_center.y;
+        double d_spat = std::sqrt(dx * dx + dy * dy);
+
+        return d_temp * GetTemporalWeight() + d_spat * GetSpatialWeight();
+    }
 }
 
 
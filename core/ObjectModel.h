@@ -0,0 +1,41 @@
+#ifndef GBMOT_OBJECTMODEL_H
+#define GBMOT_OBJECTMODEL_H
+
+#include "ObjectData2D.h"
+#include "ObjectDataBox.h"
+#include "ObjectDataAngular.h"
+
+namespace core
+{
+    /**
+     * Object model policy for the algorithms templated on the type of the
+     * detected objects. The comparison is resolved at compile time, thus it
+     * can be inlined into the loops creating the graph edges.
+     * Every object compared by the model needs to be of the given type.
+     */
+    template<typename Object>
+    struct ObjectModel
+    {
+        typedef Object ObjectType;
+
+        /**
+         * Compares the first with the second object, the result equals the
+         * result of first.CompareTo(second).
+         * @param first The object to compare
+         * @param second The object to compare with
+         * @return The comparison value
+         */
+        static double Compare(const ObjectData& first, const ObjectData& second)
+        {
+            return static_cast<const Object&>(first).Compare(
+                    static_cast<const Object&>(second));
+        }
+    };
+
+    typedef ObjectModel<ObjectData2D> ObjectModel2D;
+    typedef ObjectModel<ObjectDataBox> ObjectModelBox;
+    typedef ObjectModel<ObjectDataAngular> ObjectModelAngular;
+}
+
+
+#endif //GBMOT_OBJECTMODEL_H
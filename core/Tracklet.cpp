@@ -75,6 +75,22 @@ namespace core
         }
     }
 
+    void Tracklet::SetPathObjects(std::vector<ObjectDataPtr>& objects)
+    {
+        path_objects_.swap(objects);
+
+        if (!path_objects_.empty())
+        {
+            SetFrameIndex(path_objects_.front()->GetFrameIndex());
+            last_frame_index_ = path_objects_.back()->GetFrameIndex();
+        }
+        else
+        {
+            SetFrameIndex(0);
+            last_frame_index_ = 0;
+        }
+    }
+
     ObjectDataPtr Tracklet::GetPathObject(size_t i)
     {
         return path_objects_[i];
@@ -50,6 +50,16 @@ namespace core
          */
         void AddPathObject(ObjectDataPtr obj, bool overwrite = false);
 
+        /**
+         * Replaces all path objects with the given objects at once.
+         * The objects need to be sorted ascending by their frame index, may not
+         * be virtual and only one object per frame is allowed.
+         * The given vector is swapped with the path, thus no object is copied.
+         * @param objects The new path objects, contains the old path objects
+         *                afterwards
+         */
+        void SetPathObjects(std::vector<ObjectDataPtr>& objects);
+
         /**
          * Gets the lowest frame index of all path objects.
          * @return The lowest frame index
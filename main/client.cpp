@@ -0,0 +1,131 @@
+#include "../algo/TrackingServer.h"
+#include "../util/Logger.h"
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+int Run(int argc, char** argv)
+{
+    std::string socket_path, input_file, output_file;
+    std::vector<std::string> parameter_lines;
+    bool info;
+
+    boost::program_options::options_description opts("Allowed options");
+    opts.add_options()
+            ("help",
+             "produce help message")
+            ("info",
+             boost::program_options::value<bool>(&info)
+                    ->default_value(false),
+             "if the program should show progress information")
+            ("socket",
+             boost::program_options::value<std::string>(&socket_path),
+             "the socket of the server started with GBMOT --serve")
+            ("input-file",
+             boost::program_options::value<std::string>(&input_file)
+                    ->default_value("-"),
+             "the CSV file with the detections to track, - reads the standard input")
+            ("output-file",
+             boost::program_options::value<std::string>(&output_file)
+                    ->default_value("-"),
+             "the file to write the tracks in the long format into, "
+             "- writes to the standard output")
+            ("parameter",
+             boost::program_options::value<std::vector<std::string>>(&parameter_lines)
+                    ->multitoken(),
+             "the settings of the request as option=value, e.g. input-format=Box, "
+             "settings not sent are taken from the command line of the server");
+
+    boost::program_options::variables_map opt_var_map;
+    boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, opts),
+            opt_var_map);
+    boost::program_options::notify(opt_var_map);
+
+    if (opt_var_map.count("help") != 0 || opt_var_map.count("socket") == 0)
+    {
+        std::cout << opts << std::endl;
+        exit(0);
+    }
+
+    // Keep the tracks written to the standard output free of messages
+    util::Logger::SetInfo(info);
+    util::Logger::SetErrorOutput(output_file == "-");
+
+    try
+    {
+        std::vector<std::pair<std::string, std::string>> parameters;
+        for (auto& line : parameter_lines)
+        {
+            size_t equals = line.find('=');
+            if (equals == std::string::npos)
+            {
+                throw "Invalid parameter: " + line;
+            }
+            parameters.push_back(std::make_pair(line.substr(0, equals),
+                                                line.substr(equals + 1)));
+        }
+
+        std::string detections;
+        if (input_file == "-")
+        {
+            detections.assign(std::istreambuf_iterator<char>(std::cin),
+                              std::istreambuf_iterator<char>());
+        }
+        else
+        {
+            std::ifstream in(input_file, std::ios::binary);
+            if (!in.is_open())
+            {
+                throw "Unable to open file: " + input_file;
+            }
+            detections.assign(std::istreambuf_iterator<char>(in),
+                              std::istreambuf_iterator<char>());
+        }
+
+        std::string response;
+        algo::TrackingServer::SendRequest(
+                socket_path, algo::TrackingServer::CreateRequest(parameters, detections),
+                response);
+
+        // The status line precedes the tracks
+        size_t status_end = response.find('\n');
+        std::string status = response.substr(0, status_end);
+        if (status.compare(0, 3, "OK ") != 0)
+        {
+            throw status.compare(0, 6, "ERROR ") == 0 ? status.substr(6) :
+                  "Invalid response: " + status;
+        }
+        GBMOT_LOG_INFO("Received " + status.substr(3) + " tracks");
+
+        size_t body = status_end == std::string::npos ? response.size() : status_end + 1;
+        if (output_file == "-")
+        {
+            std::cout.write(response.data() + body, response.size() - body);
+            std::cout.flush();
+        }
+        else
+        {
+            std::ofstream out(output_file, std::ios::binary);
+            if (!out.is_open())
+            {
+                throw "Unable to open file: " + output_file;
+            }
+            out.write(response.data() + body, response.size() - body);
+        }
+    }
+    catch (std::string& e)
+    {
+        util::Logger::LogError("Failed to track the detections!");
+        util::Logger::LogError(e);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    return Run(argc, argv);
+}
@@ -0,0 +1,152 @@
+#include "../util/Generator.h"
+#include "../util/Logger.h"
+#include <boost/program_options.hpp>
+#include <iostream>
+
+void Run(int argc, char** argv)
+{
+    std::string output_file, output_format, input_format, motion_model;
+    size_t object_count, frame_count;
+    unsigned int seed;
+    double speed, miss_rate, false_positive_rate, score_noise, position_noise;
+    double box_width, box_height, image_width, image_height;
+    char output_delimiter;
+    bool info, debug;
+
+    boost::program_options::options_description opts("Allowed options");
+    opts.add_options()
+            ("help",
+             "produce help message")
+            ("info",
+             boost::program_options::value<bool>(&info)
+                    ->default_value(false),
+             "if the program should show progress information")
+            ("debug",
+             boost::program_options::value<bool>(&debug)
+                    ->default_value(false),
+             "if the program should show debug messages")
+            ("output-file",
+             boost::program_options::value<std::string>(&output_file),
+             "the file to write the generated detections into")
+            ("output-format",
+             boost::program_options::value<std::string>(&output_format)
+                    ->default_value("csv"),
+             "the format of the output file, csv or binary, "
+             "the CSV file contains the columns frame;x;y;width;height;angle;score")
+            ("output-delimiter",
+             boost::program_options::value<char>(&output_delimiter)
+                    ->default_value(';'),
+             "the delimiter used to separate values in the CSV file")
+            ("input-format",
+             boost::program_options::value<std::string>(&input_format)
+                    ->default_value("2D"),
+             "the object model of the binary file, valid formats are: 2D, Box, Angular")
+            ("object-count",
+             boost::program_options::value<size_t>(&object_count)
+                    ->default_value(10),
+             "the number of objects moving through all frames")
+            ("frame-count",
+             boost::program_options::value<size_t>(&frame_count)
+                    ->default_value(100),
+             "the number of frames")
+            ("motion-model",
+             boost::program_options::value<std::string>(&motion_model)
+                    ->default_value("linear"),
+             "the motion of the objects, linear or random-walk")
+            ("speed",
+             boost::program_options::value<double>(&speed)
+                    ->default_value(0.01),
+             "the maximum normalized distance an object moves in one frame, not negative")
+            ("miss-rate",
+             boost::program_options::value<double>(&miss_rate)
+                    ->default_value(0.1),
+             "the probability of an object to be missed in a frame")
+            ("false-positive-rate",
+             boost::program_options::value<double>(&false_positive_rate)
+                    ->default_value(1.0),
+             "the mean number of false positives in every frame")
+            ("score-noise",
+             boost::program_options::value<double>(&score_noise)
+                    ->default_value(0.1),
+             "the standard deviation of the detection scores")
+            ("position-noise",
+             boost::program_options::value<double>(&position_noise)
+                    ->default_value(0.0),
+             "the normalized standard deviation of the detected positions")
+            ("box-width",
+             boost::program_options::value<double>(&box_width)
+                    ->default_value(0.05),
+             "the normalized width of every bounding box")
+            ("box-height",
+             boost::program_options::value<double>(&box_height)
+                    ->default_value(0.1),
+             "the normalized height of every bounding box")
+            ("image-width",
+             boost::program_options::value<double>(&image_width)
+                    ->default_value(1),
+             "the width of the image, the CSV positions are scaled by it")
+            ("image-height",
+             boost::program_options::value<double>(&image_height)
+                    ->default_value(1),
+             "the height of the image, the CSV positions are scaled by it")
+            ("seed",
+             boost::program_options::value<unsigned int>(&seed)
+                    ->default_value(42),
+             "the seed of all random values, equal seeds generate equal detections");
+
+    boost::program_options::variables_map opt_var_map;
+    boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, opts),
+            opt_var_map);
+    boost::program_options::notify(opt_var_map);
+
+    if (opt_var_map.count("help") != 0 || opt_var_map.count("output-file") == 0)
+    {
+        std::cout << opts << std::endl;
+        exit(0);
+    }
+
+    util::Logger::SetInfo(info);
+    util::Logger::SetDebug(debug);
+
+    try
+    {
+        util::Generator generator(object_count, frame_count, seed);
+        generator.SetMotionModel(motion_model, speed);
+        generator.SetMissRate(miss_rate);
+        generator.SetFalsePositiveRate(false_positive_rate);
+        generator.SetScoreNoise(score_noise);
+        generator.SetPositionNoise(position_noise);
+        generator.SetBoxSize(box_width, box_height);
+
+        GBMOT_LOG_INFO("expected detections "
+                       + std::to_string(generator.GetExpectedDetectionCount()));
+
+        if (output_format == "csv")
+        {
+            generator.WriteCSV(output_file, output_delimiter, image_width, image_height);
+        }
+        else if (output_format == "binary")
+        {
+            generator.WriteBinary(output_file, input_format);
+        }
+        else
+        {
+            util::Logger::LogError("Unknown output format: " + output_format);
+            exit(0);
+        }
+    }
+    catch (std::string& e)
+    {
+        util::Logger::LogError("Failed to generate detections!");
+        util::Logger::LogError(e);
+        exit(0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Run(argc, argv);
+
+    return 0;
+}
@@ -4,95 +4,46 @@
 #include "../core/DetectionSequence.h"
 #include "../util/FileIO.h"
 #include "../util/Parser.h"
-#include "../algo/NStage.h"
 #include "../util/Visualizer.h"
 #include "../util/Logger.h"
 #include "../core/ObjectDataAngular.h"
 #include "../algo/Berclaz.h"
-#include "../algo/KShortestPaths.h"
+#include "../util/DetectionStream.h"
+#include "../algo/OnlineTracker.h"
+#include "../util/Profiler.h"
+#include "../util/Memory.h"
+#include "../algo/ParameterSweep.h"
+#include "../algo/BatchRunner.h"
+#include "../algo/TrackingServer.h"
+#include "../util/Evaluator.h"
 #include <boost/program_options.hpp>
-#include <boost/graph/named_function_params.hpp>
-#include <boost/graph/bellman_ford_shortest_paths.hpp>
-#include <iomanip>
+#include <csignal>
+#include <memory>
 
-struct
-{
-    std::string max_frame_skip;
-    std::string max_tracklet_count;
-    std::string penalty_value;
-} n_stage_params;
-
-void RunNStage(core::DetectionSequence& sequence, std::vector<core::TrackletPtr>& tracks)
-{
-    util::Logger::LogInfo("Running n-stage");
-
-    std::vector<size_t> max_frame_skips;
-    std::vector<double> penalty_values;
-    std::vector<size_t> max_tracklet_counts;
-
-    // Parse strings to vectors
-    size_t d_index;
-    std::string str, part;
-    str = n_stage_params.max_frame_skip;
-    do
-    {
-        d_index = str.find(",");
-
-        part = str.substr(0, d_index);
-
-        if (part.size() > 0)
-        {
-            max_frame_skips.push_back((unsigned long&&) atoi(part.c_str()));
-        }
+// The folder to write the created graphs into, empty to not write them
+std::string graph_dump_path;
 
-        str = str.substr(d_index + 1);
-    }
-    while (d_index != std::string::npos);
-    str = n_stage_params.penalty_value;
-    do
-    {
-        d_index = str.find(",");
-
-        part = str.substr(0, d_index);
+// The file to write the performance report into, empty to not profile
+std::string profile_file;
 
-        if (part.size() > 0)
-        {
-            penalty_values.push_back(std::atof(part.c_str()));
-        }
+// The running server, stopped by SIGINT and SIGTERM
+algo::TrackingServer* server = nullptr;
 
-        str = str.substr(d_index + 1);
-    }
-    while (d_index != std::string::npos);
-    str = n_stage_params.max_tracklet_count;
-    do
-    {
-        d_index = str.find(",");
-
-        part = str.substr(0, d_index);
-
-        if (part.size() > 0)
-        {
-            max_tracklet_counts.push_back((unsigned long&&) atoi(part.c_str()));
-        }
-
-        str = str.substr(d_index + 1);
-    }
-    while (d_index != std::string::npos);
-
-    // Init n stage
-    algo::NStage n_stage(max_frame_skips, penalty_values, max_tracklet_counts);
-
-    n_stage.Run(sequence, tracks);
-
-    // Interpolate tracks
-    for (auto track : tracks)
+void StopServer(int)
+{
+    if (server != nullptr)
     {
-        track->InterpolateMissingFrames();
+        server->Stop();
     }
-
-    util::Logger::LogInfo("Finished");
 }
 
+struct
+{
+    std::string max_frame_skip;
+    std::string max_tracklet_count;
+    std::string penalty_value;
+} n_stage_params;
+
 struct
 {
     int h_res;
@@ -102,35 +53,42 @@ struct
     size_t max_track_count;
 } berclaz_params;
 
-void RunBerclaz(core::DetectionSequence& sequence, std::vector<core::TrackletPtr>& tracks)
+void RunBerclaz(const algo::TrackerParameters& parameters, util::DetectionStream& stream,
+                std::vector<core::TrackletPtr>& tracks)
 {
-    util::Logger::LogInfo("Running berclaz");
+    GBMOT_LOG_INFO("Running berclaz on the input stream");
 
     // Init berclaz
-    algo::Berclaz berclaz(berclaz_params.h_res,
-                          berclaz_params.v_res,
-                          berclaz_params.vicinity_size);
-    berclaz.Run(sequence, berclaz_params.batch_size,
-                berclaz_params.max_track_count, tracks);
+    algo::Berclaz berclaz(parameters.h_res, parameters.v_res, parameters.vicinity_size);
+    berclaz.SetGraphDumpPath(graph_dump_path);
+    berclaz.Run(stream, parameters.batch_size, parameters.max_track_count, tracks);
 
-    util::Logger::LogInfo("Interpolate tracks");
+    GBMOT_LOG_INFO("Interpolate tracks");
 
     // Interpolate tracks
+    util::ScopedTimer timer("interpolate");
     for (auto track : tracks)
     {
         track->InterpolateMissingFrames();
     }
 
-    util::Logger::LogInfo("Finished");
+    GBMOT_LOG_INFO("Finished");
 }
 
 void Run(int argc, char** argv)
 {
     // Algorithm independent values
     std::string input_file, output_path, images_folder, algorithm, config_path, header, input_format;
-    bool info, debug, display, output, output_images;
+    std::string convert_file, output_format, output_video, video_codec, log_file, sweep_file;
+    std::string batch_file, serve_socket;
+    std::string ground_truth_file, ground_truth_format, match_metric;
+    bool info, debug, display, output, output_images, stream, online, headless;
+    bool log_async, log_block;
     char input_delimiter, output_delimiter;
+    size_t input_threads, latency, log_buffer_size, sweep_threads, evaluation_threads;
+    size_t batch_threads, batch_in_flight, serve_threads, serve_max_request_size;
     double temporal_weight, spatial_weight, angular_weight, image_width, image_height;
+    double score_min, score_max, video_fps, match_threshold;
 
     boost::program_options::options_description opts("Allowed options");
     opts.add_options()
@@ -144,6 +102,25 @@ void Run(int argc, char** argv)
              boost::program_options::value<bool>(&debug)
                      ->default_value(false),
              "if the program should show debug messages")
+            ("profile",
+             boost::program_options::value<std::string>(&profile_file),
+             "the file to write the time spent in every stage into, written as JSON if "
+                     "the file ends with .json, otherwise as CSV")
+            ("log-file",
+             boost::program_options::value<std::string>(&log_file),
+             "the file to write the log messages to instead of the console")
+            ("log-async",
+             boost::program_options::value<bool>(&log_async)
+                     ->default_value(false),
+             "if the log messages should be written by a background thread")
+            ("log-buffer-size",
+             boost::program_options::value<size_t>(&log_buffer_size)
+                     ->default_value(4096),
+             "the maximal number of log messages buffered for the background thread")
+            ("log-block",
+             boost::program_options::value<bool>(&log_block)
+                     ->default_value(false),
+             "if logging should block while the log buffer is full, otherwise the messages are dropped")
             ("display",
              boost::program_options::value<bool>(&display)
                      ->default_value(false),
@@ -156,12 +133,32 @@ void Run(int argc, char** argv)
              boost::program_options::value<bool>(&output_images)
                      ->default_value(false),
              "if the images containing the visualized detections should be written to the output")
+            ("output-video",
+             boost::program_options::value<std::string>(&output_video),
+             "the path of a video file to write the visualized tracks into, "
+                     "the images are read from the images folder")
+            ("video-codec",
+             boost::program_options::value<std::string>(&video_codec)
+                     ->default_value("MJPG"),
+             "the four character code of the codec used for the output video")
+            ("video-fps",
+             boost::program_options::value<double>(&video_fps)
+                     ->default_value(24.0),
+             "the frame rate of the output video")
+            ("headless",
+             boost::program_options::value<bool>(&headless)
+                     ->default_value(false),
+             "if the output images and video should be written without opening a window")
             ("config",
              boost::program_options::value<std::string>(&config_path),
              "the path to the config file, if no path is given the command line arguments are read")
             ("input-file",
              boost::program_options::value<std::string>(&input_file),
              "set detections file path")
+            ("convert",
+             boost::program_options::value<std::string>(&convert_file),
+             "converts the input file into a binary detection file at the specified path and exits, "
+                     "binary detection files are detected automatically when used as input file")
             ("output-path",
              boost::program_options::value<std::string>(&output_path),
              "set the output file path")
@@ -169,6 +166,13 @@ void Run(int argc, char** argv)
              boost::program_options::value<char>(&output_delimiter)
                     ->default_value(';'),
              "the delimiter used to separate values in the specified output file")
+            ("output-format",
+             boost::program_options::value<std::string>(&output_format)
+                    ->default_value("wide"),
+             "the format of the track output file, valid formats are: "
+                     "wide (one line per frame with x and y of every track), "
+                     "long (one line per object with frame, id, x, y, width, height and score), "
+                     "binary (columnar track file tracks.gbt)")
             ("images-folder",
              boost::program_options::value<std::string>(&images_folder),
              "set images folder path")
@@ -185,6 +189,107 @@ void Run(int argc, char** argv)
              boost::program_options::value<char>(&input_delimiter)
                      ->default_value(';'),
              "the delimiter used to separate values in the specified input file")
+            ("input-threads",
+             boost::program_options::value<size_t>(&input_threads)
+                     ->default_value(1),
+             "the number of threads used to parse the input file, "
+                     "zero uses all available hardware threads")
+            ("stream",
+             boost::program_options::value<bool>(&stream)
+                     ->default_value(false),
+             "(berclaz) if the input file should be read batch by batch instead of at once, "
+                     "the input needs to be sorted by frame and the scores are normalized "
+                     "with the specified score range")
+            ("score-min",
+             boost::program_options::value<double>(&score_min)
+                     ->default_value(0.0),
+             "the detection score that is normalized to zero when streaming the input, "
+                     "lower scores are clamped")
+            ("score-max",
+             boost::program_options::value<double>(&score_max)
+                     ->default_value(1.0),
+             "the detection score that is normalized to one when streaming the input, "
+                     "higher scores are clamped")
+            ("dump-graphs",
+             boost::program_options::value<std::string>(&graph_dump_path),
+             "writes every graph created by the algorithm as a binary graph file into the specified "
+                     "folder, the graphs can be replayed with GBMOT_replay, not available online")
+            ("online",
+             boost::program_options::value<bool>(&online)
+                     ->default_value(false),
+             "if the input should be tracked online frame by frame, the input file can be a named pipe "
+                     "or - to read from stdin, the assignments of every finalized frame are written "
+                     "to stdout or to the output path")
+            ("latency",
+             boost::program_options::value<size_t>(&latency)
+                     ->default_value(10),
+             "(online) the number of frames read after a frame before its assignments are final")
+            ("sweep",
+             boost::program_options::value<std::string>(&sweep_file),
+             "runs the algorithm for every configuration of the parameter grid in the specified file "
+                     "and writes the tracks of every configuration into a numbered folder in the output "
+                     "path together with the summary sweep.csv, every line of the file contains an "
+                     "option name followed by its values, separated by the input delimiter")
+            ("sweep-threads",
+             boost::program_options::value<size_t>(&sweep_threads)
+                     ->default_value(0),
+             "(sweep) the number of configurations run in parallel, "
+                     "zero uses all available hardware threads")
+            ("batch",
+             boost::program_options::value<std::string>(&batch_file),
+             "runs the algorithm for every sequence in the specified manifest file instead of the "
+                     "input file, the first line of the manifest contains option names, every "
+                     "following line the values of one sequence, input-file and output-path are "
+                     "required, empty values use the command line values, the summary batch.csv "
+                     "is written into the output path")
+            ("batch-threads",
+             boost::program_options::value<size_t>(&batch_threads)
+                     ->default_value(0),
+             "(batch) the number of sequences run in parallel, "
+                     "zero uses all available hardware threads")
+            ("batch-in-flight",
+             boost::program_options::value<size_t>(&batch_in_flight)
+                     ->default_value(0),
+             "(batch) the maximum number of sequences queued or running at once, "
+                     "zero uses twice the number of threads")
+            ("serve",
+             boost::program_options::value<std::string>(&serve_socket),
+             "runs as a server listening on the Unix domain socket at the specified path, every "
+                     "connection sends option=value lines, an empty line and the detections and "
+                     "receives the tracks in the long format, the options not sent are taken from "
+                     "the command line, stopped by SIGINT or SIGTERM, see GBMOT_client")
+            ("serve-threads",
+             boost::program_options::value<size_t>(&serve_threads)
+                     ->default_value(0),
+             "(serve) the number of requests handled in parallel, "
+                     "zero uses all available hardware threads")
+            ("serve-max-request-size",
+             boost::program_options::value<size_t>(&serve_max_request_size)
+                     ->default_value(256),
+             "(serve) the maximum size of a request in megabytes, larger requests are rejected")
+            ("ground-truth",
+             boost::program_options::value<std::string>(&ground_truth_file),
+             "the ground truth tracks to evaluate the found tracks with, the CLEAR MOT and IDF1 "
+                     "metrics are written into evaluation.csv in the output path or to the console")
+            ("ground-truth-format",
+             boost::program_options::value<std::string>(&ground_truth_format)
+                     ->default_value("wide"),
+             "the format of the ground truth file, valid formats are: wide, long, binary, "
+                     "binary track files are detected automatically")
+            ("match-metric",
+             boost::program_options::value<std::string>(&match_metric)
+                     ->default_value("distance"),
+             "the metric to match the tracks with the ground truth, valid metrics are: "
+                     "distance (of the object positions), iou (intersection over union of the boxes)")
+            ("match-threshold",
+             boost::program_options::value<double>(&match_threshold),
+             "the maximum distance or the minimum intersection over union of a match, "
+                     "defaults to 0.05 for distance and 0.5 for iou")
+            ("evaluation-threads",
+             boost::program_options::value<size_t>(&evaluation_threads)
+                     ->default_value(0),
+             "the number of threads used to evaluate the tracks, "
+                     "zero uses all available hardware threads")
             ("image-width",
              boost::program_options::value<double>(&image_width)
                      ->default_value(1),
@@ -278,7 +383,8 @@ void Run(int argc, char** argv)
             exit(0);
         }
     }
-    else if (opt_var_map.count("input-file") == 0 ||
+    else if ((opt_var_map.count("input-file") == 0 && opt_var_map.count("batch") == 0 &&
+              opt_var_map.count("serve") == 0) ||
              opt_var_map.count("input-format") == 0 ||
                 (opt_var_map.count("output-path") == 0 && (output || output_images)))
     {
@@ -286,633 +392,561 @@ void Run(int argc, char** argv)
         exit(0);
     }
 
+    // Configure the log output
+    if (!log_file.empty())
+    {
+        try
+        {
+            util::Logger::SetFile(log_file);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError(e);
+            exit(0);
+        }
+    }
+    util::Logger::SetAsync(log_async, log_buffer_size, log_block);
+
+    // The online tracks are written to the standard output without an output path
+    util::Logger::SetErrorOutput(online && !output);
+
+    // Enable the stage timers
+    util::Profiler::SetEnabled(!profile_file.empty());
+
     // Enable info logging
     if (info != 0)
     {
         util::Logger::SetInfo(true);
-        util::Logger::LogInfo("Enabled");
+        GBMOT_LOG_INFO("Enabled");
     }
 
     // Enable debug logging
     if (debug != 0)
     {
         util::Logger::SetDebug(true);
-        util::Logger::LogDebug("Enabled");
-    }
+        GBMOT_LOG_DEBUG("Enabled");
+    }
+
+    // The settings of sequences and requests without their own values
+    algo::BatchSequence base;
+    base.input_header = header;
+    base.image_width = image_width;
+    base.image_height = image_height;
+    base.parameters.algorithm = algorithm;
+    base.parameters.input_format = input_format;
+    base.parameters.max_frame_skip = n_stage_params.max_frame_skip;
+    base.parameters.penalty_value = n_stage_params.penalty_value;
+    base.parameters.max_tracklet_count = n_stage_params.max_tracklet_count;
+    base.parameters.temporal_weight = temporal_weight;
+    base.parameters.spatial_weight = spatial_weight;
+    base.parameters.angular_weight = angular_weight;
+    base.parameters.h_res = berclaz_params.h_res;
+    base.parameters.v_res = berclaz_params.v_res;
+    base.parameters.vicinity_size = berclaz_params.vicinity_size;
+    base.parameters.batch_size = berclaz_params.batch_size;
+    base.parameters.max_track_count = berclaz_params.max_track_count;
+    base.cost = 0;
+
+    // Track the requests sent to the socket until stopped
+    if (!serve_socket.empty())
+    {
+        if (stream || online || !sweep_file.empty() || !batch_file.empty() ||
+            opt_var_map.count("convert") != 0)
+        {
+            util::Logger::LogError("The server can not be combined with streaming, "
+                                           "online tracking, sweeps, batches or conversion!");
+            exit(0);
+        }
 
-    // Reading the input file
-    util::Logger::LogInfo("Read input");
-    util::ValueMapVector values;
-    try
-    {
-        if (header.size() > 0)
+        algo::TrackingServer tracking_server(serve_socket, base, input_delimiter, serve_threads,
+                                             serve_max_request_size * 1024 * 1024);
+        server = &tracking_server;
+        std::signal(SIGINT, StopServer);
+        std::signal(SIGTERM, StopServer);
+        try
         {
-            util::FileIO::ReadCSV(values, header, input_file, input_delimiter);
+            tracking_server.Run();
         }
-        else
+        catch (std::string& e)
         {
-            util::FileIO::ReadCSV(values, input_file, input_delimiter);
+            util::Logger::LogError("Failed to run the server!");
+            util::Logger::LogError(e);
         }
-    }
-    catch (std::exception& e)
-    {
-        util::Logger::LogError("Failed to read input file!");
-        util::Logger::LogError(e.what());
-        exit(0);
-    }
-
-    // Parsing the read input
-    core::DetectionSequence sequence;
-    if (input_format == "2D")
-    {
-        util::Parser::ParseObjectData2D(values,
-                                        sequence,
-                                        image_width,
-                                        image_height,
-                                        temporal_weight,
-                                        spatial_weight);
-    }
-    else if (input_format == "Box")
-    {
-        util::Parser::ParseObjectDataBox(values,
-                                         sequence,
-                                         image_width,
-                                         image_height,
-                                         temporal_weight,
-                                         spatial_weight);
-    }
-    else if (input_format == "Angular")
-    {
-        util::Parser::ParseObjectDataAngular(values,
-                                             sequence,
-                                             image_width,
-                                             image_height,
-                                             temporal_weight,
-                                             spatial_weight,
-                                             angular_weight);
-    }
-    else
-    {
-        // No valid input-format specified
-        std::cout << opts << std::endl;
-        exit(0);
+        server = nullptr;
+        return;
     }
 
-    // Running the specified algorithm
-    std::vector<core::TrackletPtr> tracks;
-    time_t begin_time, end_time;
-    util::Logger::LogInfo("Start time measurement");
-    begin_time = time(0);
-    if (algorithm == "n-stage")
-    {
-        RunNStage(sequence, tracks);
-    }
-    else if (algorithm == "berclaz")
-    {
-        RunBerclaz(sequence, tracks);
-    }
-    else
+    // Run every sequence of the batch manifest, every sequence is read by its job
+    if (!batch_file.empty())
     {
-        // No valid algorithm specified
-        std::cout << opts << std::endl;
-        exit(0);
-    }
-
-    end_time = time(0);
-    util::Logger::LogInfo("Time measurement stopped");
-    util::Logger::LogInfo("Time passed: "
-                          + std::to_string(difftime(end_time, begin_time) / 60.0)
-                          + " minutes");
+        if (stream || online || !sweep_file.empty() || opt_var_map.count("convert") != 0)
+        {
+            util::Logger::LogError("The batch can not be combined with streaming, "
+                                           "online tracking, sweeps or conversion!");
+            exit(0);
+        }
 
-    // Write the output file
-    if (output)
-    {
-        util::FileIO::WriteTracks(tracks, output_path + "/tracks.csv", output_delimiter);
-    }
+        // The sequences already run in parallel, thus every file is read by one thread
+        algo::BatchFunction load = [&](const algo::BatchSequence& batch_sequence,
+                                       core::DetectionSequence& detections)
+        {
+            const algo::TrackerParameters& params = batch_sequence.parameters;
+            if (util::FileIO::IsDetectionFile(batch_sequence.input_file))
+            {
+                std::string format = params.input_format;
+                util::FileIO::ReadDetections(detections, format, batch_sequence.input_file,
+                                             params.temporal_weight, params.spatial_weight,
+                                             params.angular_weight);
 
-    // Display the tracking data
-    if (display)
-    {
-        util::Visualizer vis;
+                // The tracker is instantiated for the objects of the input format
+                if (format != params.input_format)
+                {
+                    throw "Input format " + params.input_format + " does not match the " +
+                          format + " objects of file: " + batch_sequence.input_file;
+                }
+                return;
+            }
 
-        if (algorithm == "berclaz")
-            vis.Display(tracks, images_folder, output_images, output_path, "Visualizer",
-                        0, 24, berclaz_params.h_res, berclaz_params.v_res);
-        else
-            vis.Display(tracks, images_folder, output_images, output_path);
-    }
-}
+            util::ValueTable batch_values;
+            if (batch_sequence.input_header.size() > 0)
+            {
+                util::FileIO::ReadCSVParallel(batch_values, batch_sequence.input_header,
+                                              batch_sequence.input_file, input_delimiter, 1);
+            }
+            else
+            {
+                util::FileIO::ReadCSVParallel(batch_values, batch_sequence.input_file,
+                                              input_delimiter, 1);
+            }
 
-void CreateTestGraph(DirectedGraph& graph, Vertex& source, Vertex& sink)
-{
-    // Create test graph (suurballe wikipedia example)
-//    std::vector<Vertex> vertices;
-//    for (size_t i = 0; i < 6; ++i)
-//    {
-//        vertices.push_back(
-//                boost::add_vertex(
-//                        core::ObjectDataPtr(new core::ObjectData(i)),graph));
-//    }
-//
-//    // AB
-//    boost::add_edge(vertices[0], vertices[1], 1.0, graph);
-//    boost::add_edge(vertices[1], vertices[0], 1.0, graph);
-//
-//    // AC
-//    boost::add_edge(vertices[0], vertices[2], 2.0, graph);
-//    boost::add_edge(vertices[2], vertices[0], 2.0, graph);
-//
-//    // BD
-//    boost::add_edge(vertices[1], vertices[3], 1.0, graph);
-//    boost::add_edge(vertices[3], vertices[1], 1.0, graph);
-//
-//    // BE
-//    boost::add_edge(vertices[1], vertices[4], 2.0, graph);
-//    boost::add_edge(vertices[4], vertices[1], 2.0, graph);
-//
-//    // CD
-//    boost::add_edge(vertices[2], vertices[3], 2.0, graph);
-//    boost::add_edge(vertices[3], vertices[2], 2.0, graph);
-//
-//    // DF
-//    boost::add_edge(vertices[3], vertices[5], 1.0, graph);
-//    boost::add_edge(vertices[5], vertices[3], 1.0, graph);
-//
-//    // EF
-//    boost::add_edge(vertices[4], vertices[5], 2.0, graph);
-//    boost::add_edge(vertices[5], vertices[4], 2.0, graph);
-//
-//    source = vertices[0];
-//    sink = vertices[5];
+            util::Parser::ParseObjectData(batch_values, detections, params.input_format,
+                                          batch_sequence.image_width,
+                                          batch_sequence.image_height, params.temporal_weight,
+                                          params.spatial_weight, params.angular_weight);
+        };
 
-    // Create test graph
-    std::vector<Vertex> vertices;
-    for (size_t i = 0; i < 11; ++i)
-    {
-        vertices.push_back(
-                boost::add_vertex(
-                        core::ObjectDataPtr(new core::ObjectData(i)),graph));
+        try
+        {
+            algo::BatchRunner runner(base);
+            runner.ReadManifest(batch_file, input_delimiter);
+            runner.Run(load, output_format, output_delimiter, batch_threads, batch_in_flight,
+                       output_path.empty() ? "" : output_path + "/batch.csv");
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to run the batch!");
+            util::Logger::LogError(e);
+        }
+        return;
     }
 
-//    boost::add_edge(vertices[0], vertices[1], 0.0, graph);
-//    boost::add_edge(vertices[0], vertices[8], 0.0, graph);
-//    boost::add_edge(vertices[0], vertices[4], 0.0, graph);
-//    boost::add_edge(vertices[1], vertices[2], -1.0, graph);
-//    boost::add_edge(vertices[1], vertices[5], -1.0, graph);
-//    boost::add_edge(vertices[2], vertices[3], -1.0, graph);
-//    boost::add_edge(vertices[2], vertices[6], -1.0, graph);
-//    boost::add_edge(vertices[2], vertices[10], -1.0, graph);
-//    boost::add_edge(vertices[3], vertices[7], 4.0, graph);
-//    boost::add_edge(vertices[4], vertices[2], 1.0, graph);
-//    boost::add_edge(vertices[4], vertices[5], 1.0, graph);
-//    boost::add_edge(vertices[4], vertices[9], 1.0, graph);
-//    boost::add_edge(vertices[5], vertices[6], 2.0, graph);
-//    boost::add_edge(vertices[5], vertices[3], 2.0, graph);
-//    boost::add_edge(vertices[6], vertices[7], 4.0, graph);
-//    boost::add_edge(vertices[8], vertices[2], -3.0, graph);
-//    boost::add_edge(vertices[8], vertices[9], -3.0, graph);
-//    boost::add_edge(vertices[9], vertices[3], 3.0, graph);
-//    boost::add_edge(vertices[9], vertices[10], 3.0, graph);
-//    boost::add_edge(vertices[10], vertices[7], 4.0, graph);
-
-    source = vertices[0];
-    sink = vertices[10];
-
-    for (int i = 1; i < vertices.size() - 1; ++i)
+    // The sweep reads the input once and writes every result into the output path
+    if (!sweep_file.empty() &&
+        (stream || online || opt_var_map.count("convert") != 0 || output_path.empty()))
     {
-        boost::add_edge(source, vertices[i], 0.0, graph);
+        util::Logger::LogError("The sweep needs an output path and can not stream the input!");
+        exit(0);
     }
 
-    boost::add_edge(vertices[1], vertices[4], -1.0, graph);
-    boost::add_edge(vertices[1], vertices[5], -1.0, graph);
-    boost::add_edge(vertices[1], vertices[10], 0.0, graph);
-    boost::add_edge(vertices[4], vertices[7], -1.0, graph);
-    boost::add_edge(vertices[4], vertices[8], -1.0, graph);
-    boost::add_edge(vertices[4], vertices[10], 0.0, graph);
-    boost::add_edge(vertices[7], vertices[10], -1.0, graph);
-
-    boost::add_edge(vertices[2], vertices[4], -2.0, graph);
-    boost::add_edge(vertices[2], vertices[5], -2.0, graph);
-    boost::add_edge(vertices[2], vertices[6], -2.0, graph);
-    boost::add_edge(vertices[2], vertices[10], 0.0, graph);
-    boost::add_edge(vertices[5], vertices[7], -2.0, graph);
-    boost::add_edge(vertices[5], vertices[8], -2.0, graph);
-    boost::add_edge(vertices[5], vertices[9], -2.0, graph);
-    boost::add_edge(vertices[5], vertices[10], 0.0, graph);
-    boost::add_edge(vertices[8], vertices[10], -2.0, graph);
-
-    boost::add_edge(vertices[3], vertices[5], -3.0, graph);
-    boost::add_edge(vertices[3], vertices[6], -3.0, graph);
-    boost::add_edge(vertices[3], vertices[10], 0.0, graph);
-    boost::add_edge(vertices[6], vertices[8], -3.0, graph);
-    boost::add_edge(vertices[6], vertices[9], -3.0, graph);
-    boost::add_edge(vertices[6], vertices[10], 0.0, graph);
-    boost::add_edge(vertices[9], vertices[10], -3.0, graph);
-
-
-//     Connect all with source and sink
-//    boost::add_edge(vertices[1], sink, 0, graph);
-//    boost::add_edge(source, vertices[2], 0, graph);
-//    boost::add_edge(vertices[2], sink, 0, graph);
-//    boost::add_edge(source, vertices[3], 0, graph);
-//    boost::add_edge(vertices[4], sink, 0, graph);
-//    boost::add_edge(source, vertices[5], 0, graph);
-//    boost::add_edge(vertices[5], sink, 0, graph);
-//    boost::add_edge(source, vertices[6], 0, graph);
-//    boost::add_edge(vertices[8], sink, 0, graph);
-//    boost::add_edge(source, vertices[9], 0, graph);
-//    boost::add_edge(vertices[9], sink, 0, graph);
-//    boost::add_edge(source, vertices[10], 0, graph);
-
-//    boost::add_edge(vertices[1], vertices[7], 0.0, graph);
-//    boost::add_edge(vertices[8], vertices[7], 0.0, graph);
-}
-
-void TestKBellmanFord(DirectedGraph graph, Vertex source, Vertex sink, size_t n_paths)
-{
-    util::FileIO::WriteCSVMatlab(graph, "/home/wrede/Dokumente/graph_kbf.csv");
-
-    MultiPredecessorMap paths;
-    for (size_t i = 0; i < n_paths; ++i)
+    core::DetectionSequence sequence;
+    util::ValueTable values;
+    std::unique_ptr<util::DetectionStream> detection_stream;
+    bool binary_input = false;
+    if (stream || online)
     {
-        // Prepare variables for path finding
-        size_t graph_size = boost::num_vertices(graph);
-        std::vector<Vertex> pred_list(graph_size);
-        std::vector<double> dist_list(graph_size);
-        VertexIndexMap graph_indices = boost::get(boost::vertex_index, graph);
-        EdgeWeightMap weight_map = boost::get(boost::edge_weight, graph);
-        PredecessorMap pred_map(&pred_list[0], graph_indices);
-        DistanceMap dist_map(&dist_list[0], graph_indices);
-
-        // Find the shortest path
-        boost::bellman_ford_shortest_paths(graph, graph_size,
-                                           boost::root_vertex(source)
-                                                   .weight_map(weight_map)
-                                                   .predecessor_map(pred_map)
-                                                   .distance_map(dist_map));
-
-        // Add path
-        for (Vertex u = sink, v = pred_map[u]; u != v; u = v, v = pred_map[v])
-        {
-            paths[u].insert(v);
-
-            if (u != sink && u != source)
-                boost::clear_out_edges(u, graph);
+        // The conversion reads the whole input, it does not track
+        if (opt_var_map.count("convert") != 0)
+        {
+            util::Logger::LogError("Streaming and online tracking only apply to tracking, "
+                                           "not to the conversion!");
+            exit(0);
         }
-    }
 
-    util::FileIO::WriteCSVMatlab(paths, source, sink, "/home/wrede/Dokumente/paths_kbf.csv");
-}
+        // Only berclaz processes the sequence batch by batch
+        if (stream && algorithm != "berclaz")
+        {
+            util::Logger::LogError("Streaming is only supported by berclaz!");
+            exit(0);
+        }
 
-void TestGrid()
-{
-    int lower_index = 0;
-    int upper_index = 5;
-    double lower_bound = 0.0;
-    double upper_bound = 50.0;
-    util::Grid grid(upper_index, upper_index, upper_index,
-                    upper_bound, upper_bound, upper_bound);
-
-    std::uniform_int_distribution<int> unii(lower_index, upper_index - 1);
-    std::uniform_real_distribution<double> unif(lower_bound, upper_bound);
-    std::default_random_engine re;
-
-    // Fill with empty values
-    std::cout << "fill with empty values\n";
-    for (int z = lower_index; z < upper_index; ++z)
-    {
-        for (int y = lower_index; y < upper_index; ++y)
+        GBMOT_LOG_INFO("Open input stream");
+        try
         {
-            for (int x = lower_index; y < upper_index; ++y)
+            if (input_file == "-")
+            {
+                detection_stream.reset(new util::DetectionStream(std::cin, header,
+                                                                 input_delimiter, input_format,
+                                                                 image_width, image_height,
+                                                                 temporal_weight, spatial_weight,
+                                                                 angular_weight,
+                                                                 score_min, score_max));
+            }
+            else
             {
-                grid.SetValue(nullptr, x, y, z);
+                detection_stream.reset(new util::DetectionStream(input_file, header,
+                                                                 input_delimiter, input_format,
+                                                                 image_width, image_height,
+                                                                 temporal_weight, spatial_weight,
+                                                                 angular_weight,
+                                                                 score_min, score_max));
             }
         }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to read input file!");
+            util::Logger::LogError(e);
+            exit(0);
+        }
     }
-
-    // Randomly add data
-    std::cout << "randomly add data\n";
-    for (int i = 0; i < 10; ++i)
+    else if (!sweep_file.empty() && util::FileIO::IsDetectionFile(input_file))
+    {
+        // The sweep loads the binary file for every configuration
+        binary_input = true;
+    }
+    else if (util::FileIO::IsDetectionFile(input_file))
     {
-        int xi = unii(re);
-        int yi = unii(re);
-        int zi = unii(re);
+        // Binary detection files are loaded without any parsing
+        GBMOT_LOG_INFO("Load binary input");
+        try
+        {
+            util::ScopedTimer timer("read");
+            util::FileIO::ReadDetections(sequence, input_format, input_file,
+                                         temporal_weight, spatial_weight, angular_weight);
 
-        core::ObjectDataPtr value(new core::ObjectData((size_t)i));
-        grid.SetValue(value, xi, yi, zi);
+            // The file decides the object model of the tracker
+            base.parameters.input_format = input_format;
 
-        std::cout << xi << "," << yi << "," << zi << " = " << *value << std::endl;
+            if (util::Profiler::IsEnabled())
+            {
+                util::Memory::Record("sequence", util::Memory::EstimateSize(sequence));
+                util::Memory::RecordResident();
+            }
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to read input file!");
+            util::Logger::LogError(e);
+            exit(0);
+        }
     }
-
-    // Randomly get data
-    std::cout << "randomly get data\n";
-    for (int i = 0; i < 10; ++i)
+    else
     {
-        double x = unif(re);
-        double y = unif(re);
-        double z = unif(re);
+        // Reading the input file
+        GBMOT_LOG_INFO("Read input");
+        try
+        {
+            util::ScopedTimer timer("read");
+            if (header.size() > 0)
+            {
+                util::FileIO::ReadCSVParallel(values, header, input_file, input_delimiter,
+                                              input_threads);
+            }
+            else
+            {
+                util::FileIO::ReadCSVParallel(values, input_file, input_delimiter,
+                                              input_threads);
+            }
 
-        std::cout << x << "," << y << "," << z << " = ";
-        core::ObjectDataPtr value = grid.GetValue(x, y, z);
-        if (value)
+            if (util::Profiler::IsEnabled())
+            {
+                util::Memory::Record("values", util::Memory::EstimateSize(values));
+                util::Memory::RecordResident();
+            }
+        }
+        catch (std::exception& e)
         {
-            std::cout << *value << std::endl;
+            util::Logger::LogError("Failed to read input file!");
+            util::Logger::LogError(e.what());
+            exit(0);
         }
-        else
+        catch (std::string& e)
         {
-            std::cout << "nullptr" << std::endl;
+            util::Logger::LogError("Failed to read input file!");
+            util::Logger::LogError(e);
+            exit(0);
         }
-    }
-}
 
-void CreateBerclazGraph(DirectedGraph& graph, Vertex& source, Vertex& sink)
-{
-    util::Logger::SetDebug(true);
-    util::Logger::SetInfo(true);
-    util::Logger::LogInfo("Test berclaz graph");
-
-    // Init grid with data
-    util::Grid grid(3, 3, 3, 9.0, 9.0, 9.0);
-    for (int z = 0; z < grid.GetDepthCount(); ++z)
-    {
-        for (int y = 0; y < grid.GetHeightCount(); ++y)
+        // Parsing the read input, the sweep parses it for every configuration
+        if (sweep_file.empty())
         {
-            for (int x = 0; x < grid.GetWidthCount(); ++x)
+            try
             {
-                core::ObjectDataPtr value(new core::ObjectData(10));
-                grid.SetValue(value, x, y, z);
+                util::Parser::ParseObjectData(values, sequence, input_format, image_width,
+                                              image_height, temporal_weight, spatial_weight,
+                                              angular_weight);
+            }
+            catch (std::string& e)
+            {
+                // No valid input-format specified
+                std::cout << opts << std::endl;
+                exit(0);
             }
         }
     }
 
-    // Add path source->0,0,0->0,0,1->0,0,2->sink
-    core::ObjectDataPtr value0(new core::ObjectData(1));
-    value0->SetDetectionScore(1.0);
-    grid.SetValue(value0, 0, 0, 0);
-    core::ObjectDataPtr value1(new core::ObjectData(2));
-    value1->SetDetectionScore(1.0);
-    grid.SetValue(value1, 0, 0, 1);
-    core::ObjectDataPtr value2(new core::ObjectData(3));
-    value2->SetDetectionScore(1.0);
-    grid.SetValue(value2, 0, 0, 2);
-
-    // Add path source->0,1,0->0,1,1->0,1,2->sink
-    core::ObjectDataPtr value3(new core::ObjectData(4));
-    value3->SetDetectionScore(0.6);
-    grid.SetValue(value3, 0, 1, 0);
-    core::ObjectDataPtr value4(new core::ObjectData(5));
-    value4->SetDetectionScore(0.6);
-    grid.SetValue(value4, 0, 1, 1);
-    core::ObjectDataPtr value5(new core::ObjectData(6));
-    value5->SetDetectionScore(0.6);
-    grid.SetValue(value5, 0, 1, 2);
-
-    // Add path source->0,2,0->0,2,1->0,2,2->sink
-    core::ObjectDataPtr value6(new core::ObjectData(7));
-    value6->SetDetectionScore(0.55);
-    grid.SetValue(value6, 0, 2, 0);
-    core::ObjectDataPtr value7(new core::ObjectData(8));
-    value7->SetDetectionScore(0.55);
-    grid.SetValue(value7, 0, 2, 1);
-    core::ObjectDataPtr value8(new core::ObjectData(9));
-    value8->SetDetectionScore(0.55);
-    grid.SetValue(value8, 0, 2, 2);
-
-    util::Logger::LogDebug("add vertices");
-
-    // Add grid vertices
-    graph.clear();
-    for (int z = 0; z < grid.GetDepthCount(); ++z)
+    // Read the ground truth to evaluate the tracks with
+    util::EvaluatorPtr evaluator;
+    if (!ground_truth_file.empty())
     {
-        for (int y = 0; y < grid.GetHeightCount(); ++y)
+        GBMOT_LOG_INFO("Read ground truth");
+        if (opt_var_map.count("match-threshold") == 0)
+        {
+            match_threshold = match_metric == "iou" ? 0.5 : 0.05;
+        }
+
+        try
         {
-            for (int x = 0; x < grid.GetWidthCount(); ++x)
+            std::vector<core::TrackletPtr> ground_truth;
+            if (ground_truth_format == "binary" || util::FileIO::IsTrackFile(ground_truth_file))
+            {
+                util::FileIO::ReadTracksBinary(ground_truth, ground_truth_file);
+            }
+            else if (ground_truth_format == "long")
+            {
+                util::FileIO::ReadTracksLong(ground_truth, ground_truth_file, input_delimiter);
+            }
+            else
             {
-                boost::add_vertex(grid.GetValue(x, y, z), graph);
+                util::FileIO::ReadTracks(ground_truth, ground_truth_file, input_delimiter);
             }
+
+            // The sweep already runs the configurations in parallel
+            evaluator.reset(new util::Evaluator(ground_truth, match_metric, match_threshold,
+                                                sweep_file.empty() ? evaluation_threads : 1));
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to read ground truth file!");
+            util::Logger::LogError(e);
+            exit(0);
         }
     }
 
-    util::Logger::LogDebug("vertex count " + std::to_string(boost::num_vertices(graph)));
-    util::Logger::LogDebug("edge count " + std::to_string(boost::num_edges(graph)));
-
-    // Add source and sink vertex
-    source = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()), graph);
-    sink = boost::add_vertex(core::ObjectDataPtr(new core::ObjectData()), graph);
-
-    util::Logger::LogDebug("add edges");
-
-    // Iterate all vertices but source and sink
-    VertexIndexMap vertices = boost::get(boost::vertex_index, graph);
-    VertexValueMap values = boost::get(boost::vertex_name, graph);
-    int vicinity_size = 1;
-    int layer_size = grid.GetWidthCount() * grid.GetHeightCount();
-    for (int z = 0; z < grid.GetDepthCount(); ++z)
+    // Run the algorithm for every configuration of the parameter grid
+    if (!sweep_file.empty())
     {
-        for (int y = 0; y < grid.GetHeightCount(); ++y)
+        // Every configuration needs its own objects, the algorithms modify them
+        algo::SequenceFunction load;
+        if (binary_input)
         {
-            for (int x = 0; x < grid.GetWidthCount(); ++x)
+            load = [&](const algo::TrackerParameters& params, core::DetectionSequence& sequence)
             {
-                // First vertex index
-                int vi = x + y * grid.GetHeightCount() + z * layer_size;
+                std::string format = params.input_format;
+                util::FileIO::ReadDetections(sequence, format, input_file, params.temporal_weight,
+                                             params.spatial_weight, params.angular_weight);
 
-                // Get the score, clamp it, prevent division by zero and
-                // logarithm of zero
-                double score = values[vi]->GetDetectionScore();
-                if (score > 0.999999)
+                // The tracker is instantiated for the objects of the input format
+                if (format != params.input_format)
                 {
-                    score = 0.999999;
-                }
-                else if (score < 0.000001)
-                {
-                    score = 0.000001;
+                    throw "Input format " + params.input_format + " does not match the " +
+                          format + " objects of file: " + input_file;
                 }
+            };
+        }
+        else
+        {
+            // The configurations parse the shared table concurrently
+            util::Parser::AddMissingColumns(values);
+            load = [&](const algo::TrackerParameters& params, core::DetectionSequence& sequence)
+            {
+                util::Parser::ParseObjectData(values, sequence, params.input_format,
+                                              image_width, image_height, params.temporal_weight,
+                                              params.spatial_weight, params.angular_weight);
+            };
+        }
+
+        try
+        {
+            algo::ParameterSweep sweep(base.parameters);
+            sweep.SetEvaluator(evaluator);
+            sweep.ReadGrid(sweep_file, input_delimiter);
+            sweep.Run(load, output_path, output_format, output_delimiter, sweep_threads);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to run the parameter sweep!");
+            util::Logger::LogError(e);
+        }
+        return;
+    }
 
-                // Calculate the edge weight
-                double weight = -std::log(score / (1 - score));
+    // Convert the input into a binary detection file
+    if (opt_var_map.count("convert") != 0)
+    {
+        GBMOT_LOG_INFO("Convert input");
+        try
+        {
+            util::FileIO::WriteDetections(sequence, input_format, convert_file);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to convert input file!");
+            util::Logger::LogError(e);
+        }
+        exit(0);
+    }
 
-                // Connect with the next frame only if there is a next frame
-                if (z < grid.GetDepthCount() - 1)
-                {
-                    // Iterate all nearby cells in the next frame
-                    for (int ny = std::max(0, y - vicinity_size);
-                         ny < std::min(grid.GetHeightCount(), y + vicinity_size + 1);
-                         ++ny)
-                    {
-                        for (int nx = std::max(0, x - vicinity_size);
-                             nx < std::min(grid.GetWidthCount(), x + vicinity_size + 1);
-                             ++nx)
-                        {
-                            // Second vertex index
-                            int vj = nx + ny * grid.GetHeightCount() + (z + 1) * layer_size;
-
-                            // Connect to nearby cells
-                            boost::add_edge(vertices[vi], vertices[vj], weight, graph);
-                        }
-                    }
-
-//                    boost::add_edge(vertices[vi], sink, 0.0, graph);
-                }
-                else
-                {
-                    boost::add_edge(vertices[vi], sink, weight, graph);
-                }
+    if (algorithm != "n-stage" && algorithm != "berclaz")
+    {
+        // No valid algorithm specified
+        std::cout << opts << std::endl;
+        exit(0);
+    }
 
-                if (z < 1)
+    // Track online with the specified algorithm
+    if (online)
+    {
+        // Every window would overwrite the graphs of the previous window
+        if (!graph_dump_path.empty())
+        {
+            util::Logger::LogError("The graphs can not be dumped in online mode!");
+            exit(0);
+        }
+
+        algo::TrackingFunction run = [&base](core::DetectionSequence& window,
+                                             std::vector<core::TrackletPtr>& tracks)
+        {
+            algo::ParameterSweep::RunTracker(base.parameters, window, tracks, graph_dump_path);
+        };
+
+        algo::OnlineTracker tracker(run, latency);
+        try
+        {
+            if (output)
+            {
+                std::ofstream out(output_path + "/tracks.csv", std::ios::out);
+                if (!out.is_open())
                 {
-                    // Connect with source
-                    boost::add_edge(source, vertices[vi], 0.0, graph);
+                    throw "Unable to open file: " + output_path + "/tracks.csv";
                 }
+                tracker.Run(*detection_stream, out, output_delimiter);
+            }
+            else
+            {
+                tracker.Run(*detection_stream, std::cout, output_delimiter);
             }
         }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to track the input online!");
+            util::Logger::LogError(e);
+        }
+        return;
     }
 
-    util::Logger::LogDebug("vertex count " + std::to_string(boost::num_vertices(graph)));
-    util::Logger::LogDebug("edge count " + std::to_string(boost::num_edges(graph)));
-}
-
-void CreatePresentationGraph(DirectedGraph& graph, Vertex& source, Vertex& sink, bool two_paths)
-{
-    std::vector<Vertex> vertices;
-
-    if (two_paths)
+    // Running the specified algorithm
+    std::vector<core::TrackletPtr> tracks;
+    time_t begin_time, end_time;
+    GBMOT_LOG_INFO("Start time measurement");
+    begin_time = time(0);
+    try
     {
-        for (size_t i = 0; i < 10; ++i)
-        {
-            vertices.push_back(
-                    boost::add_vertex(core::ObjectDataPtr(new core::ObjectData(i)), graph));
-        }
-
-        source = vertices[0];
-        sink = vertices[9];
-
-        boost::add_edge(vertices[0], vertices[1], 1.0, graph);
-        boost::add_edge(vertices[0], vertices[2], 1.0, graph);
-        boost::add_edge(vertices[1], vertices[3], 12.0, graph);
-        boost::add_edge(vertices[1], vertices[4], 15.0, graph);
-        boost::add_edge(vertices[2], vertices[3], 15.0, graph);
-        boost::add_edge(vertices[2], vertices[4], 10.0, graph);
-        boost::add_edge(vertices[3], vertices[5], 15.0, graph);
-        boost::add_edge(vertices[3], vertices[6], 12.0, graph);
-        boost::add_edge(vertices[4], vertices[5], 12.0, graph);
-        boost::add_edge(vertices[4], vertices[6], 11.0, graph);
-        boost::add_edge(vertices[5], vertices[7], 12.0, graph);
-        boost::add_edge(vertices[5], vertices[8], 12.0, graph);
-        boost::add_edge(vertices[6], vertices[7], 11.0, graph);
-        boost::add_edge(vertices[6], vertices[8], 10.0, graph);
-        boost::add_edge(vertices[7], vertices[9], 1.0, graph);
-        boost::add_edge(vertices[8], vertices[9], 1.0, graph);
+        if (detection_stream)
+        {
+            RunBerclaz(base.parameters, *detection_stream, tracks);
+        }
+        else
+        {
+            GBMOT_LOG_INFO("Running " + algorithm);
+            algo::ParameterSweep::RunTracker(base.parameters, sequence, tracks, graph_dump_path);
+            GBMOT_LOG_INFO("Finished");
+        }
     }
-    else
+    catch (std::string& e)
     {
-        for (size_t i = 0; i < 14; ++i)
-        {
-            vertices.push_back(
-                    boost::add_vertex(core::ObjectDataPtr(new core::ObjectData(i)), graph));
-        }
-
-        source = vertices[0];
-        sink = vertices[9];
-
-        boost::add_edge(vertices[0], vertices[1], 1.0, graph);
-        boost::add_edge(vertices[0], vertices[2], 1.0, graph);
-        boost::add_edge(vertices[1], vertices[3], 12.0, graph);
-        boost::add_edge(vertices[1], vertices[4], 15.0, graph);
-        boost::add_edge(vertices[2], vertices[3], 15.0, graph);
-        boost::add_edge(vertices[2], vertices[4], 10.0, graph);
-        boost::add_edge(vertices[3], vertices[5], 15.0, graph);
-        boost::add_edge(vertices[3], vertices[6], 12.0, graph);
-        boost::add_edge(vertices[4], vertices[5], 12.0, graph);
-        boost::add_edge(vertices[4], vertices[6], 11.0, graph);
-        boost::add_edge(vertices[5], vertices[7], 12.0, graph);
-        boost::add_edge(vertices[5], vertices[8], 12.0, graph);
-        boost::add_edge(vertices[6], vertices[7], 11.0, graph);
-        boost::add_edge(vertices[6], vertices[8], 10.0, graph);
-        boost::add_edge(vertices[7], vertices[9], 1.0, graph);
-        boost::add_edge(vertices[8], vertices[9], 1.0, graph);
-
-        boost::add_edge(vertices[0], vertices[10], 20.0, graph);
-        boost::add_edge(vertices[10], vertices[11], 20.0, graph);
-        boost::add_edge(vertices[10], vertices[3], 20.0, graph);
-        boost::add_edge(vertices[10], vertices[4], 20.0, graph);
-        boost::add_edge(vertices[11], vertices[12], 20.0, graph);
-        boost::add_edge(vertices[11], vertices[5], 20.0, graph);
-        boost::add_edge(vertices[12], vertices[6], 20.0, graph);
-        boost::add_edge(vertices[13], vertices[9], 20.0, graph);
+        util::Logger::LogError("Failed to run the algorithm!");
+        util::Logger::LogError(e);
+        exit(0);
     }
-}
 
-void CreateSuurballeGraph(DirectedGraph& graph, Vertex& source, Vertex& sink, bool first)
-{
-    std::vector<Vertex> vertices;
+    end_time = time(0);
+    GBMOT_LOG_INFO("Time measurement stopped");
+    GBMOT_LOG_INFO("Time passed: "
+                          + std::to_string(difftime(end_time, begin_time) / 60.0)
+                          + " minutes");
 
-    if (first)
+    // Write the output file
+    if (output)
     {
-        // First example graph
-        for (int i = 0; i < 7; ++i)
+        util::ScopedTimer timer("write");
+
+        if (output_format == "long")
         {
-            vertices.push_back(boost::add_vertex(graph));
+            util::FileIO::WriteTracksLong(tracks, output_path + "/tracks.csv", output_delimiter);
+        }
+        else if (output_format == "binary")
+        {
+            try
+            {
+                util::FileIO::WriteTracksBinary(tracks, output_path + "/tracks.gbt");
+            }
+            catch (std::string& e)
+            {
+                util::Logger::LogError(e);
+            }
+        }
+        else
+        {
+            util::FileIO::WriteTracks(tracks, output_path + "/tracks.csv", output_delimiter);
         }
-
-        source = vertices[0];
-        sink = vertices[6];
-
-        boost::add_edge(vertices[0], vertices[1], 5.0, graph);
-        boost::add_edge(vertices[0], vertices[4], 2.0, graph);
-        boost::add_edge(vertices[1], vertices[2], 1.0, graph);
-        boost::add_edge(vertices[1], vertices[4], 1.0, graph);
-        boost::add_edge(vertices[2], vertices[6], 1.0, graph);
-        boost::add_edge(vertices[3], vertices[2], 1.0, graph);
-        boost::add_edge(vertices[4], vertices[3], 2.0, graph);
-        boost::add_edge(vertices[4], vertices[5], 1.0, graph);
-        boost::add_edge(vertices[5], vertices[2], 1.0, graph);
-        boost::add_edge(vertices[5], vertices[6], 1.0, graph);
     }
-    else
+
+    // Evaluate the tracks with the ground truth
+    if (evaluator)
     {
-        // Second example graph
-        for (int i = 0; i < 8; ++i)
-        {
-            vertices.push_back(boost::add_vertex(graph));
-        }
-        source = vertices[0];
-        sink = vertices[7];
-        boost::add_edge(vertices[0], vertices[1], 1.0, graph);
-        boost::add_edge(vertices[0], vertices[4], 8.0, graph);
-        boost::add_edge(vertices[0], vertices[5], 1.0, graph);
-        boost::add_edge(vertices[1], vertices[2], 1.0, graph);
-        boost::add_edge(vertices[1], vertices[7], 8.0, graph);
-        boost::add_edge(vertices[2], vertices[3], 1.0, graph);
-        boost::add_edge(vertices[3], vertices[4], 1.0, graph);
-        boost::add_edge(vertices[3], vertices[6], 2.0, graph);
-        boost::add_edge(vertices[4], vertices[7], 1.0, graph);
-        boost::add_edge(vertices[5], vertices[2], 2.0, graph);
-        boost::add_edge(vertices[5], vertices[6], 6.0, graph);
-        boost::add_edge(vertices[6], vertices[7], 1.0, graph);
+        GBMOT_LOG_INFO("Evaluate tracks");
+        util::EvaluationMetrics metrics;
+        try
+        {
+            util::ScopedTimer timer("evaluate");
+            metrics = evaluator->Evaluate(tracks);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError("Failed to evaluate the tracks!");
+            util::Logger::LogError(e);
+            exit(0);
+        }
+
+        if (output)
+        {
+            std::ofstream out(output_path + "/evaluation.csv", std::ios::out);
+            if (out.is_open())
+            {
+                util::Evaluator::WriteMetrics(metrics, out, output_delimiter);
+            }
+            else
+            {
+                util::Logger::LogError("Unable to open file: " + output_path + "/evaluation.csv");
+            }
+        }
+        else
+        {
+            util::Evaluator::WriteMetrics(metrics, std::cout, output_delimiter);
+        }
     }
-}
 
-void TestYAOKSP()
-{
-    Vertex source, sink;
-    DirectedGraph graph;
-//    CreatePresentationGraph(graph, source, sink, true);
-    CreateSuurballeGraph(graph, source, sink, false);
-//    CreateBerclazGraph(graph, source, sink);
-    algo::KShortestPaths ksp(graph, source, sink);
-
-    ksp.Run(3);
-
-    std::vector<std::vector<Vertex>> paths;
-    ksp.GetPaths(paths);
-    for (auto path : paths)
+    // Display the tracking data, a video is written even without a display
+    if (display || !output_video.empty())
     {
-        std::cout << "path: ";
-        for (auto v : path)
+        util::Visualizer vis;
+        vis.SetHeadless(headless || !display);
+        vis.SetVideoOutput(output_video, video_codec, video_fps);
+
+        // Errors of the image and video writers are rethrown by the visualizer
+        try
         {
-            std::cout << std::setw(2) << v << " ";
+            if (algorithm == "berclaz")
+                vis.Display(tracks, images_folder, output_images, output_path, "Visualizer",
+                            0, 24, base.parameters.h_res, base.parameters.v_res);
+            else
+                vis.Display(tracks, images_folder, output_images, output_path);
+        }
+        catch (std::exception& e)
+        {
+            util::Logger::LogError("Failed to visualize the tracks!");
+            util::Logger::LogError(e.what());
         }
-        std::cout << std::endl;
     }
 }
 
@@ -922,5 +956,18 @@ int main(int argc, char** argv)
 
     Run(argc, argv);
 
+    // Write the time spent in every stage
+    if (!profile_file.empty())
+    {
+        try
+        {
+            util::Profiler::WriteReport(profile_file);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError(e);
+        }
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "../algo/IterativeDijkstra.h"
+#include "../algo/KShortestPaths.h"
+#include "../util/FileIO.h"
+#include "../util/Logger.h"
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+
+/**
+ * Sums the edge weights along the given path.
+ *
+ * @param graph The graph containing the path
+ * @param path The vertices of the path from source to sink
+ * @return The total weight of the path
+ */
+double GetPathCost(DirectedGraph& graph, std::vector<Vertex>& path)
+{
+    EdgeWeightMap weights = boost::get(boost::edge_weight, graph);
+    double cost = 0.0;
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+        std::pair<Edge, bool> edge = boost::edge(path[i - 1], path[i], graph);
+        if (edge.second)
+        {
+            cost += weights[edge.first];
+        }
+    }
+    return cost;
+}
+
+void Run(int argc, char** argv)
+{
+    std::string graph_file;
+    size_t max_path_count, repeat_count;
+    bool info, debug;
+
+    boost::program_options::options_description opts("Allowed options");
+    opts.add_options()
+            ("help",
+             "produce help message")
+            ("info",
+             boost::program_options::value<bool>(&info)
+                    ->default_value(false),
+             "if the program should show progress information")
+            ("debug",
+             boost::program_options::value<bool>(&debug)
+                    ->default_value(false),
+             "if the program should show debug messages")
+            ("graph",
+             boost::program_options::value<std::string>(&graph_file),
+             "the binary graph file to replay, written with --dump-graphs")
+            ("max-path-count",
+             boost::program_options::value<size_t>(&max_path_count)
+                    ->default_value(1),
+             "the maximal number of paths to extract")
+            ("repeat",
+             boost::program_options::value<size_t>(&repeat_count)
+                    ->default_value(1),
+             "the number of times the solver is run, the timing of every run is printed");
+
+    boost::program_options::variables_map opt_var_map;
+    boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, opts),
+            opt_var_map);
+    boost::program_options::notify(opt_var_map);
+
+    if (opt_var_map.count("help") != 0 || opt_var_map.count("graph") == 0)
+    {
+        std::cout << opts << std::endl;
+        exit(0);
+    }
+
+    util::Logger::SetInfo(info);
+    util::Logger::SetDebug(debug);
+
+    // Load the graph
+    DirectedGraph graph;
+    Vertex source, sink;
+    uint32_t solver;
+    auto load_begin = std::chrono::steady_clock::now();
+    try
+    {
+        util::FileIO::ReadGraphBinary(graph, source, sink, solver, graph_file);
+    }
+    catch (std::string& e)
+    {
+        util::Logger::LogError("Failed to read graph file!");
+        util::Logger::LogError(e);
+        exit(0);
+    }
+    std::chrono::duration<double> load_time = std::chrono::steady_clock::now() - load_begin;
+
+    std::cout << "graph " << graph_file << std::endl
+              << "vertices " << boost::num_vertices(graph) << std::endl
+              << "edges " << boost::num_edges(graph) << std::endl
+              << "solver " << (solver == util::FileIO::GRAPH_SOLVER_ITERATIVE_DIJKSTRA
+                               ? "iterative dijkstra" : "k shortest paths") << std::endl
+              << "load time " << load_time.count() << " s" << std::endl;
+
+    // Run the solver, every run starts with the loaded graph
+    for (size_t run = 0; run < repeat_count; ++run)
+    {
+        std::vector<std::vector<Vertex>> paths;
+        algo::SolverMetrics metrics;
+        std::chrono::duration<double> time;
+        if (solver == util::FileIO::GRAPH_SOLVER_ITERATIVE_DIJKSTRA)
+        {
+            // Iterative dijkstra alters the weights, the copy is not part of the timing
+            DirectedGraph run_graph = graph;
+            algo::IterativeDijkstra dijkstra(run_graph, source, sink);
+
+            auto begin = std::chrono::steady_clock::now();
+            dijkstra.Run(max_path_count);
+            time = std::chrono::steady_clock::now() - begin;
+
+            dijkstra.GetPaths(paths);
+            metrics = dijkstra.GetMetrics();
+        }
+        else
+        {
+            // The solver copies the graph, the copy is not part of the timing
+            algo::KShortestPaths ksp(graph, source, sink);
+
+            auto begin = std::chrono::steady_clock::now();
+            ksp.Run(max_path_count);
+            time = std::chrono::steady_clock::now() - begin;
+
+            ksp.GetPaths(paths);
+            metrics = ksp.GetMetrics();
+        }
+
+        double cost = 0.0;
+        for (auto& path : paths)
+        {
+            cost += GetPathCost(graph, path);
+        }
+
+        std::cout << "run " << run
+                  << " paths " << paths.size()
+                  << " cost " << cost
+                  << " time " << time.count() << " s" << std::endl
+                  << "  searches " << metrics.searches
+                  << " relaxations " << metrics.edge_relaxations
+                  << " pushes " << metrics.heap_pushes
+                  << " pops " << metrics.heap_pops
+                  << " settled " << metrics.vertices_settled
+                  << " bellman ford passes " << metrics.bellman_ford_passes
+                  << " transformed vertices " << metrics.transformed_vertex_count
+                  << " transformed edges " << metrics.transformed_edge_count << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Run(argc, argv);
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "DetectionArrays.h"
+
+namespace util
+{
+    StridedColumn::StridedColumn() : data_(nullptr), stride_(0)
+    {
+        /* EMPTY */
+    }
+
+    StridedColumn::StridedColumn(const double* data, size_t stride)
+            : data_(reinterpret_cast<const char*>(data)),
+              stride_(stride == 0 ? sizeof(double) : stride)
+    {
+        /* EMPTY */
+    }
+
+    DetectionArrays::DetectionArrays(size_t row_count) : row_count_(row_count)
+    {
+        /* EMPTY */
+    }
+
+    void DetectionArrays::SetColumn(const std::string& key, const double* data, size_t stride)
+    {
+        for (auto& column : columns_)
+        {
+            if (column.first == key)
+            {
+                column.second = StridedColumn(data, stride);
+                return;
+            }
+        }
+
+        columns_.push_back(std::make_pair(key, StridedColumn(data, stride)));
+    }
+
+    StridedColumn DetectionArrays::GetColumn(const std::string& key) const
+    {
+        for (auto& column : columns_)
+        {
+            if (column.first == key)
+            {
+                return column.second;
+            }
+        }
+
+        return StridedColumn();
+    }
+
+    size_t DetectionArrays::GetRowCount() const
+    {
+        return row_count_;
+    }
+}
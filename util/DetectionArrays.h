@@ -0,0 +1,114 @@
+#ifndef GBMOT_DETECTIONARRAYS_H
+#define GBMOT_DETECTIONARRAYS_H
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+    /**
+     * A column of values stored in memory owned by someone else.
+     * The value of a row is found the stride in bytes after the value of the
+     * previous row, thus separate arrays and arrays of structs can be read
+     * without copying them.
+     */
+    class StridedColumn
+    {
+    private:
+        /**
+         * The value of the first row, null if every value is zero
+         */
+        const char* data_;
+
+        /**
+         * The number of bytes between the values of two rows
+         */
+        size_t stride_;
+    public:
+        /**
+         * Creates a column containing only zeros.
+         */
+        StridedColumn();
+
+        /**
+         * Creates a column reading the given memory.
+         *
+         * @param data The value of the first row, null if every value is zero
+         * @param stride The number of bytes between the values of two rows,
+         *               zero for densely packed values
+         */
+        StridedColumn(const double* data, size_t stride);
+
+        /**
+         * Gets the value of the given row.
+         *
+         * @param row The row index
+         * @return The value
+         */
+        double operator[](size_t row) const
+        {
+            if (data_ == nullptr) return 0.0;
+
+            // The stride does not need to keep the alignment of a double
+            double value;
+            std::memcpy(&value, data_ + row * stride_, sizeof(value));
+            return value;
+        }
+    };
+
+    /**
+     * Detections stored in memory owned by someone else, one column per key.
+     * Can be parsed like a ValueTable without copying the values first.
+     */
+    class DetectionArrays
+    {
+    private:
+        /**
+         * The keys and their columns
+         */
+        std::vector<std::pair<std::string, StridedColumn>> columns_;
+
+        /**
+         * The number of rows
+         */
+        size_t row_count_;
+    public:
+        /**
+         * Creates detections without any columns.
+         *
+         * @param row_count The number of detections
+         */
+        DetectionArrays(size_t row_count);
+
+        /**
+         * Sets the memory of the column with the given key.
+         *
+         * @param key The key of the column, e.g. Parser::KEY_X
+         * @param data The value of the first row, null if every value is zero
+         * @param stride The number of bytes between the values of two rows,
+         *               zero for densely packed values
+         */
+        void SetColumn(const std::string& key, const double* data, size_t stride);
+
+        /**
+         * Gets the column with the given key.
+         *
+         * @param key The key of the column
+         * @return The column, filled with zeros if there is no column with the
+         *         given key
+         */
+        StridedColumn GetColumn(const std::string& key) const;
+
+        /**
+         * Gets the number of rows.
+         *
+         * @return The row count
+         */
+        size_t GetRowCount() const;
+    };
+}
+
+
+#endif //GBMOT_DETECTIONARRAYS_H
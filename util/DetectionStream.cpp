@@ -0,0 +1,187 @@
+#include <cmath>
+#include "DetectionStream.h"
+#include "FileIO.h"
+#include "Logger.h"
+#include "Parser.h"
+#include "Profiler.h"
+
+namespace util
+{
+    DetectionStream::DetectionStream(const std::string& file_name, const std::string& header,
+                                     char delimiter, const std::string& input_format,
+                                     double image_width, double image_height,
+                                     double temporal_weight, double spatial_weight,
+                                     double angular_weight, double min_score,
+                                     double max_score)
+            : file_(file_name, std::ifstream::in),
+              in_(file_),
+              delimiter_(delimiter),
+              frame_column_(0),
+              input_format_(input_format),
+              image_width_(image_width),
+              image_height_(image_height),
+              temporal_weight_(temporal_weight),
+              spatial_weight_(spatial_weight),
+              angular_weight_(angular_weight),
+              min_score_(min_score),
+              max_score_(max_score),
+              next_frame_(0),
+              end_(false)
+    {
+        // Only proceed if the file could be opened
+        if (!file_.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        Initialize(header);
+    }
+
+    DetectionStream::DetectionStream(std::istream& in, const std::string& header,
+                                     char delimiter, const std::string& input_format,
+                                     double image_width, double image_height,
+                                     double temporal_weight, double spatial_weight,
+                                     double angular_weight, double min_score,
+                                     double max_score)
+            : in_(in),
+              delimiter_(delimiter),
+              frame_column_(0),
+              input_format_(input_format),
+              image_width_(image_width),
+              image_height_(image_height),
+              temporal_weight_(temporal_weight),
+              spatial_weight_(spatial_weight),
+              angular_weight_(angular_weight),
+              min_score_(min_score),
+              max_score_(max_score),
+              next_frame_(0),
+              end_(false)
+    {
+        Initialize(header);
+    }
+
+    void DetectionStream::Initialize(const std::string& header)
+    {
+        // Fail while opening the stream instead of when parsing the first batch
+        if (input_format_ != "2D" && input_format_ != "Box" && input_format_ != "Angular")
+        {
+            throw "Unknown input format: " + input_format_;
+        }
+
+        std::string line;
+
+        // Use the first line that is not empty as the header if none is given
+        if (header.empty())
+        {
+            while (std::getline(in_, line))
+            {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (line.size() > 0) break;
+            }
+        }
+        else
+        {
+            line = header;
+        }
+
+        keys_ = FileIO::split(line, delimiter_);
+        frame_column_ = keys_.size();
+        for (size_t i = 0; i < keys_.size(); ++i)
+        {
+            if (keys_[i] == "frame")
+            {
+                frame_column_ = i;
+            }
+        }
+
+        if (frame_column_ == keys_.size())
+        {
+            throw "No frame column in header: " + line;
+        }
+    }
+
+    bool DetectionStream::ReadRow(std::vector<double>& row)
+    {
+        std::string line;
+        while (std::getline(in_, line))
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            // Lines without any valid value (like a header line) are skipped
+            row.clear();
+            size_t errors = FileIO::ParseLines(line.data(), line.data() + line.size(),
+                                               delimiter_, keys_.size(), row);
+            if (errors < keys_.size())
+            {
+                return true;
+            }
+        }
+
+        row.clear();
+        return false;
+    }
+
+    size_t DetectionStream::Read(core::DetectionSequence& sequence, size_t frame_count)
+    {
+        util::ScopedTimer timer("read");
+
+        size_t stop = next_frame_ + frame_count;
+        ValueTable values(keys_);
+
+        // Collect all rows up to the first row of a frame after the last frame
+        // to read, that row is kept for the next call
+        while (!end_)
+        {
+            if (pending_row_.empty() && !ReadRow(pending_row_))
+            {
+                end_ = true;
+                break;
+            }
+
+            size_t frame = (size_t) std::fabs(pending_row_[frame_column_]);
+            if (frame >= stop)
+            {
+                break;
+            }
+
+            if (frame < next_frame_)
+            {
+                util::Logger::LogError("detections are not sorted by frame, frame "
+                                       + std::to_string(frame) + " is already read");
+            }
+            else
+            {
+                values.AppendRow(pending_row_);
+            }
+
+            pending_row_.clear();
+        }
+
+        Parser::ParseObjectData(values, sequence, input_format_, image_width_, image_height_,
+                                temporal_weight_, spatial_weight_, angular_weight_,
+                                min_score_, max_score_);
+
+        // Frames without any detection still belong to the sequence
+        if (!end_)
+        {
+            sequence.ExtendFrameCount(stop);
+        }
+        next_frame_ = stop;
+
+        GBMOT_LOG_DEBUG("streamed " + std::to_string(values.GetRowCount())
+                               + " detections up to frame " + std::to_string(stop));
+
+        return values.GetRowCount();
+    }
+
+    size_t DetectionStream::GetNextFrameIndex() const
+    {
+        return next_frame_;
+    }
+
+    bool DetectionStream::IsEnd() const
+    {
+        return end_;
+    }
+}
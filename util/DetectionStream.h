@@ -0,0 +1,172 @@
+#ifndef GBMOT_DETECTIONSTREAM_H
+#define GBMOT_DETECTIONSTREAM_H
+
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+#include "../core/DetectionSequence.h"
+
+namespace util
+{
+    /**
+     * Reads detections from a CSV stream a few frames at a time, thus only the
+     * frames currently needed have to be kept in memory.
+     * The rows have to be sorted by their frame index.
+     * Because the whole input is never known, the detection scores are
+     * normalized with a fixed score range instead of the range of the input.
+     */
+    class DetectionStream
+    {
+    private:
+        /**
+         * The file if the stream was created from a file name
+         */
+        std::ifstream file_;
+
+        /**
+         * The stream to read from
+         */
+        std::istream& in_;
+
+        /**
+         * The value delimiter
+         */
+        char delimiter_;
+
+        /**
+         * The keys of the columns
+         */
+        std::vector<std::string> keys_;
+
+        /**
+         * The index of the frame column
+         */
+        size_t frame_column_;
+
+        /**
+         * The format to parse the detections into
+         */
+        std::string input_format_;
+
+        double image_width_;
+        double image_height_;
+        double temporal_weight_;
+        double spatial_weight_;
+        double angular_weight_;
+        double min_score_;
+        double max_score_;
+
+        /**
+         * The first frame that was not read yet
+         */
+        size_t next_frame_;
+
+        /**
+         * The values of the row that was already read but belongs to a frame
+         * after the last read frame
+         */
+        std::vector<double> pending_row_;
+
+        /**
+         * True, if the end of the stream was reached
+         */
+        bool end_;
+
+        /**
+         * Reads the header if none was given and prepares the column indices.
+         *
+         * @param header A string containing the keys separated by the delimiter,
+         *               if empty the first line of the stream is used
+         */
+        void Initialize(const std::string& header);
+
+        /**
+         * Reads the next row that is not empty.
+         *
+         * @param row The vector to store the values of the row in
+         * @return False, if the end of the stream was reached
+         */
+        bool ReadRow(std::vector<double>& row);
+    public:
+        /**
+         * Creates a stream reading from the specified file.
+         *
+         * @param file_name The name of the file to read
+         * @param header A string containing the keys separated by the delimiter,
+         *               if empty the first line of the file is used
+         * @param delimiter The value delimiter
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         * @param min_score The score that is normalized to zero
+         * @param max_score The score that is normalized to one
+         */
+        DetectionStream(const std::string& file_name, const std::string& header,
+                        char delimiter, const std::string& input_format,
+                        double image_width, double image_height,
+                        double temporal_weight, double spatial_weight,
+                        double angular_weight, double min_score, double max_score);
+
+        /**
+         * Creates a stream reading from the specified input stream.
+         *
+         * @param in The stream to read from, needs to outlive this object
+         * @param header A string containing the keys separated by the delimiter,
+         *               if empty the first line of the stream is used
+         * @param delimiter The value delimiter
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         * @param min_score The score that is normalized to zero
+         * @param max_score The score that is normalized to one
+         */
+        DetectionStream(std::istream& in, const std::string& header,
+                        char delimiter, const std::string& input_format,
+                        double image_width, double image_height,
+                        double temporal_weight, double spatial_weight,
+                        double angular_weight, double min_score, double max_score);
+
+        /**
+         * Reads the detections of the next frames into the given sequence.
+         * The frame count of the sequence is extended to include all read
+         * frames, even if they contain no detections. If the end of the stream
+         * is reached, fewer frames are read.
+         *
+         * @param sequence The sequence to add the read detections to
+         * @param frame_count The number of frames to read
+         * @return The number of read detections
+         */
+        size_t Read(core::DetectionSequence& sequence, size_t frame_count);
+
+        /**
+         * Gets the index of the first frame that was not read yet.
+         *
+         * @return The index of the next frame
+         */
+        size_t GetNextFrameIndex() const;
+
+        /**
+         * Checks if all detections were read.
+         *
+         * @return True, if the end of the stream was reached and no read row
+         *         is left
+         */
+        bool IsEnd() const;
+    };
+}
+
+
+#endif //GBMOT_DETECTIONSTREAM_H
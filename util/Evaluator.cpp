@@ -0,0 +1,610 @@
+#include "Evaluator.h"
+#include "MyMath.h"
+#include "../core/ObjectData2D.h"
+#include "../core/ObjectDataBox.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace util
+{
+    namespace
+    {
+        const size_t NO_INDEX = std::numeric_limits<size_t>::max();
+
+        /**
+         * The geometry of an object in a single frame
+         */
+        struct Shape
+        {
+            size_t track;
+            cv::Point2d position;
+            cv::Point2d size;
+        };
+
+        /**
+         * A ground truth and a track object within the threshold,
+         * the indices are the indices of the shapes in the frame
+         */
+        struct Candidate
+        {
+            size_t ground_truth;
+            size_t hypothesis;
+            double cost;
+        };
+
+        struct FrameData
+        {
+            std::vector<Shape> ground_truth;
+            std::vector<Shape> hypotheses;
+            std::vector<Candidate> candidates;
+        };
+
+        /**
+         * A possible assignment of a row to a column
+         */
+        struct Edge
+        {
+            size_t row;
+            size_t col;
+            double cost;
+        };
+
+        void CollectShapes(const std::vector<core::FrameEntry>& entries,
+                           std::vector<Shape>& shapes)
+        {
+            shapes.reserve(entries.size());
+            for (auto& entry : entries)
+            {
+                if (entry.object->IsVirtual()) continue;
+
+                core::ObjectData2DPtr obj_2d =
+                        std::static_pointer_cast<core::ObjectData2D>(entry.object);
+                core::ObjectDataBoxPtr obj_box =
+                        std::dynamic_pointer_cast<core::ObjectDataBox>(entry.object);
+
+                // Objects without a size have a size of zero
+                Shape shape;
+                shape.track = entry.track;
+                shape.position = obj_2d->GetPosition();
+                shape.size = obj_box ? obj_box->GetSize() : cv::Point2d(0.0, 0.0);
+                shapes.push_back(shape);
+            }
+        }
+
+        /**
+         * Checks that every object of the given tracks has a size, otherwise
+         * the intersection over union of the objects is always zero.
+         */
+        void CheckSizes(const std::vector<core::TrackletPtr>& tracks, const std::string& name)
+        {
+            for (auto& track : tracks)
+            {
+                for (size_t i = 0; i < track->GetPathObjectCount(); ++i)
+                {
+                    core::ObjectDataPtr object = track->GetPathObject(i);
+                    if (!object->IsVirtual() &&
+                            !std::dynamic_pointer_cast<core::ObjectDataBox>(object))
+                    {
+                        throw "The iou match metric needs boxes, found an object without a "
+                              "size in the " + name;
+                    }
+                }
+            }
+        }
+
+        double Overlap(const Shape& a, const Shape& b)
+        {
+            // The position of a box is its top left corner
+            double width = std::min(a.position.x + a.size.x, b.position.x + b.size.x) -
+                           std::max(a.position.x, b.position.x);
+            double height = std::min(a.position.y + a.size.y, b.position.y + b.size.y) -
+                            std::max(a.position.y, b.position.y);
+            if (width <= 0.0 || height <= 0.0)
+            {
+                return 0.0;
+            }
+
+            double intersection = width * height;
+            return intersection / (a.size.x * a.size.y + b.size.x * b.size.y - intersection);
+        }
+
+        void FindCandidates(FrameData& frame, bool use_overlap, double threshold)
+        {
+            if (frame.ground_truth.empty() || frame.hypotheses.empty()) return;
+
+            // Two matching objects are at most one cell apart: their distance
+            // is at most the threshold, the positions of overlapping boxes
+            // are closer than the largest box side
+            double cell_size = threshold;
+            if (use_overlap)
+            {
+                cell_size = 0.0;
+                for (auto& shape : frame.ground_truth)
+                    cell_size = std::max(cell_size, std::max(shape.size.x, shape.size.y));
+                for (auto& shape : frame.hypotheses)
+                    cell_size = std::max(cell_size, std::max(shape.size.x, shape.size.y));
+            }
+            if (cell_size <= 0.0)
+            {
+                cell_size = 1.0;
+            }
+
+            // Sort the track objects by their cell
+            typedef std::tuple<long long, long long, size_t> Cell;
+            std::vector<Cell> cells;
+            cells.reserve(frame.hypotheses.size());
+            for (size_t i = 0; i < frame.hypotheses.size(); ++i)
+            {
+                const Shape& hyp = frame.hypotheses[i];
+                cells.push_back(Cell((long long) std::floor(hyp.position.x / cell_size),
+                                     (long long) std::floor(hyp.position.y / cell_size), i));
+            }
+            std::sort(cells.begin(), cells.end());
+
+            // Look up the track objects in the neighbouring cells of every
+            // ground truth object
+            for (size_t i = 0; i < frame.ground_truth.size(); ++i)
+            {
+                const Shape& gt = frame.ground_truth[i];
+                long long x = (long long) std::floor(gt.position.x / cell_size);
+                long long y = (long long) std::floor(gt.position.y / cell_size);
+                for (long long dx = -1; dx <= 1; ++dx)
+                {
+                    auto it = std::lower_bound(cells.begin(), cells.end(), Cell(x + dx, y - 1, 0));
+                    for (; it != cells.end() && std::get<0>(*it) == x + dx &&
+                           std::get<1>(*it) <= y + 1; ++it)
+                    {
+                        size_t j = std::get<2>(*it);
+                        const Shape& hyp = frame.hypotheses[j];
+                        if (use_overlap)
+                        {
+                            double overlap = Overlap(gt, hyp);
+                            if (overlap > 0.0 && overlap >= threshold)
+                            {
+                                frame.candidates.push_back(Candidate{ i, j, 1.0 - overlap });
+                            }
+                        }
+                        else
+                        {
+                            double distance = MyMath::EuclideanDistance(gt.position, hyp.position);
+                            if (distance <= threshold)
+                            {
+                                frame.candidates.push_back(Candidate{ i, j, distance });
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t FindRoot(std::vector<size_t>& parents, size_t node)
+        {
+            while (parents[node] != node)
+            {
+                parents[node] = parents[parents[node]];
+                node = parents[node];
+            }
+            return node;
+        }
+
+        /**
+         * Finds the assignment of the given edges with the lowest total
+         * cost, unconnected rows and columns are assigned with the missing
+         * cost. The rows and columns connected by edges are solved
+         * independently, most of them are a single pair.
+         */
+        void MatchEdges(const std::vector<Edge>& edges, size_t row_count, size_t col_count,
+                        double missing_cost, std::vector<size_t>& matches)
+        {
+            if (edges.empty()) return;
+
+            std::vector<size_t> parents(row_count + col_count);
+            std::iota(parents.begin(), parents.end(), 0);
+            for (auto& edge : edges)
+            {
+                size_t row_root = FindRoot(parents, edge.row);
+                size_t col_root = FindRoot(parents, row_count + edge.col);
+                parents[col_root] = row_root;
+            }
+
+            // Group the edges by their component
+            std::vector<std::pair<size_t, size_t>> order;
+            order.reserve(edges.size());
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                order.push_back(std::make_pair(FindRoot(parents, edges[i].row), i));
+            }
+            std::sort(order.begin(), order.end());
+
+            std::vector<size_t> rows, cols, assignment;
+            for (size_t begin = 0, end = 0; begin < order.size(); begin = end)
+            {
+                for (end = begin + 1; end < order.size() && order[end].first == order[begin].first;)
+                {
+                    ++end;
+                }
+
+                if (end - begin == 1)
+                {
+                    matches.push_back(order[begin].second);
+                    continue;
+                }
+
+                rows.clear();
+                cols.clear();
+                for (size_t i = begin; i < end; ++i)
+                {
+                    rows.push_back(edges[order[i].second].row);
+                    cols.push_back(edges[order[i].second].col);
+                }
+                std::sort(rows.begin(), rows.end());
+                rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+                std::sort(cols.begin(), cols.end());
+                cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+                std::vector<double> costs(rows.size() * cols.size(), missing_cost);
+                std::vector<size_t> cell_edges(rows.size() * cols.size(), NO_INDEX);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const Edge& edge = edges[order[i].second];
+                    size_t r = std::lower_bound(rows.begin(), rows.end(), edge.row) - rows.begin();
+                    size_t c = std::lower_bound(cols.begin(), cols.end(), edge.col) - cols.begin();
+                    costs[r * cols.size() + c] = edge.cost;
+                    cell_edges[r * cols.size() + c] = order[i].second;
+                }
+
+                Evaluator::SolveAssignment(costs, rows.size(), cols.size(), assignment);
+                for (size_t r = 0; r < rows.size(); ++r)
+                {
+                    if (assignment[r] < cols.size() &&
+                        cell_edges[r * cols.size() + assignment[r]] != NO_INDEX)
+                    {
+                        matches.push_back(cell_edges[r * cols.size() + assignment[r]]);
+                    }
+                }
+            }
+        }
+    }
+
+    Evaluator::Evaluator(const std::vector<core::TrackletPtr>& ground_truth,
+                         const std::string& match_metric, double threshold, size_t thread_count)
+            : ground_truth_(ground_truth),
+              ground_truth_track_count_(ground_truth.size()),
+              threshold_(threshold),
+              thread_count_(thread_count)
+    {
+        if (match_metric == "distance")
+        {
+            use_overlap_ = false;
+        }
+        else if (match_metric == "iou")
+        {
+            use_overlap_ = true;
+            CheckSizes(ground_truth, "ground truth");
+        }
+        else
+        {
+            throw "Unknown match metric: " + match_metric;
+        }
+
+        if (thread_count_ == 0)
+        {
+            thread_count_ = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    EvaluationMetrics Evaluator::Evaluate(const std::vector<core::TrackletPtr>& tracks) const
+    {
+        if (use_overlap_)
+        {
+            CheckSizes(tracks, "tracks");
+        }
+
+        core::FrameIndex hypotheses(tracks);
+
+        // The frame range of the ground truth and the tracks
+        bool has_ground_truth = ground_truth_.GetEndFrameIndex() > ground_truth_.GetFirstFrameIndex();
+        bool has_hypotheses = hypotheses.GetEndFrameIndex() > hypotheses.GetFirstFrameIndex();
+        size_t first_frame = 0, end_frame = 0;
+        if (has_ground_truth && has_hypotheses)
+        {
+            first_frame = std::min(ground_truth_.GetFirstFrameIndex(),
+                                   hypotheses.GetFirstFrameIndex());
+            end_frame = std::max(ground_truth_.GetEndFrameIndex(), hypotheses.GetEndFrameIndex());
+        }
+        else if (has_ground_truth)
+        {
+            first_frame = ground_truth_.GetFirstFrameIndex();
+            end_frame = ground_truth_.GetEndFrameIndex();
+        }
+        else if (has_hypotheses)
+        {
+            first_frame = hypotheses.GetFirstFrameIndex();
+            end_frame = hypotheses.GetEndFrameIndex();
+        }
+
+        // Find the candidates of every frame in parallel
+        std::vector<FrameData> frames(end_frame - first_frame);
+        size_t thread_count = std::max((size_t) 1, std::min(thread_count_, frames.size()));
+        size_t chunk_size = (frames.size() + thread_count - 1) / thread_count;
+        auto find = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                CollectShapes(ground_truth_.GetFrame(first_frame + i), frames[i].ground_truth);
+                CollectShapes(hypotheses.GetFrame(first_frame + i), frames[i].hypotheses);
+                FindCandidates(frames[i], use_overlap_, threshold_);
+            }
+        };
+        if (thread_count == 1)
+        {
+            find(0, frames.size());
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            for (size_t begin = 0; begin < frames.size(); begin += chunk_size)
+            {
+                threads.push_back(std::thread(find, begin,
+                                              std::min(begin + chunk_size, frames.size())));
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        // Match frame by frame, a ground truth object keeps the track of its
+        // last match as long as they are within the threshold
+        EvaluationMetrics metrics = EvaluationMetrics();
+        metrics.frame_count = frames.size();
+        std::vector<size_t> last_match(ground_truth_track_count_, NO_INDEX);
+        std::unordered_map<size_t, size_t> pair_counts;
+        double match_sum = 0.0;
+        std::vector<bool> gt_matched, hyp_matched;
+        std::vector<Edge> open_edges;
+        std::vector<size_t> matches;
+        for (auto& frame : frames)
+        {
+            gt_matched.assign(frame.ground_truth.size(), false);
+            hyp_matched.assign(frame.hypotheses.size(), false);
+            size_t frame_matches = 0;
+
+            for (auto& candidate : frame.candidates)
+            {
+                size_t gt = frame.ground_truth[candidate.ground_truth].track;
+                size_t hyp = frame.hypotheses[candidate.hypothesis].track;
+                ++pair_counts[gt * tracks.size() + hyp];
+
+                if (last_match[gt] == hyp && !hyp_matched[candidate.hypothesis])
+                {
+                    gt_matched[candidate.ground_truth] = true;
+                    hyp_matched[candidate.hypothesis] = true;
+                    match_sum += use_overlap_ ? 1.0 - candidate.cost : candidate.cost;
+                    ++frame_matches;
+                }
+            }
+
+            // The remaining objects are assigned with the most matches first,
+            // the lowest cost second
+            open_edges.clear();
+            double missing_cost = 1.0;
+            for (auto& candidate : frame.candidates)
+            {
+                if (!gt_matched[candidate.ground_truth] && !hyp_matched[candidate.hypothesis])
+                {
+                    open_edges.push_back(Edge{ candidate.ground_truth, candidate.hypothesis,
+                                               candidate.cost });
+                    missing_cost += candidate.cost;
+                }
+            }
+
+            matches.clear();
+            MatchEdges(open_edges, frame.ground_truth.size(), frame.hypotheses.size(),
+                       missing_cost, matches);
+            for (size_t index : matches)
+            {
+                const Edge& edge = open_edges[index];
+                size_t gt = frame.ground_truth[edge.row].track;
+                size_t hyp = frame.hypotheses[edge.col].track;
+                if (last_match[gt] != NO_INDEX && last_match[gt] != hyp)
+                {
+                    ++metrics.id_switch_count;
+                }
+                last_match[gt] = hyp;
+                match_sum += use_overlap_ ? 1.0 - edge.cost : edge.cost;
+                ++frame_matches;
+            }
+
+            metrics.ground_truth_count += frame.ground_truth.size();
+            metrics.hypothesis_count += frame.hypotheses.size();
+            metrics.match_count += frame_matches;
+            metrics.miss_count += frame.ground_truth.size() - frame_matches;
+            metrics.false_positive_count += frame.hypotheses.size() - frame_matches;
+        }
+
+        if (metrics.ground_truth_count > 0)
+        {
+            metrics.mota = 1.0 - (double) (metrics.miss_count + metrics.false_positive_count +
+                                           metrics.id_switch_count) / metrics.ground_truth_count;
+        }
+        if (metrics.match_count > 0)
+        {
+            metrics.motp = match_sum / metrics.match_count;
+        }
+
+        // Match the tracks as a whole, maximizing the number of frames the
+        // matched tracks are within the threshold
+        std::vector<Edge> pairs;
+        pairs.reserve(pair_counts.size());
+        for (auto& pair : pair_counts)
+        {
+            pairs.push_back(Edge{ pair.first / tracks.size(), pair.first % tracks.size(),
+                                  -(double) pair.second });
+        }
+        std::sort(pairs.begin(), pairs.end(), [](const Edge& a, const Edge& b)
+        {
+            return a.row < b.row || (a.row == b.row && a.col < b.col);
+        });
+
+        matches.clear();
+        MatchEdges(pairs, ground_truth_track_count_, tracks.size(), 0.0, matches);
+        for (size_t index : matches)
+        {
+            metrics.id_true_positive_count += (size_t) std::lround(-pairs[index].cost);
+        }
+        metrics.id_false_positive_count = metrics.hypothesis_count - metrics.id_true_positive_count;
+        metrics.id_false_negative_count = metrics.ground_truth_count - metrics.id_true_positive_count;
+
+        if (metrics.hypothesis_count > 0)
+        {
+            metrics.id_precision = (double) metrics.id_true_positive_count / metrics.hypothesis_count;
+        }
+        if (metrics.ground_truth_count > 0)
+        {
+            metrics.id_recall = (double) metrics.id_true_positive_count / metrics.ground_truth_count;
+        }
+        if (metrics.ground_truth_count + metrics.hypothesis_count > 0)
+        {
+            metrics.idf1 = 2.0 * metrics.id_true_positive_count /
+                           (metrics.ground_truth_count + metrics.hypothesis_count);
+        }
+
+        return metrics;
+    }
+
+    std::vector<std::string> Evaluator::GetMetricNames()
+    {
+        return { "mota", "motp", "idf1", "idp", "idr",
+                 "matches", "misses", "false_positives", "id_switches",
+                 "id_true_positives", "id_false_positives", "id_false_negatives",
+                 "ground_truth", "hypotheses", "frames" };
+    }
+
+    std::vector<double> Evaluator::GetMetricValues(const EvaluationMetrics& metrics)
+    {
+        return { metrics.mota, metrics.motp, metrics.idf1, metrics.id_precision,
+                 metrics.id_recall,
+                 (double) metrics.match_count, (double) metrics.miss_count,
+                 (double) metrics.false_positive_count, (double) metrics.id_switch_count,
+                 (double) metrics.id_true_positive_count,
+                 (double) metrics.id_false_positive_count,
+                 (double) metrics.id_false_negative_count,
+                 (double) metrics.ground_truth_count, (double) metrics.hypothesis_count,
+                 (double) metrics.frame_count };
+    }
+
+    void Evaluator::WriteMetrics(const EvaluationMetrics& metrics, std::ostream& out,
+                                 char delimiter)
+    {
+        std::vector<std::string> names = GetMetricNames();
+        std::vector<double> values = GetMetricValues(metrics);
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (i > 0) out << delimiter;
+            out << names[i];
+        }
+        out << "\n";
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i > 0) out << delimiter;
+            out << values[i];
+        }
+        out << "\n";
+    }
+
+    void Evaluator::SolveAssignment(const std::vector<double>& costs, size_t row_count,
+                                    size_t col_count, std::vector<size_t>& assignment)
+    {
+        assignment.assign(row_count, col_count);
+        if (row_count == 0 || col_count == 0) return;
+
+        // The solver needs at least as many columns as rows
+        bool transposed = row_count > col_count;
+        size_t n = transposed ? col_count : row_count;
+        size_t m = transposed ? row_count : col_count;
+        auto cost = [&](size_t i, size_t j)
+        {
+            return transposed ? costs[j * col_count + i] : costs[i * col_count + j];
+        };
+
+        // Hungarian method with potentials, the rows are added one by one and
+        // the assignment is extended along the shortest augmenting path,
+        // index zero is a virtual column
+        const double infinity = std::numeric_limits<double>::infinity();
+        std::vector<double> u(n + 1, 0.0), v(m + 1, 0.0), min_values(m + 1);
+        std::vector<size_t> col_rows(m + 1, 0), way(m + 1, 0);
+        std::vector<bool> used(m + 1);
+        for (size_t i = 1; i <= n; ++i)
+        {
+            col_rows[0] = i;
+            size_t j0 = 0;
+            std::fill(min_values.begin(), min_values.end(), infinity);
+            std::fill(used.begin(), used.end(), false);
+            do
+            {
+                used[j0] = true;
+                size_t i0 = col_rows[j0], j1 = 0;
+                double delta = infinity;
+                for (size_t j = 1; j <= m; ++j)
+                {
+                    if (used[j]) continue;
+
+                    double current = cost(i0 - 1, j - 1) - u[i0] - v[j];
+                    if (current < min_values[j])
+                    {
+                        min_values[j] = current;
+                        way[j] = j0;
+                    }
+                    if (min_values[j] < delta)
+                    {
+                        delta = min_values[j];
+                        j1 = j;
+                    }
+                }
+                for (size_t j = 0; j <= m; ++j)
+                {
+                    if (used[j])
+                    {
+                        u[col_rows[j]] += delta;
+                        v[j] -= delta;
+                    }
+                    else
+                    {
+                        min_values[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            }
+            while (col_rows[j0] != 0);
+
+            do
+            {
+                size_t j1 = way[j0];
+                col_rows[j0] = col_rows[j1];
+                j0 = j1;
+            }
+            while (j0 != 0);
+        }
+
+        for (size_t j = 1; j <= m; ++j)
+        {
+            if (col_rows[j] == 0) continue;
+
+            if (transposed)
+            {
+                assignment[j - 1] = col_rows[j] - 1;
+            }
+            else
+            {
+                assignment[col_rows[j] - 1] = j - 1;
+            }
+        }
+    }
+}
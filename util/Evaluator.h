@@ -0,0 +1,161 @@
+#ifndef GBMOT_EVALUATOR_H
+#define GBMOT_EVALUATOR_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../core/FrameIndex.h"
+#include "../core/Tracklet.h"
+
+namespace util
+{
+    /**
+     * The CLEAR MOT and identity metrics of a set of tracks.
+     */
+    struct EvaluationMetrics
+    {
+        size_t frame_count;
+
+        /**
+         * The number of ground truth and track objects in all frames
+         */
+        size_t ground_truth_count;
+        size_t hypothesis_count;
+
+        /**
+         * (CLEAR MOT) The frame by frame matching results
+         */
+        size_t match_count;
+        size_t miss_count;
+        size_t false_positive_count;
+        size_t id_switch_count;
+
+        /**
+         * (CLEAR MOT) The multiple object tracking accuracy and precision.
+         * The precision is the mean distance of all matches, or the mean
+         * intersection over union when matching with iou.
+         */
+        double mota;
+        double motp;
+
+        /**
+         * (Identity) The results of the global matching of the tracks
+         */
+        size_t id_true_positive_count;
+        size_t id_false_positive_count;
+        size_t id_false_negative_count;
+        double idf1;
+        double id_precision;
+        double id_recall;
+    };
+
+    /**
+     * Evaluates tracks against ground truth tracks.
+     * The objects of every frame are matched by looking up the candidates
+     * within the threshold in a uniform grid over the track positions and
+     * an optimal assignment of the candidates. The candidates are found for
+     * all frames in parallel, the matching itself runs frame by frame
+     * because a match is kept as long as it is valid.
+     * The ground truth is indexed once, thus a single evaluator can be used
+     * concurrently for multiple sets of tracks.
+     */
+    class Evaluator
+    {
+    private:
+        /**
+         * The ground truth objects, frame by frame
+         */
+        core::FrameIndex ground_truth_;
+
+        /**
+         * The number of ground truth tracks
+         */
+        size_t ground_truth_track_count_;
+
+        /**
+         * True, if the objects are matched by the intersection over union of
+         * their boxes, false, if they are matched by the distance of their
+         * positions
+         */
+        bool use_overlap_;
+
+        /**
+         * The maximum distance or the minimum intersection over union of
+         * two matched objects
+         */
+        double threshold_;
+
+        /**
+         * The number of threads finding the candidates
+         */
+        size_t thread_count_;
+    public:
+        /**
+         * Creates a new evaluator for the given ground truth.
+         *
+         * @param ground_truth The ground truth tracks
+         * @param match_metric The metric to match objects with: distance for
+         *                     the euclidean distance of the object positions
+         *                     or iou for the intersection over union of the
+         *                     boxes
+         * @param threshold The maximum distance or the minimum intersection
+         *                  over union of two matched objects
+         * @param thread_count The number of threads, zero uses all available
+         *                     hardware threads
+         */
+        Evaluator(const std::vector<core::TrackletPtr>& ground_truth,
+                  const std::string& match_metric, double threshold, size_t thread_count);
+
+        /**
+         * Evaluates the given tracks.
+         *
+         * @param tracks The tracks to evaluate
+         * @return The metrics of the tracks
+         */
+        EvaluationMetrics Evaluate(const std::vector<core::TrackletPtr>& tracks) const;
+
+        /**
+         * Gets the names of the metrics written by WriteMetrics.
+         *
+         * @return The column names
+         */
+        static std::vector<std::string> GetMetricNames();
+
+        /**
+         * Gets the metric values in the order of GetMetricNames.
+         *
+         * @param metrics The metrics
+         * @return The column values
+         */
+        static std::vector<double> GetMetricValues(const EvaluationMetrics& metrics);
+
+        /**
+         * Writes the metrics as a header line and a value line.
+         *
+         * @param metrics The metrics to write
+         * @param out The stream to write into
+         * @param delimiter The delimiter used to separate values
+         */
+        static void WriteMetrics(const EvaluationMetrics& metrics, std::ostream& out,
+                                 char delimiter);
+
+        /**
+         * Finds the assignment of rows to columns with the lowest total cost.
+         * Every row or every column, whichever are fewer, is assigned.
+         *
+         * @param costs The row major cost matrix
+         * @param row_count The number of rows
+         * @param col_count The number of columns
+         * @param assignment The vector to store the column of every row in,
+         *                   rows without a column get the column count
+         */
+        static void SolveAssignment(const std::vector<double>& costs, size_t row_count,
+                                    size_t col_count, std::vector<size_t>& assignment);
+    };
+
+    typedef std::shared_ptr<Evaluator> EvaluatorPtr;
+}
+
+
+#endif //GBMOT_EVALUATOR_H
@@ -3,16 +3,273 @@
 //
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <thread>
 #include "FileIO.h"
 #include "Logger.h"
 #include "dirent.h"
-#include "../core/ObjectData2D.h"
+#include "../core/ObjectDataAngular.h"
+#include "../core/ObjectDataBox.h"
+#include "../core/FrameIndex.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdio>
 
 namespace util
 {
+    namespace
+    {
+        /**
+         * Signature at the start of every binary detection file
+         */
+        const char DETECTION_FILE_MAGIC[8] = {'G', 'B', 'M', 'O', 'T', 'D', 'E', 'T'};
+
+        /**
+         * Version of the binary detection file layout
+         */
+        const uint32_t DETECTION_FILE_VERSION = 1;
+
+        /**
+         * Size of the buffer after which the formatted output is written
+         */
+        const size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+        /**
+         * Header of a binary detection file.
+         * Followed by frame_count + 1 frame offsets (uint64) and column_count
+         * columns of object_count values (double) each.
+         * The column order is x, y, score followed by width, height (Box) or
+         * angle (Angular).
+         */
+        struct DetectionFileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t model;
+            uint64_t frame_count;
+            uint64_t object_count;
+            uint32_t column_count;
+            uint32_t reserved;
+        };
+
+        const uint32_t MODEL_2D = 0;
+        const uint32_t MODEL_BOX = 1;
+        const uint32_t MODEL_ANGULAR = 2;
+
+        /**
+         * Signature at the start of every binary track file
+         */
+        const char TRACK_FILE_MAGIC[8] = {'G', 'B', 'M', 'O', 'T', 'T', 'R', 'K'};
+
+        /**
+         * Version of the binary track file layout
+         */
+        const uint32_t TRACK_FILE_VERSION = 1;
+
+        /**
+         * Header of a binary track file.
+         * Followed by track_count + 1 track offsets (uint64), one frame column
+         * (uint64) and column_count columns (double) of object_count values
+         * each. The objects of a track are stored consecutively and sorted by
+         * frame. The column order is the same as in a binary detection file.
+         */
+        struct TrackFileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t model;
+            uint64_t track_count;
+            uint64_t object_count;
+            uint32_t column_count;
+            uint32_t reserved;
+        };
+
+        /**
+         * Signature at the start of every binary graph file
+         */
+        const char GRAPH_FILE_MAGIC[8] = {'G', 'B', 'M', 'O', 'T', 'G', 'R', 'F'};
+
+        /**
+         * Version of the binary graph file layout
+         */
+        const uint32_t GRAPH_FILE_VERSION = 1;
+
+        /**
+         * Header of a binary graph file.
+         * Followed by the graph in compressed sparse row form:
+         * vertex_count + 1 edge offsets (uint64), one frame index per vertex
+         * (int64, -1 for virtual vertices), edge_count target vertices (uint64)
+         * and edge_count edge weights (double). The outgoing edges of vertex i
+         * are [offsets[i], offsets[i + 1]).
+         */
+        struct GraphFileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t solver;
+            uint64_t vertex_count;
+            uint64_t edge_count;
+            uint64_t source;
+            uint64_t sink;
+        };
+
+        /**
+         * A read only memory mapping of a whole file, unmapped on destruction.
+         */
+        class MappedFile
+        {
+        public:
+            const char* data;
+            size_t size;
+
+            MappedFile(const std::string& file_name)
+            {
+                int fd = open(file_name.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    throw "Unable to open file: " + file_name;
+                }
+
+                struct stat file_stat;
+                if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+                {
+                    close(fd);
+                    throw "Unable to map file: " + file_name;
+                }
+
+                size = (size_t) file_stat.st_size;
+                void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                close(fd);
+                if (mapping == MAP_FAILED)
+                {
+                    throw "Unable to map file: " + file_name;
+                }
+
+                data = static_cast<const char*>(mapping);
+            }
+
+            ~MappedFile()
+            {
+                munmap(const_cast<char*>(data), size);
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+        };
+
+        /**
+         * Gets the binary model code of the given object.
+         */
+        uint32_t GetModel(const core::ObjectDataPtr& obj)
+        {
+            if (std::dynamic_pointer_cast<core::ObjectDataBox>(obj))
+            {
+                return MODEL_BOX;
+            }
+            if (std::dynamic_pointer_cast<core::ObjectDataAngular>(obj))
+            {
+                return MODEL_ANGULAR;
+            }
+            return MODEL_2D;
+        }
+
+        /**
+         * Gets the number of double columns stored for the given model.
+         */
+        uint32_t GetColumnCount(uint32_t model)
+        {
+            switch (model)
+            {
+                case MODEL_BOX:
+                    return 5;
+                case MODEL_ANGULAR:
+                    return 4;
+                default:
+                    return 3;
+            }
+        }
+
+        /**
+         * Adds the size of the given number of elements to the given size.
+         *
+         * @param size The size to add to
+         * @param count The number of elements
+         * @param element_size The size of a single element
+         * @return False, if the resulting size does not fit into a size_t
+         */
+        bool AddSize(size_t& size, uint64_t count, uint64_t element_size)
+        {
+            if (element_size != 0 &&
+                    count > (std::numeric_limits<size_t>::max() - size) / element_size)
+            {
+                return false;
+            }
+
+            size += count * element_size;
+            return true;
+        }
+
+        /**
+         * Checks if the given offsets split the elements into consecutive
+         * ranges, i.e. they never decrease and never exceed the element count.
+         *
+         * @param offsets The range_count + 1 offsets
+         * @param range_count The number of ranges
+         * @param element_count The number of elements
+         * @return True, if all offsets are valid
+         */
+        bool IsValidOffsets(const uint64_t* offsets, uint64_t range_count,
+                            uint64_t element_count)
+        {
+            for (uint64_t i = 0; i < range_count; ++i)
+            {
+                if (offsets[i] > offsets[i + 1])
+                {
+                    return false;
+                }
+            }
+
+            return offsets[range_count] <= element_count;
+        }
+
+        /**
+         * Parses a double value of a delimited field.
+         *
+         * @param part The first character of the field
+         * @param part_end The character after the last character of the field
+         * @param value The parsed value
+         * @return False, if the field is empty or not a valid value
+         */
+        bool ParseField(const char* part, const char* part_end, double& value)
+        {
+            if (part == part_end)
+            {
+                return false;
+            }
+
+            char* parsed_end;
+            value = std::strtod(part, &parsed_end);
+
+            return parsed_end != part && parsed_end <= part_end;
+        }
+    }
+
+    const uint32_t FileIO::GRAPH_SOLVER_K_SHORTEST_PATHS = 0;
+    const uint32_t FileIO::GRAPH_SOLVER_ITERATIVE_DIJKSTRA = 1;
+
     void FileIO::ReadCSV(Vector3d& values, const std::string& file_name, char delimiter)
     {
-        Logger::LogInfo("Read CSV file");
+        GBMOT_LOG_INFO("Read CSV file");
 
         std::ifstream in(file_name, std::ifstream::in);
         std::string line;
@@ -63,12 +320,12 @@ namespace util
 
         in.close();
 
-        Logger::LogDebug("frame count " + std::to_string(values.size()));
+        GBMOT_LOG_DEBUG("frame count " + std::to_string(values.size()));
     }
 
     void FileIO::ReadCSV(Vector2d& values, const std::string& file_name, char delimiter)
     {
-        Logger::LogInfo("Read CSV file");
+        GBMOT_LOG_INFO("Read CSV file");
 
         std::ifstream in(file_name, std::ifstream::in);
         std::string line;
@@ -107,13 +364,13 @@ namespace util
 
         in.close();
 
-        Logger::LogDebug("line count " + std::to_string(values.size()));
+        GBMOT_LOG_DEBUG("line count " + std::to_string(values.size()));
     }
 
     void FileIO::ListFiles(const std::string& folder, std::vector<std::string>& file_names,
                            bool sort)
     {
-        Logger::LogInfo("List files in folder");
+        GBMOT_LOG_INFO("List files in folder");
 
         DIR* dir;
         struct dirent *ent;
@@ -135,7 +392,7 @@ namespace util
                 std::sort(file_names.begin(), file_names.end());
             }
 
-            Logger::LogDebug("file count " + std::to_string(file_names.size()));
+            GBMOT_LOG_DEBUG("file count " + std::to_string(file_names.size()));
         }
         else
         {
@@ -171,6 +428,150 @@ namespace util
         out.close();
     }
 
+    void FileIO::WriteGraphBinary(DirectedGraph& graph, Vertex source, Vertex sink,
+                                  uint32_t solver, const std::string& file_name)
+    {
+        GraphFileHeader header;
+        std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+        header.version = GRAPH_FILE_VERSION;
+        header.solver = solver;
+        header.vertex_count = boost::num_vertices(graph);
+        header.edge_count = boost::num_edges(graph);
+
+        // Iterate all outgoing edges of every vertex in order
+        EdgeWeightMap weights = boost::get(boost::edge_weight, graph);
+        VertexIndexMap indices = boost::get(boost::vertex_index, graph);
+        VertexValueMap values = boost::get(boost::vertex_name, graph);
+        header.source = indices[source];
+        header.sink = indices[sink];
+
+        std::vector<uint64_t> offsets;
+        std::vector<int64_t> frames;
+        std::vector<uint64_t> targets;
+        std::vector<double> edge_weights;
+        offsets.reserve(header.vertex_count + 1);
+        frames.reserve(header.vertex_count);
+        targets.reserve(header.edge_count);
+        edge_weights.reserve(header.edge_count);
+        offsets.push_back(0);
+        VertexIter vi, vi_end;
+        OutEdgeIter oei, oei_end;
+        for (boost::tie(vi, vi_end) = boost::vertices(graph); vi != vi_end; ++vi)
+        {
+            core::ObjectDataPtr value = values[*vi];
+            frames.push_back((!value || value->IsVirtual()) ? -1 :
+                             (int64_t) value->GetFrameIndex());
+
+            for (boost::tie(oei, oei_end) = boost::out_edges(*vi, graph);
+                 oei != oei_end; ++oei)
+            {
+                targets.push_back(indices[boost::target(*oei, graph)]);
+                edge_weights.push_back(weights[*oei]);
+            }
+
+            offsets.push_back(targets.size());
+        }
+
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()),
+                  offsets.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(frames.data()),
+                  frames.size() * sizeof(int64_t));
+        out.write(reinterpret_cast<const char*>(targets.data()),
+                  targets.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(edge_weights.data()),
+                  edge_weights.size() * sizeof(double));
+
+        out.close();
+
+        GBMOT_LOG_DEBUG("graph written " + file_name);
+    }
+
+    void FileIO::ReadGraphBinary(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                                 uint32_t& solver, const std::string& file_name)
+    {
+        MappedFile file(file_name);
+
+        const GraphFileHeader* header = reinterpret_cast<const GraphFileHeader*>(file.data);
+        if (file.size < sizeof(GraphFileHeader))
+        {
+            throw "Invalid graph file: " + file_name;
+        }
+
+        // The counts are read from the file, so the sizes are checked for overflows
+        size_t expected_size = sizeof(GraphFileHeader);
+        if (std::memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+                header->version != GRAPH_FILE_VERSION ||
+                header->solver > GRAPH_SOLVER_ITERATIVE_DIJKSTRA ||
+                !AddSize(expected_size, header->vertex_count,
+                         sizeof(uint64_t) + sizeof(int64_t)) ||
+                !AddSize(expected_size, 1, sizeof(uint64_t)) ||
+                !AddSize(expected_size, header->edge_count, sizeof(uint64_t) + sizeof(double)) ||
+                file.size < expected_size ||
+                header->source >= header->vertex_count || header->sink >= header->vertex_count)
+        {
+            throw "Invalid graph file: " + file_name;
+        }
+
+        const uint64_t* offsets = reinterpret_cast<const uint64_t*>(header + 1);
+        const int64_t* frames = reinterpret_cast<const int64_t*>(offsets + header->vertex_count + 1);
+        const uint64_t* targets = reinterpret_cast<const uint64_t*>(frames + header->vertex_count);
+        const double* weights = reinterpret_cast<const double*>(targets + header->edge_count);
+
+        // Check the edges before the graph is modified
+        if (!IsValidOffsets(offsets, header->vertex_count, header->edge_count))
+        {
+            throw "Invalid edge offsets in graph file: " + file_name;
+        }
+        for (uint64_t e = 0; e < offsets[header->vertex_count]; ++e)
+        {
+            if (targets[e] >= header->vertex_count)
+            {
+                throw "Invalid edge target in graph file: " + file_name;
+            }
+        }
+
+        // The vertices only keep their frame, virtual vertices stay virtual
+        size_t first_vertex = boost::num_vertices(graph);
+        for (uint64_t i = 0; i < header->vertex_count; ++i)
+        {
+            core::ObjectDataPtr value;
+            if (frames[i] < 0)
+            {
+                value.reset(new core::ObjectData());
+            }
+            else
+            {
+                value.reset(new core::ObjectData((size_t) frames[i]));
+            }
+
+            boost::add_vertex(value, graph);
+        }
+
+        // Add the edges in the same order as they were written
+        for (uint64_t i = 0; i < header->vertex_count; ++i)
+        {
+            for (uint64_t e = offsets[i]; e < offsets[i + 1]; ++e)
+            {
+                boost::add_edge(first_vertex + i, first_vertex + targets[e], weights[e], graph);
+            }
+        }
+
+        source = first_vertex + header->source;
+        sink = first_vertex + header->sink;
+        solver = header->solver;
+
+        GBMOT_LOG_DEBUG("vertex count " + std::to_string(header->vertex_count));
+        GBMOT_LOG_DEBUG("edge count " + std::to_string(header->edge_count));
+    }
+
     void FileIO::WriteCSVMatlab(MultiPredecessorMap& map, Vertex& source, Vertex& sink,
                                 const std::string& file_name)
     {
@@ -225,7 +626,7 @@ namespace util
     void FileIO::ReadCSV(ValueMapVector& values, const std::string& header,
                          const std::string& file_name, char delimiter)
     {
-        Logger::LogInfo("Read CSV file");
+        GBMOT_LOG_INFO("Read CSV file");
 
         // Read the file
         std::ifstream in(file_name, std::ifstream::in);
@@ -253,10 +654,10 @@ namespace util
         }
         while (d_index != std::string::npos);
 
-        util::Logger::LogDebug("parsed keys:");
+        GBMOT_LOG_DEBUG("parsed keys:");
         for (std::string str : key_vector)
         {
-            util::Logger::LogDebug(str);
+            GBMOT_LOG_DEBUG(str);
         }
 
         // Read lines while the reader is in good condition and the
@@ -301,109 +702,1148 @@ namespace util
             values.push_back(detection_values);
         }
 
-        util::Logger::LogDebug("parsed values in line 2:");
+        GBMOT_LOG_DEBUG("parsed values in line 2:");
         for (std::string str : key_vector)
         {
-            util::Logger::LogDebug(str + "=" + std::to_string(values[1][str]));
+            GBMOT_LOG_DEBUG(str + "=" + std::to_string(values[1][str]));
         }
 
         in.close();
     }
 
-    void FileIO::WriteTracks(std::vector<core::TrackletPtr>& tracks, const std::string& file_name,
-                             char delimiter)
+    void FileIO::ReadCSVParallel(ValueMapVector& values, const std::string& file_name,
+                                 char delimiter, size_t thread_count)
     {
-        // Get the frame range
-        size_t first_frame = tracks[0]->GetFirstFrameIndex();
-        size_t last_frame = tracks[0]->GetLastFrameIndex();
-        for (auto track : tracks)
+        ReadCSVParallel(values, ReadHeader(file_name), file_name, delimiter, thread_count);
+    }
+
+    void FileIO::ReadCSVParallel(ValueMapVector& values, const std::string& header,
+                                 const std::string& file_name, char delimiter,
+                                 size_t thread_count)
+    {
+        std::vector<std::string> keys;
+        std::vector<ValueMapVector> chunks;
+
+        // Convert the values of every chunk into maps in the parsing thread
+        ParseChunks(header, file_name, delimiter, thread_count, keys,
+                    [&](size_t chunk_count)
+                    {
+                        chunks.resize(chunk_count);
+                    },
+                    [&](size_t chunk_index, std::vector<double>& chunk_values)
+                    {
+                        ValueMapVector& chunk = chunks[chunk_index];
+                        chunk.resize(chunk_values.size() / keys.size());
+                        for (size_t row = 0; row < chunk.size(); ++row)
+                        {
+                            for (size_t key = 0; key < keys.size(); ++key)
+                            {
+                                chunk[row][keys[key]] = chunk_values[row * keys.size() + key];
+                            }
+                        }
+                    });
+
+        // Concatenate the chunks in file order
+        size_t total = values.size();
+        for (auto& chunk : chunks)
+        {
+            total += chunk.size();
+        }
+        values.reserve(total);
+        for (auto& chunk : chunks)
         {
-            if (track->GetFirstFrameIndex() < first_frame)
-                first_frame = track->GetFirstFrameIndex();
-            if (track->GetLastFrameIndex() > last_frame)
-                last_frame = track->GetLastFrameIndex();
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(values));
+            ValueMapVector().swap(chunk);
         }
 
-        std::ofstream out(file_name, std::ios::out);
+        GBMOT_LOG_DEBUG("line count " + std::to_string(values.size()));
+    }
 
-        if (!out.is_open())
+    void FileIO::ReadCSVParallel(ValueTable& values, const std::string& file_name,
+                                 char delimiter, size_t thread_count)
+    {
+        ReadCSVParallel(values, ReadHeader(file_name), file_name, delimiter, thread_count);
+    }
+
+    void FileIO::ReadCSVParallel(ValueTable& values, const std::string& header,
+                                 const std::string& file_name, char delimiter,
+                                 size_t thread_count)
+    {
+        std::vector<std::string> keys;
+        std::vector<ValueTable> chunks;
+
+        // Transpose the values of every chunk into columns in the parsing thread
+        ParseChunks(header, file_name, delimiter, thread_count, keys,
+                    [&](size_t chunk_count)
+                    {
+                        chunks.assign(chunk_count, ValueTable(keys));
+                    },
+                    [&](size_t chunk_index, std::vector<double>& chunk_values)
+                    {
+                        chunks[chunk_index].AppendRows(chunk_values);
+                    });
+
+        // Concatenate the chunks in file order
+        if (values.GetColumnCount() == 0)
         {
-            util::Logger::LogError("Unable to open file: " + file_name);
-            return;
+            values = ValueTable(keys);
+        }
+        size_t total = values.GetRowCount();
+        for (auto& chunk : chunks)
+        {
+            total += chunk.GetRowCount();
+        }
+        values.Reserve(total);
+        for (auto& chunk : chunks)
+        {
+            values.AppendRows(chunk);
+            chunk = ValueTable();
         }
 
-        for (size_t frame = first_frame; frame <= last_frame; ++frame)
+        GBMOT_LOG_DEBUG("line count " + std::to_string(values.GetRowCount()));
+    }
+
+    void FileIO::ParseCSV(ValueTable& values, const std::string& header,
+                          const char* begin, const char* end, char delimiter)
+    {
+        while (begin < end && (*begin == '\n' || *begin == '\r'))
         {
-            for (size_t i = 0; i < tracks.size(); ++i)
-            {
-                core::ObjectData2DPtr obj =
-                        std::static_pointer_cast<core::ObjectData2D>(tracks[i]->GetFrameObject(frame));
+            ++begin;
+        }
 
-                if (obj != nullptr)
-                {
-                    out << obj->GetPosition().x << delimiter;
-                    out << obj->GetPosition().y;
-                }
-                else
-                {
-                    out << delimiter;
-                }
+        // Take the header from the first line or skip it
+        const char* line_end = std::find(begin, end, '\n');
+        std::string first_line(begin, line_end);
+        if (!first_line.empty() && first_line.back() == '\r')
+        {
+            first_line.pop_back();
+        }
+        std::string keys_line = header.empty() ? first_line : header;
+        if (header.empty() || first_line == header)
+        {
+            begin = std::min(line_end + 1, end);
+        }
 
-                if (i < (tracks.size() - 1))
-                {
-                    out << delimiter;
-                }
-            }
+        std::vector<std::string> keys = split(keys_line, delimiter);
+        if (keys.empty() || keys_line.empty())
+        {
+            throw "No keys in header: " + keys_line;
+        }
 
-            out << std::endl;
+        std::vector<double> row_values;
+        size_t errors = ParseLines(begin, end, delimiter, keys.size(), row_values);
+        if (errors > 0)
+        {
+            Logger::LogError(std::to_string(errors) + " values could not be parsed");
         }
 
-        out.close();
+        // A table filled before needs the same keys
+        ValueTable rows(keys);
+        rows.AppendRows(row_values);
+        if (values.GetColumnCount() == 0)
+        {
+            values = std::move(rows);
+        }
+        else
+        {
+            values.AppendRows(rows);
+        }
     }
 
-    void FileIO::ReadTracks(std::vector<core::TrackletPtr>& tracks, const std::string& file_name,
-                            char delimiter)
+    std::string FileIO::ReadHeader(const std::string& file_name)
     {
-        std::ifstream in(file_name, std::ios::in);
+        std::ifstream in(file_name, std::ifstream::in);
 
+        // Only proceed if the file could be opened
         if (!in.is_open())
         {
-            util::Logger::LogError("Unable to open file: " + file_name);
-            return;
+            throw "Unable to open file: " + file_name;
         }
 
         std::string line;
-        size_t line_index = 0;
+
+        // Get the first line that is not empty
         while (in.good() && !in.eof())
         {
             getline(in, line);
 
-            if (line.size() == 0) continue;
+            if (line.size() > 0) break;
+        }
+
+        in.close();
 
-            std::vector<std::string> parts = split(line, delimiter);
+        return line;
+    }
 
-            while (tracks.size() < (parts.size() / 2))
-            {
-                tracks.push_back(core::TrackletPtr(new core::Tracklet()));
-            }
+    void FileIO::ParseChunks(const std::string& header, const std::string& file_name,
+                             char delimiter, size_t thread_count,
+                             std::vector<std::string>& keys,
+                             const std::function<void(size_t)>& prepare,
+                             const std::function<void(size_t, std::vector<double>&)>& consume)
+    {
+        GBMOT_LOG_INFO("Read CSV file in parallel");
+
+        auto begin_time = std::chrono::steady_clock::now();
+
+        std::string buffer;
+        ReadFile(buffer, file_name);
+
+        // Split the header into separate keys
+        keys = split(header, delimiter);
+        if (keys.empty())
+        {
+            throw "No keys in header of file: " + file_name;
+        }
+
+        // If the header is part of the file, skip the header line
+        const char* data_begin = buffer.data();
+        const char* data_end = buffer.data() + buffer.size();
+        while (data_begin < data_end && (*data_begin == '\n' || *data_begin == '\r'))
+        {
+            ++data_begin;
+        }
+        const char* line_end = std::find(data_begin, data_end, '\n');
+        std::string first_line(data_begin, line_end);
+        std::string header_line = header;
+        if (!first_line.empty() && first_line.back() == '\r')
+        {
+            first_line.pop_back();
+        }
+        if (!header_line.empty() && header_line.back() == '\r')
+        {
+            header_line.pop_back();
+        }
+        if (first_line == header_line)
+        {
+            data_begin = std::min(line_end + 1, data_end);
+        }
+
+        if (thread_count == 0)
+        {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        std::vector<const char*> bounds = SplitLines(data_begin, data_end, thread_count);
+        size_t chunk_count = bounds.size() - 1;
 
-            for (size_t i = 1; i < parts.size(); i += 2)
+        GBMOT_LOG_DEBUG("chunk count " + std::to_string(chunk_count));
+
+        prepare(chunk_count);
+
+        // Parse every chunk in its own thread, the errors of a thread are
+        // rethrown by the calling thread
+        std::vector<size_t> chunk_errors(chunk_count, 0);
+        std::vector<std::exception_ptr> chunk_exceptions(chunk_count);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < chunk_count; ++i)
+        {
+            threads.push_back(std::thread([&, i]()
             {
-                if (!parts[i - 1].empty() && !parts[i].empty())
+                try
                 {
-                    cv::Point2d point(std::stod(parts[i - 1]), std::stod(parts[i]));
-
-                    tracks[(i - 1) / 2]->AddPathObject(
-                            core::ObjectData2DPtr(new core::ObjectData2D(line_index, point)));
+                    std::vector<double> chunk_values;
+                    chunk_errors[i] = ParseLines(bounds[i], bounds[i + 1], delimiter,
+                                                 keys.size(), chunk_values);
+                    consume(i, chunk_values);
+                }
+                catch (...)
+                {
+                    chunk_exceptions[i] = std::current_exception();
                 }
+            }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (auto& exception : chunk_exceptions)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
             }
+        }
 
-            line_index++;
+        size_t errors = 0;
+        for (size_t chunk_error : chunk_errors)
+        {
+            errors += chunk_error;
+        }
+        if (errors > 0)
+        {
+            Logger::LogError(std::to_string(errors) + " values could not be parsed");
+        }
+
+        double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - begin_time).count();
+        double megabytes = buffer.size() / (1024.0 * 1024.0);
+        GBMOT_LOG_INFO("Parsed " + std::to_string(megabytes) + " MB with "
+                        + std::to_string(chunk_count) + " threads in "
+                        + std::to_string(seconds) + " s ("
+                        + std::to_string(seconds > 0.0 ? megabytes / seconds : 0.0) + " MB/s)");
+    }
+
+    void FileIO::ReadFile(std::string& buffer, const std::string& file_name)
+    {
+        std::ifstream in(file_name, std::ifstream::in | std::ifstream::binary);
+
+        // Only proceed if the file could be opened
+        if (!in.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        in.seekg(0, std::ios::end);
+        std::streamoff size = in.tellg();
+        in.seekg(0, std::ios::beg);
+
+        if (size > 0)
+        {
+            buffer.resize((size_t) size);
+            in.read(&buffer[0], size);
+            buffer.resize((size_t) in.gcount());
+        }
+        else
+        {
+            // The size is unknown (e.g. a pipe), read until the end of the stream
+            buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
         }
 
         in.close();
     }
 
+    std::vector<const char*> FileIO::SplitLines(const char* begin, const char* end,
+                                                size_t chunk_count)
+    {
+        std::vector<const char*> bounds;
+        bounds.push_back(begin);
+
+        size_t chunk_size = (end - begin) / std::max((size_t) 1, chunk_count) + 1;
+        const char* position = begin;
+        while (position < end)
+        {
+            // Move the approximate chunk end to the next line break
+            const char* chunk_end = position + std::min(chunk_size, (size_t) (end - position));
+            chunk_end = std::find(chunk_end - 1, end, '\n');
+            position = (chunk_end == end) ? end : chunk_end + 1;
+
+            bounds.push_back(position);
+        }
+
+        if (bounds.size() == 1)
+        {
+            bounds.push_back(end);
+        }
+
+        return bounds;
+    }
+
+    size_t FileIO::ParseLines(const char* begin, const char* end, char delimiter,
+                              size_t key_count, std::vector<double>& values)
+    {
+        size_t errors = 0;
+        const char* position = begin;
+        while (position < end)
+        {
+            const char* line_end = std::find(position, end, '\n');
+
+            // Ignore empty lines (and a trailing carriage return)
+            const char* content_end = line_end;
+            if (content_end > position && *(content_end - 1) == '\r')
+            {
+                --content_end;
+            }
+            if (content_end == position)
+            {
+                position = line_end + 1;
+                continue;
+            }
+
+            // Extract the values, values not present in the line are zero
+            const char* part = position;
+            for (size_t key_index = 0; key_index < key_count; ++key_index)
+            {
+                double value = 0.0;
+
+                if (part <= content_end)
+                {
+                    const char* part_end = std::find(part, content_end, delimiter);
+
+                    // Parse with float precision like the sequential reader does
+                    char* parsed_end;
+                    value = std::strtof(part, &parsed_end);
+                    if (parsed_end == part || parsed_end > part_end)
+                    {
+                        value = 0.0;
+                        ++errors;
+                    }
+
+                    part = part_end + 1;
+                }
+
+                values.push_back(value);
+            }
+
+            position = line_end + 1;
+        }
+
+        return errors;
+    }
+
+    void FileIO::WriteDetections(const core::DetectionSequence& sequence,
+                                 const std::string& input_format,
+                                 const std::string& file_name)
+    {
+        GBMOT_LOG_INFO("Write detection file");
+
+        DetectionFileHeader header;
+        std::memcpy(header.magic, DETECTION_FILE_MAGIC, sizeof(header.magic));
+        header.version = DETECTION_FILE_VERSION;
+        header.reserved = 0;
+        if (input_format == "2D")
+        {
+            header.model = MODEL_2D;
+            header.column_count = 3;
+        }
+        else if (input_format == "Box")
+        {
+            header.model = MODEL_BOX;
+            header.column_count = 5;
+        }
+        else if (input_format == "Angular")
+        {
+            header.model = MODEL_ANGULAR;
+            header.column_count = 4;
+        }
+        else
+        {
+            throw "Unknown input format: " + input_format;
+        }
+
+        // Collect the frame offsets and the columns
+        std::vector<uint64_t> offsets;
+        std::vector<std::vector<double>> columns(header.column_count);
+        offsets.push_back(0);
+        for (size_t frame = 0; frame < sequence.GetFrameCount(); ++frame)
+        {
+            for (size_t i = 0; i < sequence.GetObjectCount(frame); ++i)
+            {
+                core::ObjectData2DPtr obj =
+                        std::static_pointer_cast<core::ObjectData2D>(sequence.GetObject(frame, i));
+
+                columns[0].push_back(obj->GetPosition().x);
+                columns[1].push_back(obj->GetPosition().y);
+                columns[2].push_back(obj->GetDetectionScore());
+
+                if (header.model == MODEL_BOX)
+                {
+                    core::ObjectDataBoxPtr box = std::static_pointer_cast<core::ObjectDataBox>(obj);
+                    columns[3].push_back(box->GetSize().x);
+                    columns[4].push_back(box->GetSize().y);
+                }
+                else if (header.model == MODEL_ANGULAR)
+                {
+                    core::ObjectDataAngularPtr ang =
+                            std::static_pointer_cast<core::ObjectDataAngular>(obj);
+                    columns[3].push_back(ang->GetAngle());
+                }
+            }
+
+            offsets.push_back(columns[0].size());
+        }
+        header.frame_count = sequence.GetFrameCount();
+        header.object_count = columns[0].size();
+
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()),
+                  offsets.size() * sizeof(uint64_t));
+        for (auto& column : columns)
+        {
+            out.write(reinterpret_cast<const char*>(column.data()),
+                      column.size() * sizeof(double));
+        }
+
+        out.close();
+
+        GBMOT_LOG_DEBUG("frames written " + std::to_string(header.frame_count));
+        GBMOT_LOG_DEBUG("objects written " + std::to_string(header.object_count));
+    }
+
+    void FileIO::ReadDetections(core::DetectionSequence& sequence, std::string& input_format,
+                                const std::string& file_name, double temporal_weight,
+                                double spatial_weight, double angular_weight)
+    {
+        GBMOT_LOG_INFO("Read detection file");
+
+        MappedFile file(file_name);
+
+        const DetectionFileHeader* header = reinterpret_cast<const DetectionFileHeader*>(file.data);
+        if (file.size < sizeof(DetectionFileHeader))
+        {
+            throw "Invalid detection file: " + file_name;
+        }
+
+        // The counts are read from the file, so the sizes are checked for overflows
+        size_t expected_size = sizeof(DetectionFileHeader);
+        if (std::memcmp(header->magic, DETECTION_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+                header->version != DETECTION_FILE_VERSION || header->model > MODEL_ANGULAR ||
+                header->column_count != GetColumnCount(header->model) ||
+                !AddSize(expected_size, header->frame_count, sizeof(uint64_t)) ||
+                !AddSize(expected_size, 1, sizeof(uint64_t)) ||
+                !AddSize(expected_size, header->object_count,
+                         header->column_count * sizeof(double)) ||
+                file.size < expected_size)
+        {
+            throw "Invalid detection file: " + file_name;
+        }
+
+        const uint64_t* offsets = reinterpret_cast<const uint64_t*>(header + 1);
+        if (!IsValidOffsets(offsets, header->frame_count, header->object_count))
+        {
+            throw "Invalid frame offsets in detection file: " + file_name;
+        }
+
+        const double* columns = reinterpret_cast<const double*>(offsets + header->frame_count + 1);
+        const double* xs = columns;
+        const double* ys = columns + header->object_count;
+        const double* scores = columns + 2 * header->object_count;
+        const double* extra = columns + 3 * header->object_count;
+
+        for (uint64_t frame = 0; frame < header->frame_count; ++frame)
+        {
+            for (uint64_t i = offsets[frame]; i < offsets[frame + 1]; ++i)
+            {
+                cv::Point2d point(xs[i], ys[i]);
+
+                core::ObjectData2DPtr object;
+                switch (header->model)
+                {
+                    case MODEL_BOX:
+                        object = std::make_shared<core::ObjectDataBox>(
+                                frame, point,
+                                cv::Point2d(extra[i], extra[i + header->object_count]));
+                        break;
+                    case MODEL_ANGULAR:
+                    {
+                        core::ObjectDataAngularPtr angular =
+                                std::make_shared<core::ObjectDataAngular>(frame, point, extra[i]);
+                        angular->SetAngularWeight(angular_weight);
+                        object = angular;
+                        break;
+                    }
+                    default:
+                        object = std::make_shared<core::ObjectData2D>(frame, point);
+                        break;
+                }
+
+                object->SetTemporalWeight(temporal_weight);
+                object->SetSpatialWeight(spatial_weight);
+                object->SetDetectionScore(scores[i]);
+
+                sequence.AddObject(object);
+            }
+        }
+
+        switch (header->model)
+        {
+            case MODEL_BOX:
+                input_format = "Box";
+                break;
+            case MODEL_ANGULAR:
+                input_format = "Angular";
+                break;
+            default:
+                input_format = "2D";
+                break;
+        }
+
+        GBMOT_LOG_DEBUG("objects read " + std::to_string(header->object_count));
+        GBMOT_LOG_DEBUG("frame count " + std::to_string(sequence.GetFrameCount()));
+    }
+
+    bool FileIO::IsDetectionFile(const std::string& file_name)
+    {
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
+
+        char magic[sizeof(DETECTION_FILE_MAGIC)];
+        in.read(magic, sizeof(magic));
+
+        return in.gcount() == sizeof(magic) &&
+               std::memcmp(magic, DETECTION_FILE_MAGIC, sizeof(magic)) == 0;
+    }
+
+    void FileIO::WriteTracks(std::vector<core::TrackletPtr>& tracks, const std::string& file_name,
+                             char delimiter)
+    {
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+
+        if (!out.is_open())
+        {
+            util::Logger::LogError("Unable to open file: " + file_name);
+            return;
+        }
+
+        // Invert the tracks once instead of searching every track in every frame
+        core::FrameIndex index(tracks);
+
+        std::string buffer;
+        buffer.reserve(WRITE_BUFFER_SIZE + 1024);
+        for (size_t frame = index.GetFirstFrameIndex(); frame < index.GetEndFrameIndex(); ++frame)
+        {
+            const std::vector<core::FrameEntry>& entries = index.GetFrame(frame);
+            auto entry = entries.begin();
+            for (size_t i = 0; i < tracks.size(); ++i)
+            {
+                if (entry != entries.end() && entry->track == i)
+                {
+                    core::ObjectData2DPtr obj =
+                            std::static_pointer_cast<core::ObjectData2D>(entry->object);
+
+                    AppendValue(buffer, obj->GetPosition().x);
+                    buffer += delimiter;
+                    AppendValue(buffer, obj->GetPosition().y);
+
+                    // Every track has a single column pair, like GetFrameObject
+                    // only the first object of the track in the frame is written
+                    while (entry != entries.end() && entry->track == i)
+                    {
+                        ++entry;
+                    }
+                }
+                else
+                {
+                    buffer += delimiter;
+                }
+
+                if (i < (tracks.size() - 1))
+                {
+                    buffer += delimiter;
+                }
+            }
+
+            buffer += '\n';
+
+            // Write in large blocks instead of flushing every line
+            if (buffer.size() >= WRITE_BUFFER_SIZE)
+            {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+
+        out.write(buffer.data(), buffer.size());
+        out.close();
+    }
+
+    void FileIO::WriteTracksLong(std::vector<core::TrackletPtr>& tracks,
+                                 const std::string& file_name, char delimiter)
+    {
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+
+        if (!out.is_open())
+        {
+            util::Logger::LogError("Unable to open file: " + file_name);
+            return;
+        }
+
+        // Invert the tracks once, thus the output is sorted by frame
+        core::FrameIndex index(tracks);
+
+        std::string buffer;
+        buffer.reserve(WRITE_BUFFER_SIZE + 1024);
+        for (size_t frame = index.GetFirstFrameIndex(); frame < index.GetEndFrameIndex(); ++frame)
+        {
+            for (auto& entry : index.GetFrame(frame))
+            {
+                AppendTrackObject(buffer, frame, entry.track, entry.object, delimiter);
+            }
+
+            // Write in large blocks instead of flushing every line
+            if (buffer.size() >= WRITE_BUFFER_SIZE)
+            {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+
+        out.write(buffer.data(), buffer.size());
+        out.close();
+    }
+
+    void FileIO::AppendTrackObject(std::string& buffer, size_t frame, size_t id,
+                                   const core::ObjectDataPtr& obj, char delimiter)
+    {
+        core::ObjectData2DPtr obj_2d = std::static_pointer_cast<core::ObjectData2D>(obj);
+        core::ObjectDataBoxPtr obj_box = std::dynamic_pointer_cast<core::ObjectDataBox>(obj);
+
+        // Objects without a size have a size of zero
+        cv::Point2d size(0.0, 0.0);
+        if (obj_box)
+        {
+            size = obj_box->GetSize();
+        }
+
+        buffer += std::to_string(frame);
+        buffer += delimiter;
+        buffer += std::to_string(id);
+        buffer += delimiter;
+        AppendValue(buffer, obj_2d->GetPosition().x);
+        buffer += delimiter;
+        AppendValue(buffer, obj_2d->GetPosition().y);
+        buffer += delimiter;
+        AppendValue(buffer, size.x);
+        buffer += delimiter;
+        AppendValue(buffer, size.y);
+        buffer += delimiter;
+        AppendValue(buffer, obj->GetDetectionScore());
+        buffer += '\n';
+    }
+
+    void FileIO::AppendValue(std::string& buffer, double value)
+    {
+        // Same representation as the default stream output
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%g", value);
+        buffer.append(text, (size_t) length);
+    }
+
+    void FileIO::ReadTracks(std::vector<core::TrackletPtr>& tracks, const std::string& file_name,
+                            char delimiter)
+    {
+        std::string buffer;
+        try
+        {
+            ReadFile(buffer, file_name);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError(e);
+            return;
+        }
+
+        // Parse all points first to allocate every path only once
+        struct TrackPoint
+        {
+            size_t track;
+            size_t frame;
+            cv::Point2d position;
+        };
+        std::vector<TrackPoint> points;
+        std::vector<size_t> counts;
+        size_t errors = 0;
+
+        const char* position = buffer.data();
+        const char* end = position + buffer.size();
+        size_t line_index = 0;
+        while (position < end)
+        {
+            const char* line_end = std::find(position, end, '\n');
+            if (line_end == position)
+            {
+                ++position;
+                continue;
+            }
+
+            const char* content_end = line_end;
+            if (*(content_end - 1) == '\r')
+            {
+                --content_end;
+            }
+
+            // Every track has two values (x and y) per line
+            size_t part_count = 0;
+            const char* x_begin = nullptr;
+            const char* x_end = nullptr;
+            for (const char* part = position; ; )
+            {
+                const char* part_end = std::find(part, content_end, delimiter);
+
+                if (part_count % 2 == 0)
+                {
+                    x_begin = part;
+                    x_end = part_end;
+                }
+                else if (x_begin != x_end && part != part_end)
+                {
+                    TrackPoint point;
+                    point.track = part_count / 2;
+                    point.frame = line_index;
+                    if (ParseField(x_begin, x_end, point.position.x) &&
+                            ParseField(part, part_end, point.position.y))
+                    {
+                        points.push_back(point);
+                    }
+                    else
+                    {
+                        ++errors;
+                    }
+                }
+
+                ++part_count;
+
+                if (part_end == content_end) break;
+
+                part = part_end + 1;
+            }
+
+            // A trailing delimiter does not start another value
+            if (content_end > position && *(content_end - 1) == delimiter)
+            {
+                --part_count;
+            }
+
+            if (counts.size() < part_count / 2)
+            {
+                counts.resize(part_count / 2, 0);
+            }
+
+            line_index++;
+            position = line_end + 1;
+        }
+
+        for (auto& point : points)
+        {
+            ++counts[point.track];
+        }
+
+        // Build every path with a single allocation, the points are already
+        // sorted by frame within every track
+        std::vector<std::vector<core::ObjectDataPtr>> paths(counts.size());
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            paths[i].reserve(counts[i]);
+        }
+        for (auto& point : points)
+        {
+            paths[point.track].push_back(
+                    std::make_shared<core::ObjectData2D>(point.frame, point.position));
+        }
+        for (auto& path : paths)
+        {
+            core::TrackletPtr tracklet(new core::Tracklet());
+            tracklet->SetPathObjects(path);
+            tracks.push_back(tracklet);
+        }
+
+        if (errors > 0)
+        {
+            util::Logger::LogError("Invalid track values: " + std::to_string(errors));
+        }
+        GBMOT_LOG_DEBUG("tracks read " + std::to_string(paths.size()));
+    }
+
+    void FileIO::ReadTracksLong(std::vector<core::TrackletPtr>& tracks,
+                                const std::string& file_name, char delimiter)
+    {
+        std::string buffer;
+        try
+        {
+            ReadFile(buffer, file_name);
+        }
+        catch (std::string& e)
+        {
+            util::Logger::LogError(e);
+            return;
+        }
+
+        // Parse all lines into a flat array of frame, id, x, y, width, height
+        // and score
+        const size_t value_count = 7;
+        std::vector<double> values;
+        size_t errors = 0;
+        const char* position = buffer.data();
+        const char* end = position + buffer.size();
+        while (position < end)
+        {
+            const char* line_end = std::find(position, end, '\n');
+            const char* content_end = line_end;
+            if (content_end > position && *(content_end - 1) == '\r')
+            {
+                --content_end;
+            }
+
+            if (content_end > position)
+            {
+                const char* part = position;
+                for (size_t i = 0; i < value_count; ++i)
+                {
+                    double value = 0.0;
+                    if (part <= content_end)
+                    {
+                        const char* part_end = std::find(part, content_end, delimiter);
+                        if (!ParseField(part, part_end, value))
+                        {
+                            value = 0.0;
+                            ++errors;
+                        }
+                        part = part_end + 1;
+                    }
+                    values.push_back(value);
+                }
+            }
+
+            position = line_end + 1;
+        }
+
+        // Map the ids to ascending track indices and order the objects by
+        // track and frame
+        size_t object_count = values.size() / value_count;
+        std::map<size_t, size_t> track_indices;
+        for (size_t i = 0; i < object_count; ++i)
+        {
+            track_indices.emplace((size_t) std::fabs(values[i * value_count + 1]), 0);
+        }
+        size_t track_count = 0;
+        for (auto& entry : track_indices)
+        {
+            entry.second = track_count++;
+        }
+
+        std::vector<size_t> order(object_count);
+        std::vector<size_t> counts(track_count, 0);
+        std::vector<size_t> object_tracks(object_count);
+        for (size_t i = 0; i < object_count; ++i)
+        {
+            order[i] = i;
+            object_tracks[i] = track_indices[(size_t) std::fabs(values[i * value_count + 1])];
+            ++counts[object_tracks[i]];
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            if (object_tracks[a] != object_tracks[b])
+                return object_tracks[a] < object_tracks[b];
+            return values[a * value_count] < values[b * value_count];
+        });
+
+        // Build every path with a single allocation
+        std::vector<core::ObjectDataPtr> path;
+        for (size_t i = 0, track = 0; track < track_count; ++track)
+        {
+            path.clear();
+            path.reserve(counts[track]);
+            for (size_t k = 0; k < counts[track]; ++k, ++i)
+            {
+                const double* object_values = &values[order[i] * value_count];
+                size_t frame = (size_t) std::fabs(object_values[0]);
+
+                // Only the first object of a frame is used
+                if (!path.empty() && path.back()->GetFrameIndex() == frame) continue;
+
+                cv::Point2d point(object_values[2], object_values[3]);
+                core::ObjectData2DPtr object;
+                if (object_values[4] != 0.0 || object_values[5] != 0.0)
+                {
+                    object = std::make_shared<core::ObjectDataBox>(
+                            frame, point, cv::Point2d(object_values[4], object_values[5]));
+                }
+                else
+                {
+                    object = std::make_shared<core::ObjectData2D>(frame, point);
+                }
+                object->SetDetectionScore(object_values[6]);
+
+                path.push_back(object);
+            }
+
+            core::TrackletPtr tracklet(new core::Tracklet());
+            tracklet->SetPathObjects(path);
+            tracks.push_back(tracklet);
+        }
+
+        if (errors > 0)
+        {
+            util::Logger::LogError("Invalid track values: " + std::to_string(errors));
+        }
+        GBMOT_LOG_DEBUG("tracks read " + std::to_string(track_count));
+    }
+
+    void FileIO::WriteTracksBinary(std::vector<core::TrackletPtr>& tracks,
+                                   const std::string& file_name)
+    {
+        TrackFileHeader header;
+        std::memcpy(header.magic, TRACK_FILE_MAGIC, sizeof(header.magic));
+        header.version = TRACK_FILE_VERSION;
+        header.reserved = 0;
+        header.model = MODEL_2D;
+        header.track_count = tracks.size();
+
+        // The model of the first object is used for all objects
+        for (auto track : tracks)
+        {
+            if (track->GetPathObjectCount() > 0)
+            {
+                header.model = GetModel(track->GetPathObject(0));
+                break;
+            }
+        }
+        header.column_count = GetColumnCount(header.model);
+
+        // Collect the track offsets and the columns
+        std::vector<uint64_t> offsets;
+        std::vector<uint64_t> frames;
+        std::vector<std::vector<double>> columns(header.column_count);
+        offsets.push_back(0);
+        for (auto track : tracks)
+        {
+            for (size_t i = 0; i < track->GetPathObjectCount(); ++i)
+            {
+                core::ObjectDataPtr obj = track->GetPathObject(i);
+                core::ObjectData2DPtr obj_2d = std::static_pointer_cast<core::ObjectData2D>(obj);
+
+                frames.push_back(obj->GetFrameIndex());
+                columns[0].push_back(obj_2d->GetPosition().x);
+                columns[1].push_back(obj_2d->GetPosition().y);
+                columns[2].push_back(obj->GetDetectionScore());
+
+                if (header.model == MODEL_BOX)
+                {
+                    core::ObjectDataBoxPtr box = std::static_pointer_cast<core::ObjectDataBox>(obj);
+                    columns[3].push_back(box->GetSize().x);
+                    columns[4].push_back(box->GetSize().y);
+                }
+                else if (header.model == MODEL_ANGULAR)
+                {
+                    core::ObjectDataAngularPtr ang =
+                            std::static_pointer_cast<core::ObjectDataAngular>(obj);
+                    columns[3].push_back(ang->GetAngle());
+                }
+            }
+
+            offsets.push_back(frames.size());
+        }
+        header.object_count = frames.size();
+
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()),
+                  offsets.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(frames.data()),
+                  frames.size() * sizeof(uint64_t));
+        for (auto& column : columns)
+        {
+            out.write(reinterpret_cast<const char*>(column.data()),
+                      column.size() * sizeof(double));
+        }
+
+        out.close();
+
+        GBMOT_LOG_DEBUG("tracks written " + std::to_string(header.track_count));
+        GBMOT_LOG_DEBUG("objects written " + std::to_string(header.object_count));
+    }
+
+    void FileIO::ReadTracksBinary(std::vector<core::TrackletPtr>& tracks,
+                                  const std::string& file_name)
+    {
+        MappedFile file(file_name);
+
+        const TrackFileHeader* header = reinterpret_cast<const TrackFileHeader*>(file.data);
+        if (file.size < sizeof(TrackFileHeader))
+        {
+            throw "Invalid track file: " + file_name;
+        }
+
+        // The counts are read from the file, so the sizes are checked for overflows
+        size_t expected_size = sizeof(TrackFileHeader);
+        if (std::memcmp(header->magic, TRACK_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+                header->version != TRACK_FILE_VERSION || header->model > MODEL_ANGULAR ||
+                header->column_count != GetColumnCount(header->model) ||
+                !AddSize(expected_size, header->track_count, sizeof(uint64_t)) ||
+                !AddSize(expected_size, 1, sizeof(uint64_t)) ||
+                !AddSize(expected_size, header->object_count,
+                         sizeof(uint64_t) + header->column_count * sizeof(double)) ||
+                file.size < expected_size)
+        {
+            throw "Invalid track file: " + file_name;
+        }
+
+        const uint64_t* offsets = reinterpret_cast<const uint64_t*>(header + 1);
+        if (!IsValidOffsets(offsets, header->track_count, header->object_count))
+        {
+            throw "Invalid track offsets in track file: " + file_name;
+        }
+
+        const uint64_t* frames = offsets + header->track_count + 1;
+        const double* columns = reinterpret_cast<const double*>(frames + header->object_count);
+        const double* xs = columns;
+        const double* ys = columns + header->object_count;
+        const double* scores = columns + 2 * header->object_count;
+        const double* extra = columns + 3 * header->object_count;
+
+        // A tracklet needs its objects sorted by frame, one object per frame
+        for (uint64_t track = 0; track < header->track_count; ++track)
+        {
+            for (uint64_t i = offsets[track] + 1; i < offsets[track + 1]; ++i)
+            {
+                if (frames[i] <= frames[i - 1])
+                {
+                    throw "Frames not strictly ascending in track " + std::to_string(track) +
+                          " of track file: " + file_name;
+                }
+            }
+        }
+
+        std::vector<core::ObjectDataPtr> path;
+        for (uint64_t track = 0; track < header->track_count; ++track)
+        {
+            path.clear();
+            path.reserve(offsets[track + 1] - offsets[track]);
+            for (uint64_t i = offsets[track]; i < offsets[track + 1]; ++i)
+            {
+                cv::Point2d point(xs[i], ys[i]);
+
+                core::ObjectDataPtr object;
+                switch (header->model)
+                {
+                    case MODEL_BOX:
+                        object = std::make_shared<core::ObjectDataBox>(
+                                frames[i], point,
+                                cv::Point2d(extra[i], extra[i + header->object_count]));
+                        break;
+                    case MODEL_ANGULAR:
+                        object = std::make_shared<core::ObjectDataAngular>(frames[i], point,
+                                                                           extra[i]);
+                        break;
+                    default:
+                        object = std::make_shared<core::ObjectData2D>(frames[i], point);
+                        break;
+                }
+                object->SetDetectionScore(scores[i]);
+
+                path.push_back(object);
+            }
+
+            core::TrackletPtr tracklet(new core::Tracklet());
+            tracklet->SetPathObjects(path);
+            tracks.push_back(tracklet);
+        }
+
+        GBMOT_LOG_DEBUG("tracks read " + std::to_string(header->track_count));
+    }
+
+    bool FileIO::IsTrackFile(const std::string& file_name)
+    {
+        std::ifstream in(file_name, std::ios::in | std::ios::binary);
+
+        char magic[sizeof(TRACK_FILE_MAGIC)];
+        in.read(magic, sizeof(magic));
+
+        return in.gcount() == sizeof(magic) &&
+               std::memcmp(magic, TRACK_FILE_MAGIC, sizeof(magic)) == 0;
+    }
+
     std::vector<std::string> FileIO::split(const std::string& input, char delimiter)
     {
         std::vector<std::string> output;
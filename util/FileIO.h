@@ -5,12 +5,16 @@
 #ifndef GBMOT_FILEIO_H
 #define GBMOT_FILEIO_H
 
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <vector>
+#include <functional>
+#include "ValueTable.h"
 #include "../core/ObjectData.h"
 #include "../graph/Definitions.h"
 #include "../core/Tracklet.h"
+#include "../core/DetectionSequence.h"
 
 namespace util
 {
@@ -25,6 +29,13 @@ namespace util
     class FileIO
     {
     public:
+        /**
+         * The solver a binary graph file is replayed with: the k shortest
+         * paths of berclaz or the iterative dijkstra of n-stage.
+         */
+        static const uint32_t GRAPH_SOLVER_K_SHORTEST_PATHS;
+        static const uint32_t GRAPH_SOLVER_ITERATIVE_DIJKSTRA;
+
         /**
          * Reads a CSV file and stores the values in a 3D array.
          * The first dimension is the first value of each row, used as a
@@ -80,6 +91,36 @@ namespace util
         static void  WriteCSVMatlab(MultiPredecessorMap& map, Vertex& source, Vertex& sink,
                                     const std::string& file_name);
 
+        /**
+         * Writes the specified graph into a binary file in compressed sparse
+         * row form. Only the structure, the edge weights and the frame index
+         * of every vertex are stored.
+         *
+         * @param graph The graph to write
+         * @param source The source vertex
+         * @param sink The sink vertex
+         * @param solver The solver the graph is solved with, one of the
+         *               GRAPH_SOLVER constants
+         * @param file_name The name of the file to write
+         */
+        static void WriteGraphBinary(DirectedGraph& graph, Vertex source, Vertex sink,
+                                     uint32_t solver, const std::string& file_name);
+
+        /**
+         * Reads a graph written by WriteGraphBinary into the specified graph.
+         * Every vertex gets an object with the stored frame index, the edges
+         * are added in the same order as in the written graph.
+         *
+         * @param graph The graph to add the vertices and edges to
+         * @param source The source vertex
+         * @param sink The sink vertex
+         * @param solver The solver the graph is solved with, one of the
+         *               GRAPH_SOLVER constants
+         * @param file_name The name of the file to read
+         */
+        static void ReadGraphBinary(DirectedGraph& graph, Vertex& source, Vertex& sink,
+                                    uint32_t& solver, const std::string& file_name);
+
         /**
          * Reads a CSV file.
          * The first line of the CSV file is a header specifying the keys.
@@ -104,8 +145,132 @@ namespace util
         static void ReadCSV(ValueMapVector& values, const std::string& header,
                             const std::string& file_name, char delimiter);
 
+        /**
+         * Reads a CSV file with multiple threads.
+         * The first line of the CSV file is a header specifying the keys.
+         * The file is split at line boundaries into one chunk per thread, the
+         * chunks are parsed concurrently and the results are concatenated in
+         * the order of the file.
+         *
+         * @param values A vector of maps to store the key-value pairs into
+         * @param file_name The name of the file to read
+         * @param delimiter The value delimiter of the file
+         * @param thread_count The number of threads to use, zero to use all
+         *                     available hardware threads
+         */
+        static void ReadCSVParallel(ValueMapVector& values, const std::string& file_name,
+                                    char delimiter, size_t thread_count = 0);
+
+        /**
+         * Reads a CSV file with multiple threads.
+         * The header specifies the keys.
+         * The file is split at line boundaries into one chunk per thread, the
+         * chunks are parsed concurrently and the results are concatenated in
+         * the order of the file.
+         *
+         * @param values A vector of maps to store the key-value pairs into
+         * @param header A string containing the keys separated by the delimiter
+         * @param file_name The name of the file to read
+         * @param delimiter The value delimiter of the file
+         * @param thread_count The number of threads to use, zero to use all
+         *                     available hardware threads
+         */
+        static void ReadCSVParallel(ValueMapVector& values, const std::string& header,
+                                    const std::string& file_name, char delimiter,
+                                    size_t thread_count = 0);
+
+        /**
+         * Reads a CSV file with multiple threads into a column wise table.
+         * The first line of the CSV file is a header specifying the keys.
+         * The file is split at line boundaries into one chunk per thread, the
+         * chunks are parsed concurrently and the results are concatenated in
+         * the order of the file.
+         *
+         * @param values The table to append the values to
+         * @param file_name The name of the file to read
+         * @param delimiter The value delimiter of the file
+         * @param thread_count The number of threads to use, zero to use all
+         *                     available hardware threads
+         */
+        static void ReadCSVParallel(ValueTable& values, const std::string& file_name,
+                                    char delimiter, size_t thread_count = 0);
+
+        /**
+         * Reads a CSV file with multiple threads into a column wise table.
+         * The header specifies the keys.
+         * The file is split at line boundaries into one chunk per thread, the
+         * chunks are parsed concurrently and the results are concatenated in
+         * the order of the file.
+         *
+         * @param values The table to append the values to
+         * @param header A string containing the keys separated by the delimiter
+         * @param file_name The name of the file to read
+         * @param delimiter The value delimiter of the file
+         * @param thread_count The number of threads to use, zero to use all
+         *                     available hardware threads
+         */
+        static void ReadCSVParallel(ValueTable& values, const std::string& header,
+                                    const std::string& file_name, char delimiter,
+                                    size_t thread_count = 0);
+
+        /**
+         * Parses CSV text held in memory into a column wise table.
+         * If the header is empty, the first line of the text is used as the
+         * header, if the header is the first line of the text, the line is
+         * skipped.
+         *
+         * @param values The table to append the values to
+         * @param header A string containing the keys separated by the delimiter
+         * @param begin The first character of the text
+         * @param end The character after the last character of the text
+         * @param delimiter The value delimiter of the text
+         */
+        static void ParseCSV(ValueTable& values, const std::string& header,
+                             const char* begin, const char* end, char delimiter);
+
+        /**
+         * Writes the given sequence into a binary columnar detection file.
+         * The file starts with a header describing the object model, followed
+         * by the frame offsets and one column per stored value.
+         * All values are stored as parsed, i.e. normalized positions and scores.
+         *
+         * @param sequence The sequence to write
+         * @param input_format The format of the objects in the sequence,
+         *                     valid formats are: 2D, Box, Angular
+         * @param file_name The name of the file to write
+         */
+        static void WriteDetections(const core::DetectionSequence& sequence,
+                                    const std::string& input_format,
+                                    const std::string& file_name);
+
+        /**
+         * Reads a binary columnar detection file into the given sequence.
+         * The file is memory mapped and the objects are created directly from
+         * the stored columns without any parsing.
+         *
+         * @param sequence The sequence to store the created objects in
+         * @param input_format The format of the objects stored in the file
+         * @param file_name The name of the file to read
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         */
+        static void ReadDetections(core::DetectionSequence& sequence, std::string& input_format,
+                                   const std::string& file_name, double temporal_weight,
+                                   double spatial_weight, double angular_weight);
+
+        /**
+         * Checks if the specified file is a binary columnar detection file.
+         *
+         * @param file_name The name of the file to check
+         * @return True, if the file starts with the detection file signature
+         */
+        static bool IsDetectionFile(const std::string& file_name);
+
         /**
          * Writes the given tracks to the given file.
+         * Every line is a frame containing the x and y values of every track,
+         * the values of tracks without an object in that frame are empty.
          *
          * @param tracks The tracks to store
          * @param file_name The path to the file to store the tracks in
@@ -115,15 +280,86 @@ namespace util
                                 char delimiter);
 
         /**
-         * Reads the tracks from the specified file.
+         * Writes the given tracks to the given file in a long format.
+         * Every object of every track is written into its own line with the
+         * values frame, id, x, y, width, height and score, sorted by frame.
+         * The id is the index of the track, objects without a size have a
+         * width and height of zero.
+         *
+         * @param tracks The tracks to store
+         * @param file_name The path to the file to store the tracks in
+         * @param delimiter The delimiter used to separate values
+         */
+        static void WriteTracksLong(std::vector<core::TrackletPtr>& tracks,
+                                    const std::string& file_name, char delimiter);
+
+        /**
+         * Formats the given track object as a line of the long track format
+         * and appends it to the given buffer.
+         *
+         * @param buffer The buffer to append the line to
+         * @param frame The frame of the object
+         * @param id The id of the track
+         * @param obj The object to format, needs to be at least an ObjectData2D
+         * @param delimiter The delimiter used to separate values
+         */
+        static void AppendTrackObject(std::string& buffer, size_t frame, size_t id,
+                                      const core::ObjectDataPtr& obj, char delimiter);
+
+        /**
+         * Reads the tracks from the specified file written by WriteTracks.
+         * The line index is used as the frame index of the objects.
+         * The file is parsed in bulk and every path is allocated only once.
          *
-         * @param tracks A vector for storing the read tracks
+         * @param tracks A vector to append the read tracks to
          * @param file_name The path of the file to read from
          * @param delimiter The delimiter used to separate values
          */
         static void ReadTracks(std::vector<core::TrackletPtr>& tracks, const std::string& file_name,
                                char delimiter);
 
+        /**
+         * Reads the tracks from the specified file in the long format written
+         * by WriteTracksLong. The tracks are ordered by ascending id, objects
+         * with a width or height are read as ObjectDataBox, all other objects
+         * as ObjectData2D.
+         *
+         * @param tracks A vector to append the read tracks to
+         * @param file_name The path of the file to read from
+         * @param delimiter The delimiter used to separate values
+         */
+        static void ReadTracksLong(std::vector<core::TrackletPtr>& tracks,
+                                   const std::string& file_name, char delimiter);
+
+        /**
+         * Writes the given tracks into a binary columnar track file.
+         * The object model of the first object is used for all objects.
+         *
+         * @param tracks The tracks to store
+         * @param file_name The path to the file to store the tracks in
+         */
+        static void WriteTracksBinary(std::vector<core::TrackletPtr>& tracks,
+                                      const std::string& file_name);
+
+        /**
+         * Reads the tracks from a binary columnar track file.
+         * The file is memory mapped and the objects are created directly from
+         * the stored columns.
+         *
+         * @param tracks A vector to append the read tracks to
+         * @param file_name The path of the file to read from
+         */
+        static void ReadTracksBinary(std::vector<core::TrackletPtr>& tracks,
+                                     const std::string& file_name);
+
+        /**
+         * Checks if the specified file is a binary columnar track file.
+         *
+         * @param file_name The name of the file to check
+         * @return True, if the file starts with the track file signature
+         */
+        static bool IsTrackFile(const std::string& file_name);
+
         /**
          * Splits the input string at the delimiter and store each part into the return vector.
          * If there is nothing between two delimiters the part will be an empty string.
@@ -133,6 +369,79 @@ namespace util
          * @return A vector of parts like (for string of length n: [0,d)...(d,d)...(d,n))
          */
         static std::vector<std::string> split(const std::string& input, char delimiter);
+
+        /**
+         * Parses all lines in the given range into a flat row major array.
+         * Every non empty line results in exactly key_count values, missing or
+         * invalid values are stored as zero.
+         *
+         * @param begin The first character of the range
+         * @param end The character after the last character of the range
+         * @param delimiter The value delimiter
+         * @param key_count The number of values to read per line
+         * @param values The vector to append the values to
+         * @return The number of values that could not be parsed
+         */
+        static size_t ParseLines(const char* begin, const char* end, char delimiter,
+                                 size_t key_count, std::vector<double>& values);
+    private:
+        /**
+         * Appends the given value to the buffer with the same representation
+         * as the default stream output.
+         *
+         * @param buffer The buffer to append the value to
+         * @param value The value to append
+         */
+        static void AppendValue(std::string& buffer, double value);
+
+        /**
+         * Reads the first line of the given file that is not empty.
+         *
+         * @param file_name The name of the file to read
+         * @return The first line that is not empty
+         */
+        static std::string ReadHeader(const std::string& file_name);
+
+        /**
+         * Reads the given CSV file and parses it in chunks with multiple threads.
+         * If the header is the first line of the file, the line is skipped.
+         *
+         * @param header A string containing the keys separated by the delimiter
+         * @param file_name The name of the file to read
+         * @param delimiter The value delimiter of the file
+         * @param thread_count The number of threads to use, zero to use all
+         *                     available hardware threads
+         * @param keys The vector to store the keys of the header in
+         * @param prepare Called with the number of chunks before parsing starts
+         * @param consume Called from the parsing thread with the chunk index
+         *                and the row major values of that chunk
+         */
+        static void ParseChunks(const std::string& header, const std::string& file_name,
+                                char delimiter, size_t thread_count,
+                                std::vector<std::string>& keys,
+                                const std::function<void(size_t)>& prepare,
+                                const std::function<void(size_t, std::vector<double>&)>& consume);
+
+        /**
+         * Reads the whole file into the given buffer.
+         *
+         * @param buffer The buffer to store the file content in
+         * @param file_name The name of the file to read
+         */
+        static void ReadFile(std::string& buffer, const std::string& file_name);
+
+        /**
+         * Splits the given range into the given number of chunks.
+         * Every chunk ends directly after a line break or at the end of the range.
+         *
+         * @param begin The first character of the range
+         * @param end The character after the last character of the range
+         * @param chunk_count The number of chunks to create, fewer chunks are
+         *                    created if the range has too few lines
+         * @return The chunk boundaries, chunk i is [bounds[i], bounds[i + 1])
+         */
+        static std::vector<const char*> SplitLines(const char* begin, const char* end,
+                                                   size_t chunk_count);
     };
 }
 
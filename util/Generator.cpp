@@ -0,0 +1,270 @@
+#include "Generator.h"
+#include "FileIO.h"
+#include "Logger.h"
+#include "MyMath.h"
+#include "Random.h"
+#include "../core/ObjectDataAngular.h"
+#include "../core/ObjectDataBox.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace util
+{
+    namespace
+    {
+        // The mean scores of detected objects and false positives
+        const double OBJECT_SCORE = 0.8;
+        const double FALSE_POSITIVE_SCORE = 0.2;
+
+        // The maximum normalized position, keeps all positions inside a grid
+        // over the unit square
+        const double MAX_POSITION = 0.999999;
+
+        double Clamp(double value, double min, double max)
+        {
+            return std::min(std::max(value, min), max);
+        }
+    }
+
+    Generator::Generator(size_t object_count, size_t frame_count, unsigned int seed)
+            : object_count_(object_count),
+              frame_count_(frame_count),
+              seed_(seed),
+              motion_model_("linear"),
+              speed_(0.01),
+              miss_rate_(0.1),
+              false_positive_rate_(1.0),
+              score_noise_(0.1),
+              position_noise_(0.0),
+              box_width_(0.05),
+              box_height_(0.1)
+    {
+    }
+
+    void Generator::SetMotionModel(const std::string& motion_model, double speed)
+    {
+        if (motion_model != "linear" && motion_model != "random-walk")
+        {
+            throw "Unknown motion model: " + motion_model;
+        }
+        if (!(speed >= 0.0))
+        {
+            throw "Invalid speed, must not be negative: " + std::to_string(speed);
+        }
+
+        motion_model_ = motion_model;
+        speed_ = speed;
+    }
+
+    void Generator::SetMissRate(double miss_rate)
+    {
+        miss_rate_ = Clamp(miss_rate, 0.0, 1.0);
+    }
+
+    void Generator::SetFalsePositiveRate(double false_positive_rate)
+    {
+        false_positive_rate_ = std::max(false_positive_rate, 0.0);
+    }
+
+    void Generator::SetScoreNoise(double score_noise)
+    {
+        score_noise_ = std::max(score_noise, 0.0);
+    }
+
+    void Generator::SetPositionNoise(double position_noise)
+    {
+        position_noise_ = std::max(position_noise, 0.0);
+    }
+
+    void Generator::SetBoxSize(double width, double height)
+    {
+        box_width_ = Clamp(width, 0.0, MAX_POSITION);
+        box_height_ = Clamp(height, 0.0, MAX_POSITION);
+    }
+
+    size_t Generator::GetExpectedDetectionCount() const
+    {
+        double per_frame = object_count_ * (1.0 - miss_rate_) + false_positive_rate_;
+        return (size_t) (per_frame * frame_count_);
+    }
+
+    void Generator::Generate(const DetectionFunction& add) const
+    {
+        Random random(seed_);
+
+        // The anchors are the top left corners, thus the boxes stay inside
+        // the unit square
+        double max_x = std::max(MAX_POSITION - box_width_, 0.0);
+        double max_y = std::max(MAX_POSITION - box_height_, 0.0);
+
+        std::vector<cv::Point2d> positions, speeds;
+        for (size_t i = 0; i < object_count_; ++i)
+        {
+            // The values are drawn in separate statements, the evaluation
+            // order of arguments differs between compilers
+            double x = random.Uniform(0.0, max_x);
+            double y = random.Uniform(0.0, max_y);
+            positions.push_back(cv::Point2d(x, y));
+
+            double vx = random.Uniform(-speed_, speed_);
+            double vy = random.Uniform(-speed_, speed_);
+            speeds.push_back(cv::Point2d(vx, vy));
+        }
+
+        bool random_walk = motion_model_ == "random-walk";
+        Detection detection;
+        detection.width = box_width_;
+        detection.height = box_height_;
+        for (size_t frame = 0; frame < frame_count_; ++frame)
+        {
+            detection.frame = frame;
+
+            for (size_t i = 0; i < object_count_; ++i)
+            {
+                cv::Point2d& position = positions[i];
+                cv::Point2d& velocity = speeds[i];
+
+                if (!random.Bernoulli(miss_rate_))
+                {
+                    double dx = position_noise_ > 0.0 ? random.Normal(0.0, position_noise_) : 0.0;
+                    double dy = position_noise_ > 0.0 ? random.Normal(0.0, position_noise_) : 0.0;
+                    double ds = score_noise_ > 0.0 ? random.Normal(0.0, score_noise_) : 0.0;
+
+                    detection.x = Clamp(position.x + dx, 0.0, max_x);
+                    detection.y = Clamp(position.y + dy, 0.0, max_y);
+                    detection.angle = std::atan2(velocity.y, velocity.x);
+                    detection.score = Clamp(OBJECT_SCORE + ds, 0.0, 1.0);
+                    add(detection);
+                }
+
+                if (random_walk)
+                {
+                    double ax = random.Normal(0.0, speed_ / 4.0);
+                    double ay = random.Normal(0.0, speed_ / 4.0);
+                    velocity.x = Clamp(velocity.x + ax, -speed_, speed_);
+                    velocity.y = Clamp(velocity.y + ay, -speed_, speed_);
+                }
+
+                // Move and bounce off the borders
+                position.x += velocity.x;
+                position.y += velocity.y;
+                if (position.x < 0.0 || position.x > max_x)
+                {
+                    velocity.x = -velocity.x;
+                    position.x = Clamp(position.x, 0.0, max_x);
+                }
+                if (position.y < 0.0 || position.y > max_y)
+                {
+                    velocity.y = -velocity.y;
+                    position.y = Clamp(position.y, 0.0, max_y);
+                }
+            }
+
+            size_t false_positive_count =
+                    false_positive_rate_ > 0.0 ? random.Poisson(false_positive_rate_) : 0;
+            for (size_t i = 0; i < false_positive_count; ++i)
+            {
+                double ds = score_noise_ > 0.0 ? random.Normal(0.0, score_noise_) : 0.0;
+
+                detection.x = random.Uniform(0.0, max_x);
+                detection.y = random.Uniform(0.0, max_y);
+                detection.angle = random.Uniform(-MyMath::PI, MyMath::PI);
+                detection.score = Clamp(FALSE_POSITIVE_SCORE + ds, 0.0, 1.0);
+                add(detection);
+            }
+        }
+    }
+
+    void Generator::Generate(core::DetectionSequence& sequence, const std::string& input_format,
+                             double temporal_weight, double spatial_weight,
+                             double angular_weight) const
+    {
+        if (input_format != "2D" && input_format != "Box" && input_format != "Angular")
+        {
+            throw "Unknown input format: " + input_format;
+        }
+
+        GBMOT_LOG_INFO("Generate detections");
+
+        size_t object_count = 0;
+        Generate([&](const Detection& detection)
+                 {
+                     cv::Point2d point(detection.x, detection.y);
+                     core::ObjectData2DPtr object;
+                     if (input_format == "Box")
+                     {
+                         cv::Point2d size(detection.width, detection.height);
+                         object.reset(new core::ObjectDataBox(detection.frame, point, size));
+                     }
+                     else if (input_format == "Angular")
+                     {
+                         core::ObjectDataAngularPtr angular(
+                                 new core::ObjectDataAngular(detection.frame, point,
+                                                             detection.angle));
+                         angular->SetAngularWeight(angular_weight);
+                         object = angular;
+                     }
+                     else
+                     {
+                         object.reset(new core::ObjectData2D(detection.frame, point));
+                     }
+
+                     object->SetTemporalWeight(temporal_weight);
+                     object->SetSpatialWeight(spatial_weight);
+                     object->SetDetectionScore(detection.score);
+                     sequence.AddObject(object);
+                     ++object_count;
+                 });
+
+        GBMOT_LOG_DEBUG("objects generated " + std::to_string(object_count));
+        GBMOT_LOG_DEBUG("frame count " + std::to_string(sequence.GetFrameCount()));
+    }
+
+    void Generator::WriteCSV(const std::string& file_name, char delimiter,
+                             double image_width, double image_height) const
+    {
+        std::ofstream out(file_name, std::ios::binary);
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        GBMOT_LOG_INFO("Write generated detections");
+
+        // Format into a buffer and write it in large blocks, thus millions of
+        // detections do not need to be held in memory
+        const size_t block_size = 1 << 20;
+        std::string buffer;
+        buffer.reserve(block_size + 256);
+        char line[256];
+        Generate([&](const Detection& detection)
+                 {
+                     int length = snprintf(line, sizeof(line),
+                                           "%zu%c%.3f%c%.3f%c%.3f%c%.3f%c%.3f%c%.4f\n",
+                                           detection.frame, delimiter,
+                                           detection.x * image_width, delimiter,
+                                           detection.y * image_height, delimiter,
+                                           detection.width * image_width, delimiter,
+                                           detection.height * image_height, delimiter,
+                                           MyMath::Degree(detection.angle), delimiter,
+                                           detection.score);
+                     buffer.append(line, (size_t) length);
+
+                     if (buffer.size() >= block_size)
+                     {
+                         out.write(buffer.data(), buffer.size());
+                         buffer.clear();
+                     }
+                 });
+        out.write(buffer.data(), buffer.size());
+    }
+
+    void Generator::WriteBinary(const std::string& file_name,
+                                const std::string& input_format) const
+    {
+        core::DetectionSequence sequence;
+        Generate(sequence, input_format);
+        FileIO::WriteDetections(sequence, input_format, file_name);
+    }
+}
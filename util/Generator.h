@@ -0,0 +1,205 @@
+#ifndef GBMOT_GENERATOR_H
+#define GBMOT_GENERATOR_H
+
+#include <functional>
+#include <string>
+#include "../core/DetectionSequence.h"
+
+namespace util
+{
+    /**
+     * Generates synthetic detection sequences for the 2D, Box and Angular
+     * object models. Objects move through the unit square and bounce off the
+     * borders, in every frame each object is missed with the miss rate and a
+     * random number of false positives is spread over the frame.
+     * Equal settings and seeds always generate equal sequences on every
+     * standard library, thus the generated sequences can be used to
+     * reproduce runtime and memory measurements at any scale.
+     */
+    class Generator
+    {
+    private:
+        /**
+         * A generated detection with normalized values
+         */
+        struct Detection
+        {
+            size_t frame;
+            double x;
+            double y;
+            double width;
+            double height;
+            double angle;
+            double score;
+        };
+
+        typedef std::function<void(const Detection&)> DetectionFunction;
+
+        /**
+         * The number of objects moving through all frames
+         */
+        size_t object_count_;
+
+        /**
+         * The number of frames
+         */
+        size_t frame_count_;
+
+        /**
+         * The seed of all random values
+         */
+        unsigned int seed_;
+
+        /**
+         * The motion model, linear or random-walk
+         */
+        std::string motion_model_;
+
+        /**
+         * The maximum distance an object moves in one frame
+         */
+        double speed_;
+
+        /**
+         * The probability of an object to be missed in a frame
+         */
+        double miss_rate_;
+
+        /**
+         * The mean number of false positives in every frame
+         */
+        double false_positive_rate_;
+
+        /**
+         * The standard deviation of the detection scores
+         */
+        double score_noise_;
+
+        /**
+         * The standard deviation of the detected positions
+         */
+        double position_noise_;
+
+        /**
+         * The normalized size of every bounding box
+         */
+        double box_width_;
+        double box_height_;
+
+        /**
+         * Generates all detections frame by frame and passes them to the
+         * given function.
+         *
+         * @param add The function to call for every detection
+         */
+        void Generate(const DetectionFunction& add) const;
+    public:
+        /**
+         * Creates a new generator with linear motion, a miss rate of 0.1, one
+         * false positive per frame and a score noise of 0.1.
+         *
+         * @param object_count The number of objects moving through all frames
+         * @param frame_count The number of frames
+         * @param seed The seed of all random values
+         */
+        Generator(size_t object_count, size_t frame_count, unsigned int seed);
+
+        /**
+         * Sets the motion model.
+         * The linear model moves every object with a constant velocity,
+         * the random-walk model changes the velocity randomly in every frame.
+         *
+         * @param motion_model The motion model, linear or random-walk
+         * @param speed The maximum distance an object moves in one frame,
+         *              negative speeds are rejected
+         */
+        void SetMotionModel(const std::string& motion_model, double speed);
+
+        /**
+         * Sets the probability of an object to be missed in a frame.
+         *
+         * @param miss_rate The miss rate in [0, 1]
+         */
+        void SetMissRate(double miss_rate);
+
+        /**
+         * Sets the mean number of false positives in every frame.
+         * The number of false positives is poisson distributed.
+         *
+         * @param false_positive_rate The mean number of false positives
+         */
+        void SetFalsePositiveRate(double false_positive_rate);
+
+        /**
+         * Sets the standard deviation of the detection scores.
+         * Detections of objects score around 0.8, false positives around 0.2.
+         *
+         * @param score_noise The standard deviation of the scores
+         */
+        void SetScoreNoise(double score_noise);
+
+        /**
+         * Sets the standard deviation of the detected positions around the
+         * true positions of the objects.
+         *
+         * @param position_noise The standard deviation in normalized units
+         */
+        void SetPositionNoise(double position_noise);
+
+        /**
+         * Sets the normalized size of every bounding box.
+         *
+         * @param width The width of every box
+         * @param height The height of every box
+         */
+        void SetBoxSize(double width, double height);
+
+        /**
+         * Gets the expected number of generated detections.
+         *
+         * @return The expected number of detections
+         */
+        size_t GetExpectedDetectionCount() const;
+
+        /**
+         * Generates the detections into the given sequence, the objects are
+         * set up like the parser does. The scores are already in [0, 1] and
+         * are stored without normalization.
+         *
+         * @param sequence The sequence to add the detections to
+         * @param input_format The object model, valid formats are: 2D, Box, Angular
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         */
+        void Generate(core::DetectionSequence& sequence, const std::string& input_format,
+                      double temporal_weight = 1.0, double spatial_weight = 1.0,
+                      double angular_weight = 1.0) const;
+
+        /**
+         * Writes the detections into a CSV file without a header.
+         * Every line contains the frame, x, y, width, height, angle (degree)
+         * and score, the positions and sizes are given in pixels. Thus the
+         * file can be read with every input format and the header
+         * frame;x;y;width;height;angle;score.
+         *
+         * @param file_name The name of the file to write
+         * @param delimiter The delimiter between the values
+         * @param image_width The width of the image used for normalization
+         * @param image_height The height of the image used for normalization
+         */
+        void WriteCSV(const std::string& file_name, char delimiter,
+                      double image_width, double image_height) const;
+
+        /**
+         * Writes the detections into a binary columnar detection file.
+         *
+         * @param file_name The name of the file to write
+         * @param input_format The object model, valid formats are: 2D, Box, Angular
+         */
+        void WriteBinary(const std::string& file_name, const std::string& input_format) const;
+    };
+}
+
+
+#endif //GBMOT_GENERATOR_H
@@ -0,0 +1,142 @@
+#include "ImagePrefetcher.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+
+namespace util
+{
+    ImagePrefetcher::ImagePrefetcher(const std::vector<std::string>& files, size_t cache_size,
+                                     size_t thread_count, int flags)
+            : files_(files),
+              flags_(flags),
+              position_(0),
+              direction_(1),
+              stop_(false)
+    {
+        // Most of the cache is used ahead in the stepping direction
+        cache_size = std::max(cache_size, (size_t) 1);
+        behind_count_ = (long) (cache_size / 4);
+        ahead_count_ = (long) cache_size - behind_count_;
+
+        if (thread_count == 0)
+        {
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads_.push_back(std::thread(&ImagePrefetcher::Work, this));
+        }
+    }
+
+    ImagePrefetcher::~ImagePrefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_condition_.notify_all();
+
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    void ImagePrefetcher::Work()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_)
+        {
+            long frame;
+            if (!GetNextFrame(frame))
+            {
+                work_condition_.wait(lock);
+                continue;
+            }
+
+            // Decode without holding the lock
+            pending_.insert(frame);
+            lock.unlock();
+            cv::Mat image = cv::imread(files_[frame], flags_);
+            lock.lock();
+            pending_.erase(frame);
+
+            // The window may have moved while decoding
+            if (IsInWindow(frame))
+            {
+                cache_[frame] = image;
+            }
+
+            ready_condition_.notify_all();
+        }
+    }
+
+    bool ImagePrefetcher::GetNextFrame(long& frame) const
+    {
+        long file_count = (long) files_.size();
+
+        // The frames ahead first, nearest first
+        for (long i = 0; i < ahead_count_; ++i)
+        {
+            long f = position_ + i * direction_;
+            if (f < 0 || f >= file_count) break;
+
+            if (cache_.count(f) == 0 && pending_.count(f) == 0)
+            {
+                frame = f;
+                return true;
+            }
+        }
+
+        for (long i = 1; i <= behind_count_; ++i)
+        {
+            long f = position_ - i * direction_;
+            if (f < 0 || f >= file_count) break;
+
+            if (cache_.count(f) == 0 && pending_.count(f) == 0)
+            {
+                frame = f;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool ImagePrefetcher::IsInWindow(long frame) const
+    {
+        long offset = (frame - position_) * direction_;
+        return offset < ahead_count_ && offset >= -behind_count_;
+    }
+
+    cv::Mat ImagePrefetcher::Get(size_t frame, bool reverse)
+    {
+        if (frame >= files_.size())
+        {
+            return cv::Mat();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        // Move the window and drop all images outside of it
+        position_ = (long) frame;
+        direction_ = reverse ? -1 : 1;
+        for (auto iter = cache_.begin(); iter != cache_.end(); )
+        {
+            if (IsInWindow(iter->first))
+            {
+                ++iter;
+            }
+            else
+            {
+                iter = cache_.erase(iter);
+            }
+        }
+        work_condition_.notify_all();
+
+        // The requested frame is always decoded first
+        ready_condition_.wait(lock, [&] { return cache_.count(position_) > 0; });
+
+        return cache_[position_];
+    }
+}
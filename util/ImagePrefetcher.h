@@ -0,0 +1,135 @@
+#ifndef GBMOT_IMAGEPREFETCHER_H
+#define GBMOT_IMAGEPREFETCHER_H
+
+#include <opencv2/core/core.hpp>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+    /**
+     * Loads and decodes images of a sequence in background threads.
+     * The images around the last requested frame are kept in a bounded
+     * cache, mostly ahead in the current stepping direction and some behind,
+     * thus stepping forward and backward does not wait for the disk or the
+     * decoder.
+     */
+    class ImagePrefetcher
+    {
+    private:
+        /**
+         * The paths of the images, the index is the frame
+         */
+        std::vector<std::string> files_;
+
+        /**
+         * The flags passed to cv::imread
+         */
+        int flags_;
+
+        /**
+         * The number of frames cached ahead of the current frame (including
+         * the current frame)
+         */
+        long ahead_count_;
+
+        /**
+         * The number of frames cached behind the current frame
+         */
+        long behind_count_;
+
+        /**
+         * The last requested frame
+         */
+        long position_;
+
+        /**
+         * The stepping direction, 1 for forward and -1 for reverse
+         */
+        long direction_;
+
+        /**
+         * The decoded images
+         */
+        std::map<long, cv::Mat> cache_;
+
+        /**
+         * The frames currently decoded by a thread
+         */
+        std::set<long> pending_;
+
+        /**
+         * True, if the threads should stop
+         */
+        bool stop_;
+
+        std::mutex mutex_;
+        std::condition_variable work_condition_;
+        std::condition_variable ready_condition_;
+        std::vector<std::thread> threads_;
+
+        /**
+         * Decodes frames until stopped.
+         */
+        void Work();
+
+        /**
+         * Gets the frame that is needed next and neither cached nor decoded.
+         * Needs to be called with the mutex locked.
+         *
+         * @param frame The frame to decode
+         * @return False, if all frames in the window are cached or pending
+         */
+        bool GetNextFrame(long& frame) const;
+
+        /**
+         * Checks if the frame is inside the cache window around the current
+         * frame. Needs to be called with the mutex locked.
+         *
+         * @param frame The frame to check
+         * @return True, if the frame should be cached
+         */
+        bool IsInWindow(long frame) const;
+    public:
+        /**
+         * Creates the prefetcher and starts the decoding threads.
+         *
+         * @param files The paths of the images, the index is the frame
+         * @param cache_size The maximum number of decoded images to keep
+         * @param thread_count The number of decoding threads, zero to use
+         *                     all available hardware threads
+         * @param flags The flags passed to cv::imread
+         */
+        ImagePrefetcher(const std::vector<std::string>& files, size_t cache_size,
+                        size_t thread_count, int flags = 1);
+
+        /**
+         * Stops and joins the decoding threads.
+         */
+        ~ImagePrefetcher();
+
+        ImagePrefetcher(const ImagePrefetcher&) = delete;
+        ImagePrefetcher& operator=(const ImagePrefetcher&) = delete;
+
+        /**
+         * Gets the decoded image of the given frame and moves the cache window
+         * to that frame. Waits until the image is decoded.
+         * The returned image shares its data with the cache and needs to be
+         * cloned before it is modified.
+         *
+         * @param frame The frame to get
+         * @param reverse True, if the frames are stepped backwards
+         * @return The decoded image, empty if the frame does not exist or the
+         *         image could not be read
+         */
+        cv::Mat Get(size_t frame, bool reverse = false);
+    };
+}
+
+
+#endif //GBMOT_IMAGEPREFETCHER_H
@@ -3,43 +3,180 @@
 //
 
 #include <iostream>
+#include <cstdio>
 #include "Logger.h"
 
 namespace util
 {
-    Logger::Logger() : debug_(false), info_(false)
+    Logger::Logger() : debug_(false), info_(false), error_output_(false), async_(false),
+                       block_(false), buffer_mask_(0), enqueue_position_(0), dequeue_position_(0),
+                       dropped_count_(0), running_(false)
     {
-        /* EMPTY */
+        start_ = std::chrono::steady_clock::now();
     }
 
-    void Logger::LogMessage(const std::string& message)
+    Logger::~Logger()
     {
-        std::cout << message;
+        StopWriter();
     }
 
-    void Logger::LogErrorMessage(const std::string& message)
+    size_t Logger::GetThreadId()
     {
-        std::cerr << message;
+        static std::atomic<size_t> next_id(0);
+        thread_local size_t id = next_id++;
+        return id;
+    }
+
+    void Logger::Log(Level level, const std::string& message)
+    {
+        long long time = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start_).count();
+        size_t thread = GetThreadId();
+
+        if (!async_)
+        {
+            std::lock_guard<std::mutex> lock(output_mutex_);
+            Write(level, time, thread, message);
+            return;
+        }
+
+        // Claim a slot, a slot is free if its sequence equals the position
+        Record* record;
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            record = &buffer_[position & buffer_mask_];
+            size_t sequence = record->sequence.load(std::memory_order_acquire);
+            long long difference = (long long) sequence - (long long) position;
+
+            if (difference == 0)
+            {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // The buffer is full
+                if (!block_)
+                {
+                    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                std::this_thread::yield();
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->level = level;
+        record->time = time;
+        record->thread = thread;
+        record->message = message;
+        record->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void Logger::Write(Level level, long long time, size_t thread, const std::string& message)
+    {
+        const char* prefix = "[Info ]";
+        if (level == LEVEL_ERROR) prefix = "[Error]";
+        if (level == LEVEL_DEBUG) prefix = "[Debug]";
+
+        char header[64];
+        snprintf(header, sizeof(header), "%s [%12.6f] [%zu] ", prefix, time / 1e6, thread);
+
+        std::ostream& out = file_.is_open() ? file_ :
+                            (level == LEVEL_ERROR || error_output_ ? std::cerr : std::cout);
+        out << header << message << "\n";
+    }
+
+    bool Logger::Drain()
+    {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+
+        bool written = false;
+        size_t position = dequeue_position_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Record& record = buffer_[position & buffer_mask_];
+            if (record.sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                break;
+            }
+
+            Write(record.level, record.time, record.thread, record.message);
+
+            // Release the slot for the next lap
+            record.sequence.store(position + buffer_mask_ + 1, std::memory_order_release);
+            ++position;
+            dequeue_position_.store(position, std::memory_order_release);
+            written = true;
+        }
+
+        size_t dropped = dropped_count_.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            Write(LEVEL_ERROR, std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start_).count(),
+                  GetThreadId(), std::to_string(dropped) + " log messages dropped");
+            written = true;
+        }
+
+        if (written)
+        {
+            if (file_.is_open()) file_.flush();
+            std::cout.flush();
+        }
+
+        return written;
+    }
+
+    void Logger::RunWriter()
+    {
+        while (running_.load(std::memory_order_acquire))
+        {
+            if (!Drain())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        Drain();
+    }
+
+    void Logger::StopWriter()
+    {
+        if (!async_) return;
+
+        running_.store(false, std::memory_order_release);
+        writer_.join();
+        async_ = false;
     }
 
     void Logger::LogInfo(const std::string& message)
     {
         if (Instance().info_)
         {
-            Instance().LogMessage("[Info ] " + message + "\n");
+            Instance().Log(LEVEL_INFO, message);
         }
     }
 
     void Logger::LogError(const std::string& message)
     {
-        Instance().LogErrorMessage("[Error] " + message + "\n");
+        Instance().Log(LEVEL_ERROR, message);
     }
 
     void Logger::LogDebug(const std::string& message)
     {
         if (Instance().debug_)
         {
-            Instance().LogMessage("[Debug] " + message + "\n");
+            Instance().Log(LEVEL_DEBUG, message);
         }
     }
 
@@ -53,14 +190,75 @@ namespace util
         Instance().info_ = info;
     }
 
-    bool Logger::IsDebugEnabled()
+    void Logger::SetErrorOutput(bool error_output)
     {
-        return Instance().debug_;
+        Instance().error_output_ = error_output;
     }
 
-    bool Logger::IsInfoEnabled()
+    void Logger::SetAsync(bool async, size_t buffer_size, bool block)
     {
-        return Instance().info_;
+        Logger& logger = Instance();
+        logger.StopWriter();
+
+        if (!async) return;
+
+        size_t size = 2;
+        while (size < buffer_size)
+        {
+            size <<= 1;
+        }
+
+        logger.buffer_.reset(new Record[size]);
+        for (size_t i = 0; i < size; ++i)
+        {
+            logger.buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        logger.buffer_mask_ = size - 1;
+        logger.enqueue_position_.store(0, std::memory_order_relaxed);
+        logger.dequeue_position_.store(0, std::memory_order_relaxed);
+        logger.block_ = block;
+
+        logger.running_.store(true, std::memory_order_release);
+        logger.async_ = true;
+        logger.writer_ = std::thread(&Logger::RunWriter, &logger);
+    }
+
+    void Logger::SetFile(const std::string& file_name)
+    {
+        Logger& logger = Instance();
+        Flush();
+
+        std::lock_guard<std::mutex> lock(logger.output_mutex_);
+        if (logger.file_.is_open())
+        {
+            logger.file_.close();
+        }
+
+        if (file_name.empty()) return;
+
+        logger.file_.open(file_name, std::ios::out | std::ios::app);
+        if (!logger.file_.is_open())
+        {
+            throw "Unable to open log file: " + file_name;
+        }
     }
-}
 
+    void Logger::Flush()
+    {
+        Logger& logger = Instance();
+        if (!logger.async_)
+        {
+            std::lock_guard<std::mutex> lock(logger.output_mutex_);
+            if (logger.file_.is_open()) logger.file_.flush();
+            std::cout.flush();
+            return;
+        }
+
+        // Wait for every message claimed so far
+        size_t position = logger.enqueue_position_.load(std::memory_order_acquire);
+        while (logger.dequeue_position_.load(std::memory_order_acquire) < position)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
@@ -5,6 +5,33 @@
 #ifndef GBMOT_LOGGER_H
 #define GBMOT_LOGGER_H
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * Logs a debug message. The message expression is only evaluated if the debug
+ * messages are logged, thus a disabled message costs a single branch.
+ * If GBMOT_STRIP_DEBUG_LOG is defined, debug messages are removed at compile
+ * time, the expression is still type checked.
+ */
+#ifdef GBMOT_STRIP_DEBUG_LOG
+#define GBMOT_LOG_DEBUG(message) \
+    do { if (false) util::Logger::LogDebug(message); } while (false)
+#else
+#define GBMOT_LOG_DEBUG(message) \
+    do { if (util::Logger::IsDebugEnabled()) util::Logger::LogDebug(message); } while (false)
+#endif
+
+/**
+ * Logs an info message. The message expression is only evaluated if the info
+ * messages are logged.
+ */
+#define GBMOT_LOG_INFO(message) \
+    do { if (util::Logger::IsInfoEnabled()) util::Logger::LogInfo(message); } while (false)
 
 namespace util
 {
@@ -12,15 +39,64 @@ namespace util
      * Utility class for logging.
      * Is a singleton.
      * Provides three different types of messages.
+     * Every message is prefixed with the time since the logger was created
+     * and the id of the logging thread.
+     * Messages are either written synchronously by the logging thread or
+     * passed through a bounded lock-free ring buffer to a background writer.
      */
     class Logger
     {
     private:
+        /**
+         * The type of a message
+         */
+        enum Level
+        {
+            LEVEL_INFO, LEVEL_ERROR, LEVEL_DEBUG
+        };
+
+        /**
+         * A slot in the ring buffer
+         */
+        struct Record
+        {
+            /**
+             * The position this slot is ready for, used to synchronize the
+             * producers and the writer
+             */
+            std::atomic<size_t> sequence;
+
+            /**
+             * The type of the message
+             */
+            Level level;
+
+            /**
+             * The time since the logger was created in microseconds
+             */
+            long long time;
+
+            /**
+             * The id of the logging thread
+             */
+            size_t thread;
+
+            /**
+             * The message to log
+             */
+            std::string message;
+        };
+
         /**
          * -> Singleton
          */
         Logger();
 
+        /**
+         * -> Singleton
+         */
+        ~Logger();
+
         /**
          * True, if the info messages should be logged
          */
@@ -31,17 +107,110 @@ namespace util
          */
         bool debug_;
 
+        /**
+         * The time the logger was created
+         */
+        std::chrono::steady_clock::time_point start_;
+
+        /**
+         * The file to write all messages to, if open
+         */
+        std::ofstream file_;
+
+        /**
+         * True, if all console messages should be written to the standard
+         * error instead of only the error messages
+         */
+        bool error_output_;
+
+        /**
+         * Guards the output streams
+         */
+        std::mutex output_mutex_;
+
+        /**
+         * True, if the messages are written by the background writer
+         */
+        bool async_;
+
+        /**
+         * True, if a full buffer blocks the logging thread, otherwise the
+         * message is dropped
+         */
+        bool block_;
+
+        /**
+         * The ring buffer, the size is a power of two
+         */
+        std::unique_ptr<Record[]> buffer_;
+
+        /**
+         * The size of the ring buffer minus one
+         */
+        size_t buffer_mask_;
+
+        /**
+         * The next position to write into
+         */
+        std::atomic<size_t> enqueue_position_;
+
+        /**
+         * The next position to read from, only changed by the writer
+         */
+        std::atomic<size_t> dequeue_position_;
+
+        /**
+         * The number of dropped messages since the last report
+         */
+        std::atomic<size_t> dropped_count_;
+
+        /**
+         * True, while the background writer should keep running
+         */
+        std::atomic<bool> running_;
+
+        /**
+         * The background writer
+         */
+        std::thread writer_;
+
         /**
          * Logs the given message.
+         * @param level The type of the message
          * @param message The message to log
          */
-        void LogMessage(const std::string& message);
+        void Log(Level level, const std::string& message);
 
         /**
-         * Logs the given error message.
-         * @param message The error message to log
+         * Writes a formatted message to the output.
+         * @param level The type of the message
+         * @param time The time of the message in microseconds
+         * @param thread The id of the logging thread
+         * @param message The message to write
          */
-        void LogErrorMessage(const std::string& message);
+        void Write(Level level, long long time, size_t thread, const std::string& message);
+
+        /**
+         * Writes all buffered messages until the logger is stopped.
+         */
+        void RunWriter();
+
+        /**
+         * Writes all messages currently in the buffer.
+         * @return True, if at least one message was written
+         */
+        bool Drain();
+
+        /**
+         * Stops the background writer after writing all buffered messages.
+         */
+        void StopWriter();
+
+        /**
+         * Gets a small unique id of the calling thread.
+         * @return The thread id
+         */
+        static size_t GetThreadId();
     public:
         /**
          * -> Singleton
@@ -75,17 +244,59 @@ namespace util
          */
         static void SetInfo(bool info);
 
+        /**
+         * Sets the asynchronous logging. In the asynchronous mode the messages
+         * are written by a background thread, the logging threads only copy
+         * the message into a ring buffer.
+         * Should be set before logging from multiple threads.
+         * @param async True, if the messages should be written asynchronously
+         * @param buffer_size The maximal number of buffered messages, rounded
+         *                    up to a power of two
+         * @param block True, if a full buffer blocks the logging thread,
+         *              otherwise the message is dropped and counted
+         */
+        static void SetAsync(bool async, size_t buffer_size = 4096, bool block = false);
+
+        /**
+         * Sets a file to write all messages to instead of the console.
+         * Should be set before logging from multiple threads.
+         * @param file_name The file to write to, empty to write to the console
+         */
+        static void SetFile(const std::string& file_name);
+
+        /**
+         * Sets all console messages to be written to the standard error, thus
+         * the standard output only contains the results.
+         * Should be set before logging from multiple threads.
+         * @param error_output True, if all messages should be written to the
+         *                     standard error
+         */
+        static void SetErrorOutput(bool error_output);
+
+        /**
+         * Waits until all messages logged so far are written.
+         */
+        static void Flush();
+
         /**
          * If the debug messages are logged.
+         * Inlined, because it is checked before every debug message.
          * @return True, if the debug messages are logged
          */
-        static bool IsDebugEnabled();
+        static bool IsDebugEnabled()
+        {
+            return Instance().debug_;
+        }
 
         /**
          * If the info messages are logged.
+         * Inlined, because it is checked before every info message.
          * @return True, if the info messages are logged
          */
-        static bool IsInfoEnabled();
+        static bool IsInfoEnabled()
+        {
+            return Instance().info_;
+        }
 
         /**
          * Logs the given message as an info message.
@@ -0,0 +1,191 @@
+#include "Memory.h"
+#include "Profiler.h"
+#include "../core/ObjectDataAngular.h"
+#include "../core/ObjectDataBox.h"
+#include "../core/Tracklet.h"
+#include <fstream>
+#include <limits>
+#include <unistd.h>
+
+namespace util
+{
+    namespace
+    {
+        // Approximate sizes of the allocations made by the containers
+        const size_t POINTER_SIZE = sizeof(void*);
+        const size_t SHARED_CONTROL_SIZE = 2 * POINTER_SIZE + 2 * sizeof(int);
+        const size_t LIST_NODE_SIZE = 2 * POINTER_SIZE;
+        const size_t HASH_NODE_SIZE = POINTER_SIZE + sizeof(size_t);
+    }
+
+    size_t Memory::GetResidentSize()
+    {
+        std::ifstream in("/proc/self/statm");
+        size_t total_pages = 0, resident_pages = 0;
+        if (!(in >> total_pages >> resident_pages))
+        {
+            return 0;
+        }
+
+        return resident_pages * (size_t) sysconf(_SC_PAGESIZE);
+    }
+
+    size_t Memory::GetPeakResidentSize()
+    {
+        std::ifstream in("/proc/self/status");
+        std::string key;
+        while (in >> key)
+        {
+            if (key == "VmHWM:")
+            {
+                size_t kilobytes = 0;
+                in >> kilobytes;
+                return kilobytes * 1024;
+            }
+
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+
+        return 0;
+    }
+
+    bool Memory::ResetPeakResidentSize()
+    {
+        // Writing 5 resets the high-water mark (since Linux 4.0)
+        std::ofstream out("/proc/self/clear_refs");
+        if (!out.is_open())
+        {
+            return false;
+        }
+
+        out << "5";
+        out.close();
+        return !out.fail();
+    }
+
+    size_t Memory::EstimateSize(const core::ObjectDataPtr& object)
+    {
+        if (!object)
+        {
+            return 0;
+        }
+
+        size_t size = SHARED_CONTROL_SIZE;
+        const core::ObjectData* data = object.get();
+        if (const core::Tracklet* tracklet = dynamic_cast<const core::Tracklet*>(data))
+        {
+            size += sizeof(core::Tracklet) +
+                    tracklet->GetPathObjectCount() * sizeof(core::ObjectDataPtr);
+        }
+        else if (dynamic_cast<const core::ObjectDataAngular*>(data))
+        {
+            size += sizeof(core::ObjectDataAngular);
+        }
+        else if (dynamic_cast<const core::ObjectDataBox*>(data))
+        {
+            size += sizeof(core::ObjectDataBox);
+        }
+        else if (dynamic_cast<const core::ObjectData2D*>(data))
+        {
+            size += sizeof(core::ObjectData2D);
+        }
+        else
+        {
+            size += sizeof(core::ObjectData);
+        }
+
+        return size;
+    }
+
+    size_t Memory::EstimateSize(const ValueMapVector& values)
+    {
+        size_t size = values.capacity() * sizeof(ValueMap);
+        for (auto& map : values)
+        {
+            size += map.bucket_count() * POINTER_SIZE;
+            for (auto& entry : map)
+            {
+                size += HASH_NODE_SIZE + sizeof(ValueMap::value_type) +
+                        (entry.first.capacity() > 15 ? entry.first.capacity() + 1 : 0);
+            }
+        }
+
+        return size;
+    }
+
+    size_t Memory::EstimateSize(const ValueTable& values)
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < values.GetColumnCount(); ++i)
+        {
+            size += sizeof(std::vector<double>) + values.GetColumn(i).capacity() * sizeof(double);
+        }
+
+        return size;
+    }
+
+    size_t Memory::EstimateSize(const core::DetectionSequence& sequence)
+    {
+        // Released frames are no longer stored, the frame count includes them
+        size_t size = (sequence.GetFrameCount() - sequence.GetFirstFrameIndex())
+                      * sizeof(std::vector<core::ObjectDataPtr>);
+        for (size_t i = sequence.GetFirstFrameIndex(); i < sequence.GetFrameCount(); ++i)
+        {
+            for (size_t j = 0; j < sequence.GetObjectCount(i); ++j)
+            {
+                size += sizeof(core::ObjectDataPtr) + EstimateSize(sequence.GetObject(i, j));
+            }
+        }
+
+        return size;
+    }
+
+    size_t Memory::EstimateSize(const Grid& grid)
+    {
+        size_t size = 0;
+        for (int z = 0; z < grid.GetDepthCount(); ++z)
+        {
+            size += sizeof(std::vector<std::vector<core::ObjectDataPtr>>);
+            for (int y = 0; y < grid.GetHeightCount(); ++y)
+            {
+                size += sizeof(std::vector<core::ObjectDataPtr>);
+                for (int x = 0; x < grid.GetWidthCount(); ++x)
+                {
+                    size += sizeof(core::ObjectDataPtr) + EstimateSize(grid.GetValue(x, y, z));
+                }
+            }
+        }
+
+        return size;
+    }
+
+    size_t Memory::EstimateSize(const DirectedGraph& graph)
+    {
+        return EstimateGraphSize(boost::num_vertices(graph), boost::num_edges(graph));
+    }
+
+    size_t Memory::EstimateGraphSize(size_t vertex_count, size_t edge_count)
+    {
+        // Every vertex stores its out edge list and its property in a vector,
+        // every out edge is a list node with the target and the property
+        size_t vertex_size = sizeof(DirectedGraph::stored_vertex);
+        size_t edge_size = LIST_NODE_SIZE + sizeof(Vertex) + POINTER_SIZE + sizeof(EdgeProp);
+
+        return vertex_count * vertex_size + edge_count * edge_size;
+    }
+
+    void Memory::Record(const std::string& name, size_t bytes)
+    {
+        if (!Profiler::IsEnabled()) return;
+
+        Profiler::RecordCounter(name + "_bytes", bytes);
+    }
+
+    void Memory::RecordResident()
+    {
+        if (!Profiler::IsEnabled()) return;
+
+        Profiler::RecordCounter("rss_bytes", GetResidentSize());
+        Profiler::RecordCounter("peak_rss_bytes", GetPeakResidentSize());
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef GBMOT_MEMORY_H
+#define GBMOT_MEMORY_H
+
+#include <string>
+#include "FileIO.h"
+#include "ValueTable.h"
+#include "Grid.h"
+#include "../core/DetectionSequence.h"
+#include "../graph/Definitions.h"
+
+namespace util
+{
+    /**
+     * Utility class for measuring the memory usage.
+     * The resident set size is read from the proc file system, the sizes of
+     * the data structures are estimated from their element counts, including
+     * the allocation overhead of the containers but not of the allocator.
+     * Objects shared between structures (e.g. the detections referenced by a
+     * graph) are only counted by the structure owning them.
+     */
+    class Memory
+    {
+    public:
+        /**
+         * Gets the current resident set size of this process.
+         * @return The resident set size in bytes, zero if not available
+         */
+        static size_t GetResidentSize();
+
+        /**
+         * Gets the peak resident set size (high-water mark) of this process.
+         * @return The peak resident set size in bytes, zero if not available
+         */
+        static size_t GetPeakResidentSize();
+
+        /**
+         * Resets the peak resident set size to the current resident set size,
+         * thus the peak of a single stage can be measured.
+         * @return True, if the peak was reset
+         */
+        static bool ResetPeakResidentSize();
+
+        /**
+         * Estimates the size of the given object, including the shared
+         * pointer control block.
+         * @param object The object
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateSize(const core::ObjectDataPtr& object);
+
+        /**
+         * Estimates the size of the given values.
+         * @param values The values
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateSize(const ValueMapVector& values);
+
+        /**
+         * Estimates the size of the given values.
+         * @param values The values
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateSize(const ValueTable& values);
+
+        /**
+         * Estimates the size of the given sequence including all detections.
+         * @param sequence The sequence
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateSize(const core::DetectionSequence& sequence);
+
+        /**
+         * Estimates the size of the given grid including all cell values.
+         * @param grid The grid
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateSize(const Grid& grid);
+
+        /**
+         * Estimates the size of the given graph without the objects
+         * referenced by the vertices.
+         * @param graph The graph
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateSize(const DirectedGraph& graph);
+
+        /**
+         * Estimates the size of a graph with the given vertex and edge count
+         * without the objects referenced by the vertices.
+         * @param vertex_count The vertex count
+         * @param edge_count The edge count
+         * @return The estimated size in bytes
+         */
+        static size_t EstimateGraphSize(size_t vertex_count, size_t edge_count);
+
+        /**
+         * Records the size of a data structure in the profiler as the counter
+         * <name>_bytes, relative to the current scope.
+         * Does nothing if the profiler is disabled.
+         * @param name The name of the data structure
+         * @param bytes The size in bytes
+         */
+        static void Record(const std::string& name, size_t bytes);
+
+        /**
+         * Records the current and the peak resident set size in the profiler
+         * as the counters rss_bytes and peak_rss_bytes, relative to the
+         * current scope.
+         * Does nothing if the profiler is disabled.
+         */
+        static void RecordResident();
+    };
+}
+
+
+#endif //GBMOT_MEMORY_H
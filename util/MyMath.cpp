@@ -53,6 +53,11 @@ namespace util
     {
         return (degree * PI) / 180.0;
     }
+
+    double MyMath::Degree(double radian)
+    {
+        return (radian * 180.0) / PI;
+    }
 }
 
 
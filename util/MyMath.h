@@ -69,6 +69,13 @@ namespace util
          * @return The arc value in radian
          */
         static double Radian(double degree);
+
+        /**
+         * Calculates the degree value of the given radian value.
+         * @param radian The arc value in radian
+         * @return The arc value in degree
+         */
+        static double Degree(double radian);
     };
 }
 
@@ -2,9 +2,12 @@
 // Created by wrede on 22.04.16.
 //
 
+#include <algorithm>
 #include "Parser.h"
 #include "MyMath.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include "Memory.h"
 #include "../core/ObjectDataAngular.h"
 #include "../core/ObjectDataBox.h"
 
@@ -25,14 +28,64 @@ namespace util
                                    double temporal_weight,
                                    double spatial_weight)
     {
-        util::Logger::LogInfo("Parsing ObjectData2D detections");
+        ValueTable table = CreateTable(values, { KEY_FRAME, KEY_X, KEY_Y, KEY_SCORE });
 
-        // Calculate max and min score to normalize the score
-        double max_score = std::numeric_limits<double>::min();
-        double min_score = std::numeric_limits<double>::max();
-        for (size_t line_index = 0; line_index < values.size(); ++line_index)
+        ParseObjectData2D(table, sequence, image_width, image_height,
+                          temporal_weight, spatial_weight);
+    }
+
+    void Parser::ParseObjectData2D(ValueTable& values,
+                                   core::DetectionSequence& sequence,
+                                   double image_width, double image_height,
+                                   double temporal_weight,
+                                   double spatial_weight)
+    {
+        util::ScopedTimer timer("parse");
+
+        GBMOT_LOG_INFO("Parsing ObjectData2D detections");
+
+        // Create objects and calculate max and min score to normalize the score
+        std::vector<core::ObjectDataPtr> objects;
+        double min_score, max_score;
+        CreateObjectData2D(values, sequence, image_width, image_height, temporal_weight,
+                           spatial_weight, objects, min_score, max_score);
+
+        GBMOT_LOG_DEBUG("min score " + std::to_string(min_score));
+        GBMOT_LOG_DEBUG("max score " + std::to_string(max_score));
+
+        NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score);
+
+        GBMOT_LOG_DEBUG("objects parsed " + std::to_string(objects.size()));
+        GBMOT_LOG_DEBUG("frame count " + std::to_string(sequence.GetFrameCount()));
+
+        if (util::Profiler::IsEnabled())
+        {
+            util::Memory::Record("sequence", util::Memory::EstimateSize(sequence));
+            util::Memory::RecordResident();
+        }
+    }
+
+    template<typename Table>
+    void Parser::CreateObjectData2D(Table& values,
+                                    core::DetectionSequence& sequence,
+                                    double image_width, double image_height,
+                                    double temporal_weight, double spatial_weight,
+                                    std::vector<core::ObjectDataPtr>& objects,
+                                    double& min_score, double& max_score)
+    {
+        // Resolve the columns once
+        const auto& frames = values.GetColumn(KEY_FRAME);
+        const auto& xs = values.GetColumn(KEY_X);
+        const auto& ys = values.GetColumn(KEY_Y);
+        const auto& scores = values.GetColumn(KEY_SCORE);
+
+        size_t obj_count = values.GetRowCount();
+        objects.reserve(objects.size() + obj_count);
+        max_score = std::numeric_limits<double>::min();
+        min_score = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < obj_count; ++i)
         {
-            double score = values[line_index][KEY_SCORE];
+            double score = scores[i];
             if (score > max_score)
             {
                 max_score = score;
@@ -41,37 +94,19 @@ namespace util
             {
                 min_score = score;
             }
-        }
 
-        util::Logger::LogDebug("min score " + std::to_string(min_score));
-        util::Logger::LogDebug("max score " + std::to_string(max_score));
-
-        // Create objects
-        size_t obj_count = 0;
-        for (size_t line_index = 0; line_index < values.size(); ++line_index)
-        {
-            size_t frame = (size_t) fabs(values[line_index][KEY_FRAME]);
-            double x = values[line_index][KEY_X] / image_width;
-            double y = values[line_index][KEY_Y] / image_height;
-            double score = values[line_index][KEY_SCORE];
-
-            cv::Point2d point(x, y);
+            size_t frame = (size_t) fabs(frames[i]);
+            cv::Point2d point(xs[i] / image_width, ys[i] / image_height);
 
             core::ObjectData2DPtr object(
                     new core::ObjectData2D(frame, point));
 
             object->SetTemporalWeight(temporal_weight);
             object->SetSpatialWeight(spatial_weight);
-            object->SetDetectionScore(
-                    util::MyMath::InverseLerp(min_score, max_score, score));
 
             sequence.AddObject(object);
-
-            obj_count++;
+            objects.push_back(object);
         }
-
-        util::Logger::LogDebug("objects parsed " + std::to_string(obj_count));
-        util::Logger::LogDebug("frame count " + std::to_string(sequence.GetFrameCount()));
     }
 
     void Parser::ParseObjectDataAngular(ValueMapVector& values,
@@ -82,46 +117,82 @@ namespace util
                                         double spatial_weight,
                                         double angular_weight)
     {
-        util::Logger::LogInfo("Parsing ObjectDataAngular detections");
+        ValueTable table = CreateTable(values,
+                                       { KEY_FRAME, KEY_X, KEY_Y, KEY_ANGLE, KEY_SCORE });
 
-        // Calculate max and min score to normalize the score
-        double max_score = std::numeric_limits<double>::min();
-        double min_score = std::numeric_limits<double>::max();
-        for (size_t line_index = 0; line_index < values.size(); ++line_index)
-        {
-            for (size_t object_i = 0; object_i < values[line_index].size();
-                 ++object_i)
-            {
-                double score = values[line_index][KEY_SCORE];
-                if (score > max_score)
-                {
-                    max_score = score;
-                }
-                if (score < min_score)
-                {
-                    min_score = score;
-                }
-            }
-        }
+        ParseObjectDataAngular(table, sequence, image_width, image_height,
+                               temporal_weight, spatial_weight, angular_weight);
+    }
 
-        util::Logger::LogDebug("min score " + std::to_string(min_score));
-        util::Logger::LogDebug("max score " + std::to_string(max_score));
+    void Parser::ParseObjectDataAngular(ValueTable& values,
+                                        core::DetectionSequence& sequence,
+                                        double image_width,
+                                        double image_height,
+                                        double temporal_weight,
+                                        double spatial_weight,
+                                        double angular_weight)
+    {
+        util::ScopedTimer timer("parse");
 
-        // Create objects
-        size_t obj_count = 0;
-        for (size_t line_index = 0; line_index < values.size(); ++line_index)
+        GBMOT_LOG_INFO("Parsing ObjectDataAngular detections");
+
+        // Create objects and calculate max and min score to normalize the score
+        std::vector<core::ObjectDataPtr> objects;
+        double min_score, max_score;
+        CreateObjectDataAngular(values, sequence, image_width, image_height, temporal_weight,
+                                spatial_weight, angular_weight, objects, min_score, max_score);
+
+        GBMOT_LOG_DEBUG("min score " + std::to_string(min_score));
+        GBMOT_LOG_DEBUG("max score " + std::to_string(max_score));
+
+        //TODO detection score interpolation (0.5 <-> 1.0) (experimental)
+        NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score, 0.5, 0.5);
+
+        GBMOT_LOG_DEBUG("objects parsed " + std::to_string(objects.size()));
+        GBMOT_LOG_DEBUG("frame count " + std::to_string(sequence.GetFrameCount()));
+
+        if (util::Profiler::IsEnabled())
         {
-            size_t frame = (size_t) fabs(values[line_index][KEY_FRAME]);
-            double x = values[line_index][KEY_X] / image_width;
-            double y = values[line_index][KEY_Y] / image_height;
-            double angle = MyMath::Radian(values[line_index][KEY_ANGLE]);
-            double score = values[line_index][KEY_SCORE];
+            util::Memory::Record("sequence", util::Memory::EstimateSize(sequence));
+            util::Memory::RecordResident();
+        }
+    }
 
-            //TODO detection score interpolation (0.5 <-> 1.0) (experimental)
-            score = util::MyMath::InverseLerp(min_score, max_score, score);
-            score = score * 0.5 + 0.5;
+    template<typename Table>
+    void Parser::CreateObjectDataAngular(Table& values,
+                                         core::DetectionSequence& sequence,
+                                         double image_width, double image_height,
+                                         double temporal_weight, double spatial_weight,
+                                         double angular_weight,
+                                         std::vector<core::ObjectDataPtr>& objects,
+                                         double& min_score, double& max_score)
+    {
+        // Resolve the columns once
+        const auto& frames = values.GetColumn(KEY_FRAME);
+        const auto& xs = values.GetColumn(KEY_X);
+        const auto& ys = values.GetColumn(KEY_Y);
+        const auto& angles = values.GetColumn(KEY_ANGLE);
+        const auto& scores = values.GetColumn(KEY_SCORE);
+
+        size_t obj_count = values.GetRowCount();
+        objects.reserve(objects.size() + obj_count);
+        max_score = std::numeric_limits<double>::min();
+        min_score = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < obj_count; ++i)
+        {
+            double score = scores[i];
+            if (score > max_score)
+            {
+                max_score = score;
+            }
+            if (score < min_score)
+            {
+                min_score = score;
+            }
 
-            cv::Point2d point(x, y);
+            size_t frame = (size_t) fabs(frames[i]);
+            cv::Point2d point(xs[i] / image_width, ys[i] / image_height);
+            double angle = MyMath::Radian(angles[i]);
 
             core::ObjectDataAngularPtr object(
                     new core::ObjectDataAngular(frame, point, angle));
@@ -129,15 +200,10 @@ namespace util
             object->SetTemporalWeight(temporal_weight);
             object->SetSpatialWeight(spatial_weight);
             object->SetAngularWeight(angular_weight);
-            object->SetDetectionScore(score);
 
             sequence.AddObject(object);
-
-            obj_count++;
+            objects.push_back(object);
         }
-
-        util::Logger::LogDebug("objects parsed " + std::to_string(obj_count));
-        util::Logger::LogDebug("frame count " + std::to_string(sequence.GetFrameCount()));
     }
 
     void Parser::ParseObjectDataBox(ValueMapVector& values,
@@ -147,14 +213,68 @@ namespace util
                                     double temporal_weight,
                                     double spatial_weight)
     {
-        util::Logger::LogInfo("Parsing ObjectDataBox detections");
+        ValueTable table = CreateTable(values, { KEY_FRAME, KEY_X, KEY_Y, KEY_WIDTH,
+                                                 KEY_HEIGHT, KEY_SCORE });
+
+        ParseObjectDataBox(table, sequence, image_width, image_height,
+                           temporal_weight, spatial_weight);
+    }
+
+    void Parser::ParseObjectDataBox(ValueTable& values,
+                                    core::DetectionSequence& sequence,
+                                    double image_width,
+                                    double image_height,
+                                    double temporal_weight,
+                                    double spatial_weight)
+    {
+        util::ScopedTimer timer("parse");
+
+        GBMOT_LOG_INFO("Parsing ObjectDataBox detections");
+
+        // Create objects and calculate max and min score to normalize the score
+        std::vector<core::ObjectDataPtr> objects;
+        double min_score, max_score;
+        CreateObjectDataBox(values, sequence, image_width, image_height, temporal_weight,
+                            spatial_weight, objects, min_score, max_score);
 
-        // Calculate max and min score to normalize the score
-        double max_score = std::numeric_limits<double>::min();
-        double min_score = std::numeric_limits<double>::max();
-        for (size_t line_index = 0; line_index < values.size(); ++line_index)
+        GBMOT_LOG_DEBUG("min score " + std::to_string(min_score));
+        GBMOT_LOG_DEBUG("max score " + std::to_string(max_score));
+
+        NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score);
+
+        GBMOT_LOG_DEBUG("objects parsed " + std::to_string(objects.size()));
+        GBMOT_LOG_DEBUG("frame count " + std::to_string(sequence.GetFrameCount()));
+
+        if (util::Profiler::IsEnabled())
+        {
+            util::Memory::Record("sequence", util::Memory::EstimateSize(sequence));
+            util::Memory::RecordResident();
+        }
+    }
+
+    template<typename Table>
+    void Parser::CreateObjectDataBox(Table& values,
+                                     core::DetectionSequence& sequence,
+                                     double image_width, double image_height,
+                                     double temporal_weight, double spatial_weight,
+                                     std::vector<core::ObjectDataPtr>& objects,
+                                     double& min_score, double& max_score)
+    {
+        // Resolve the columns once
+        const auto& frames = values.GetColumn(KEY_FRAME);
+        const auto& xs = values.GetColumn(KEY_X);
+        const auto& ys = values.GetColumn(KEY_Y);
+        const auto& widths = values.GetColumn(KEY_WIDTH);
+        const auto& heights = values.GetColumn(KEY_HEIGHT);
+        const auto& scores = values.GetColumn(KEY_SCORE);
+
+        size_t obj_count = values.GetRowCount();
+        objects.reserve(objects.size() + obj_count);
+        max_score = std::numeric_limits<double>::min();
+        min_score = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < obj_count; ++i)
         {
-            double score = values[line_index][KEY_SCORE];
+            double score = scores[i];
             if (score > max_score)
             {
                 max_score = score;
@@ -163,40 +283,229 @@ namespace util
             {
                 min_score = score;
             }
-        }
 
-        util::Logger::LogDebug("min score " + std::to_string(min_score));
-        util::Logger::LogDebug("max score " + std::to_string(max_score));
-
-        // Create objects
-        size_t obj_count = 0;
-        for (size_t line_index = 0; line_index < values.size(); ++line_index)
-        {
-            size_t frame = (size_t) fabs(values[line_index][KEY_FRAME]);
-            double x = values[line_index][KEY_X] / image_width;
-            double y = values[line_index][KEY_Y] / image_height;
-            double width = values[line_index][KEY_WIDTH] / image_width;
-            double height = values[line_index][KEY_HEIGHT] / image_height;
-            double score = values[line_index][KEY_SCORE];
-
-            cv::Point2d point(x, y);
-            cv::Point2d size(width, height);
+            size_t frame = (size_t) fabs(frames[i]);
+            cv::Point2d point(xs[i] / image_width, ys[i] / image_height);
+            cv::Point2d size(widths[i] / image_width, heights[i] / image_height);
 
             core::ObjectDataBoxPtr object(
                     new core::ObjectDataBox(frame, point, size));
 
             object->SetTemporalWeight(temporal_weight);
             object->SetSpatialWeight(spatial_weight);
-            object->SetDetectionScore(
-                    util::MyMath::InverseLerp(min_score, max_score, score));
 
             sequence.AddObject(object);
+            objects.push_back(object);
+        }
+    }
+
+    void Parser::AddMissingColumns(ValueTable& values)
+    {
+        for (auto& key : { KEY_FRAME, KEY_X, KEY_Y, KEY_WIDTH, KEY_HEIGHT, KEY_ANGLE, KEY_SCORE })
+        {
+            values.GetColumn(key);
+        }
+    }
+
+    void Parser::ParseObjectData(ValueTable& values,
+                                 core::DetectionSequence& sequence,
+                                 const std::string& input_format,
+                                 double image_width, double image_height,
+                                 double temporal_weight, double spatial_weight,
+                                 double angular_weight)
+    {
+        if (input_format == "2D")
+        {
+            ParseObjectData2D(values, sequence, image_width, image_height,
+                              temporal_weight, spatial_weight);
+        }
+        else if (input_format == "Box")
+        {
+            ParseObjectDataBox(values, sequence, image_width, image_height,
+                               temporal_weight, spatial_weight);
+        }
+        else if (input_format == "Angular")
+        {
+            ParseObjectDataAngular(values, sequence, image_width, image_height,
+                                   temporal_weight, spatial_weight, angular_weight);
+        }
+        else
+        {
+            throw "Unknown input format: " + input_format;
+        }
+    }
+
+    void Parser::ParseObjectData(ValueTable& values,
+                                 core::DetectionSequence& sequence,
+                                 const std::string& input_format,
+                                 double image_width, double image_height,
+                                 double temporal_weight, double spatial_weight,
+                                 double angular_weight,
+                                 double min_score, double max_score)
+    {
+        util::ScopedTimer timer("parse");
+
+        std::vector<core::ObjectDataPtr> objects;
+        double value_min_score, value_max_score;
+        if (input_format == "2D")
+        {
+            CreateObjectData2D(values, sequence, image_width, image_height, temporal_weight,
+                               spatial_weight, objects, value_min_score, value_max_score);
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score);
+        }
+        else if (input_format == "Box")
+        {
+            CreateObjectDataBox(values, sequence, image_width, image_height, temporal_weight,
+                                spatial_weight, objects, value_min_score, value_max_score);
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score);
+        }
+        else if (input_format == "Angular")
+        {
+            CreateObjectDataAngular(values, sequence, image_width, image_height,
+                                    temporal_weight, spatial_weight, angular_weight,
+                                    objects, value_min_score, value_max_score);
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score,
+                            0.5, 0.5);
+        }
+        else
+        {
+            throw "Unknown input format: " + input_format;
+        }
+
+        if (util::Profiler::IsEnabled())
+        {
+            util::Memory::Record("sequence", util::Memory::EstimateSize(sequence));
+            util::Memory::RecordResident();
+        }
+    }
+
+    void Parser::ParseObjectData(const DetectionArrays& values,
+                                 core::DetectionSequence& sequence,
+                                 const std::string& input_format,
+                                 double image_width, double image_height,
+                                 double temporal_weight, double spatial_weight,
+                                 double angular_weight)
+    {
+        util::ScopedTimer timer("parse");
+
+        std::vector<core::ObjectDataPtr> objects;
+        double min_score, max_score;
+        CreateObjectData(values, sequence, input_format, image_width, image_height,
+                         temporal_weight, spatial_weight, angular_weight,
+                         objects, min_score, max_score);
+
+        // Angular objects have a score of at least one half
+        if (input_format == "Angular")
+        {
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score,
+                            0.5, 0.5);
+        }
+        else
+        {
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score);
+        }
+    }
+
+    void Parser::ParseObjectData(const DetectionArrays& values,
+                                 core::DetectionSequence& sequence,
+                                 const std::string& input_format,
+                                 double image_width, double image_height,
+                                 double temporal_weight, double spatial_weight,
+                                 double angular_weight,
+                                 double min_score, double max_score)
+    {
+        util::ScopedTimer timer("parse");
+
+        std::vector<core::ObjectDataPtr> objects;
+        double value_min_score, value_max_score;
+        CreateObjectData(values, sequence, input_format, image_width, image_height,
+                         temporal_weight, spatial_weight, angular_weight,
+                         objects, value_min_score, value_max_score);
+
+        if (input_format == "Angular")
+        {
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score,
+                            0.5, 0.5);
+        }
+        else
+        {
+            NormalizeScores(objects, values.GetColumn(KEY_SCORE), min_score, max_score);
+        }
+    }
+
+    template<typename Table>
+    void Parser::CreateObjectData(Table& values,
+                                  core::DetectionSequence& sequence,
+                                  const std::string& input_format,
+                                  double image_width, double image_height,
+                                  double temporal_weight, double spatial_weight,
+                                  double angular_weight,
+                                  std::vector<core::ObjectDataPtr>& objects,
+                                  double& min_score, double& max_score)
+    {
+        if (input_format == "2D")
+        {
+            CreateObjectData2D(values, sequence, image_width, image_height, temporal_weight,
+                               spatial_weight, objects, min_score, max_score);
+        }
+        else if (input_format == "Box")
+        {
+            CreateObjectDataBox(values, sequence, image_width, image_height, temporal_weight,
+                                spatial_weight, objects, min_score, max_score);
+        }
+        else if (input_format == "Angular")
+        {
+            CreateObjectDataAngular(values, sequence, image_width, image_height,
+                                    temporal_weight, spatial_weight, angular_weight,
+                                    objects, min_score, max_score);
+        }
+        else
+        {
+            throw "Unknown input format: " + input_format;
+        }
+    }
+
+    ValueTable Parser::CreateTable(const ValueMapVector& values,
+                                   const std::vector<std::string>& keys)
+    {
+        if (util::Profiler::IsEnabled())
+        {
+            util::Memory::Record("values", util::Memory::EstimateSize(values));
+        }
+
+        ValueTable table(keys);
+        table.Reserve(values.size());
+
+        std::vector<double> row(keys.size());
+        for (const ValueMap& map : values)
+        {
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                auto iter = map.find(keys[i]);
+                row[i] = (iter != map.end()) ? iter->second : 0.0;
+            }
 
-            obj_count++;
+            table.AppendRow(row);
         }
 
-        util::Logger::LogDebug("objects parsed " + std::to_string(obj_count));
-        util::Logger::LogDebug("frame count " + std::to_string(sequence.GetFrameCount()));
+        return table;
+    }
+
+    template<typename Column>
+    void Parser::NormalizeScores(std::vector<core::ObjectDataPtr>& objects,
+                                 const Column& scores,
+                                 double min_score, double max_score,
+                                 double multiplier, double offset)
+    {
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            // A fixed score range may not contain every score, clamp them to
+            // keep the edge costs within their range
+            double score = util::MyMath::InverseLerp(min_score, max_score, scores[i]);
+            score = std::min(1.0, std::max(0.0, score));
+
+            objects[i]->SetDetectionScore(score * multiplier + offset);
+        }
     }
 
     Grid Parser::ParseGrid(core::DetectionSequence& sequence,
@@ -204,6 +513,8 @@ namespace util
                            double min_x, double max_x, int res_x,
                            double min_y, double max_y, int res_y)
     {
+        util::ScopedTimer timer("grid");
+
         stop = std::min(stop, sequence.GetFrameCount());
         int res_z = (int) (stop - start);
         double width = max_x - min_x;
@@ -7,8 +7,10 @@
 
 #include "../core/DetectionSequence.h"
 #include "../core/ObjectData.h"
+#include "DetectionArrays.h"
 #include "Grid.h"
 #include "FileIO.h"
+#include "ValueTable.h"
 #include <opencv2/core/core.hpp>
 
 namespace util
@@ -53,6 +55,27 @@ namespace util
                                        double temporal_weight,
                                        double spatial_weight);
 
+        /**
+         * Parses the specified values into the specified sequence in a single
+         * pass over the columns. The score is normalized afterwards.
+         * The used format is ObjectData2D.
+         *
+         * @param values The input values
+         * @param sequence The output sequence containing the parsed values
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         */
+        static void ParseObjectData2D(ValueTable& values,
+                                       core::DetectionSequence& sequence,
+                                       double image_width,
+                                       double image_height,
+                                       double temporal_weight,
+                                       double spatial_weight);
+
         /**
          * Parses the specified values into the specified sequence.
          * The used format is ObjectDataBox.
@@ -73,6 +96,27 @@ namespace util
                                        double temporal_weight,
                                        double spatial_weight);
 
+        /**
+         * Parses the specified values into the specified sequence in a single
+         * pass over the columns. The score is normalized afterwards.
+         * The used format is ObjectDataBox.
+         *
+         * @param values The input values
+         * @param sequence The output sequence containing the parsed values
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         */
+        static void ParseObjectDataBox(ValueTable& values,
+                                       core::DetectionSequence& sequence,
+                                       double image_width,
+                                       double image_height,
+                                       double temporal_weight,
+                                       double spatial_weight);
+
         /**
          * Parses the specified values into the specified sequence.
          * The used format is ObjectDataAngular.
@@ -95,6 +139,152 @@ namespace util
                                            double spatial_weight,
                                            double angular_weight);
 
+        /**
+         * Parses the specified values into the specified sequence in a single
+         * pass over the columns. The score is normalized afterwards.
+         * The used format is ObjectDataAngular.
+         *
+         * @param values The input values
+         * @param sequence The sequence to store the created objects in
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         */
+        static void ParseObjectDataAngular(ValueTable& values,
+                                           core::DetectionSequence& sequence,
+                                           double image_width,
+                                           double image_height,
+                                           double temporal_weight,
+                                           double spatial_weight,
+                                           double angular_weight);
+
+        /**
+         * Parses the specified values into the specified sequence with the
+         * specified format in a single pass over the columns. The score is
+         * normalized afterwards.
+         *
+         * @param values The input values
+         * @param sequence The sequence to store the created objects in
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight, only used by Angular
+         */
+        static void ParseObjectData(ValueTable& values,
+                                    core::DetectionSequence& sequence,
+                                    const std::string& input_format,
+                                    double image_width,
+                                    double image_height,
+                                    double temporal_weight,
+                                    double spatial_weight,
+                                    double angular_weight);
+
+        /**
+         * Parses the specified values into the specified sequence with the
+         * specified format. The score is normalized with the given score range
+         * instead of the range of the values, thus a sequence can be parsed
+         * in multiple parts.
+         *
+         * @param values The input values
+         * @param sequence The sequence to store the created objects in
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         * @param min_score The score that is normalized to zero
+         * @param max_score The score that is normalized to one
+         */
+        static void ParseObjectData(ValueTable& values,
+                                    core::DetectionSequence& sequence,
+                                    const std::string& input_format,
+                                    double image_width,
+                                    double image_height,
+                                    double temporal_weight,
+                                    double spatial_weight,
+                                    double angular_weight,
+                                    double min_score,
+                                    double max_score);
+
+        /**
+         * Parses the specified detection arrays into the specified sequence
+         * with the specified format. The values are read in place, the score
+         * is normalized with the score range of the detections.
+         *
+         * @param values The detections
+         * @param sequence The sequence to store the created objects in
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight, only used by Angular
+         */
+        static void ParseObjectData(const DetectionArrays& values,
+                                    core::DetectionSequence& sequence,
+                                    const std::string& input_format,
+                                    double image_width,
+                                    double image_height,
+                                    double temporal_weight,
+                                    double spatial_weight,
+                                    double angular_weight);
+
+        /**
+         * Parses the specified detection arrays into the specified sequence
+         * with the specified format. The values are read in place, the score
+         * is normalized with the given score range, thus a sequence can be
+         * parsed in multiple parts.
+         *
+         * @param values The detections
+         * @param sequence The sequence to store the created objects in
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         * @param min_score The score that is normalized to zero
+         * @param max_score The score that is normalized to one
+         */
+        static void ParseObjectData(const DetectionArrays& values,
+                                    core::DetectionSequence& sequence,
+                                    const std::string& input_format,
+                                    double image_width,
+                                    double image_height,
+                                    double temporal_weight,
+                                    double spatial_weight,
+                                    double angular_weight,
+                                    double min_score,
+                                    double max_score);
+
+        /**
+         * Adds a column filled with zeros for every value read by the object
+         * formats but missing in the given table. Afterwards parsing does
+         * not change the table, thus it can be parsed by multiple threads.
+         *
+         * @param values The table to complete
+         */
+        static void AddMissingColumns(ValueTable& values);
+
         /**
          * Parses the given sequence into a grid.
          * The sequence data need to be a ObjectData2D.
@@ -116,6 +306,143 @@ namespace util
                 size_t start, size_t stop,
                 double min_x, double max_x, int res_x,
                 double min_y, double max_y, int res_y);
+    private:
+        /**
+         * Creates an ObjectData2D for every row and adds it to the sequence.
+         * The score is not set, but the score range is calculated in the same
+         * pass.
+         *
+         * @param values The input values, a ValueTable or DetectionArrays
+         * @param sequence The sequence to store the created objects in
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param objects The vector to append the created objects to
+         * @param min_score The minimal score of all rows
+         * @param max_score The maximal score of all rows
+         */
+        template<typename Table>
+        static void CreateObjectData2D(Table& values,
+                                       core::DetectionSequence& sequence,
+                                       double image_width, double image_height,
+                                       double temporal_weight, double spatial_weight,
+                                       std::vector<core::ObjectDataPtr>& objects,
+                                       double& min_score, double& max_score);
+
+        /**
+         * Creates an ObjectDataBox for every row and adds it to the sequence.
+         * The score is not set, but the score range is calculated in the same
+         * pass.
+         *
+         * @param values The input values, a ValueTable or DetectionArrays
+         * @param sequence The sequence to store the created objects in
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param objects The vector to append the created objects to
+         * @param min_score The minimal score of all rows
+         * @param max_score The maximal score of all rows
+         */
+        template<typename Table>
+        static void CreateObjectDataBox(Table& values,
+                                        core::DetectionSequence& sequence,
+                                        double image_width, double image_height,
+                                        double temporal_weight, double spatial_weight,
+                                        std::vector<core::ObjectDataPtr>& objects,
+                                        double& min_score, double& max_score);
+
+        /**
+         * Creates an ObjectDataAngular for every row and adds it to the
+         * sequence. The score is not set, but the score range is calculated in
+         * the same pass.
+         *
+         * @param values The input values, a ValueTable or DetectionArrays
+         * @param sequence The sequence to store the created objects in
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight
+         * @param objects The vector to append the created objects to
+         * @param min_score The minimal score of all rows
+         * @param max_score The maximal score of all rows
+         */
+        template<typename Table>
+        static void CreateObjectDataAngular(Table& values,
+                                            core::DetectionSequence& sequence,
+                                            double image_width, double image_height,
+                                            double temporal_weight, double spatial_weight,
+                                            double angular_weight,
+                                            std::vector<core::ObjectDataPtr>& objects,
+                                            double& min_score, double& max_score);
+
+        /**
+         * Creates an object of the given format for every row and adds it to
+         * the sequence. The score is not set, but the score range is
+         * calculated in the same pass.
+         *
+         * @param values The input values, a ValueTable or DetectionArrays
+         * @param sequence The sequence to store the created objects in
+         * @param input_format The format to parse, valid formats are:
+         *                     2D, Box, Angular
+         * @param image_width The width of the image used for normalized
+         *                    coordinates
+         * @param image_height The height of the image used for normalized
+         *                     coordinates
+         * @param temporal_weight The temporal weight
+         * @param spatial_weight The spatial weight
+         * @param angular_weight The angular weight, only used by Angular
+         * @param objects The vector to append the created objects to
+         * @param min_score The minimal score of all rows
+         * @param max_score The maximal score of all rows
+         */
+        template<typename Table>
+        static void CreateObjectData(Table& values,
+                                     core::DetectionSequence& sequence,
+                                     const std::string& input_format,
+                                     double image_width, double image_height,
+                                     double temporal_weight, double spatial_weight,
+                                     double angular_weight,
+                                     std::vector<core::ObjectDataPtr>& objects,
+                                     double& min_score, double& max_score);
+
+        /**
+         * Copies the values with the given keys into a column wise table.
+         * Missing values are stored as zero.
+         *
+         * @param values The input values
+         * @param keys The keys of the values to copy
+         * @return The table containing one column per key
+         */
+        static ValueTable CreateTable(const ValueMapVector& values,
+                                      const std::vector<std::string>& keys);
+
+        /**
+         * Sets the normalized score of every object.
+         * The score is normalized into [0, 1] with the given minimum and
+         * maximum, then multiplied and shifted by the given values. Scores
+         * outside of the given range are clamped to it.
+         *
+         * @param objects The objects to set the score of
+         * @param scores The raw scores, one per object
+         * @param min_score The minimal raw score
+         * @param max_score The maximal raw score
+         * @param multiplier The value to multiply the normalized score with
+         * @param offset The value to add to the multiplied score
+         */
+        template<typename Column>
+        static void NormalizeScores(std::vector<core::ObjectDataPtr>& objects,
+                                    const Column& scores,
+                                    double min_score, double max_score,
+                                    double multiplier = 1.0, double offset = 0.0);
     };
 }
 
@@ -0,0 +1,194 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace util
+{
+    namespace
+    {
+        /**
+         * Adds a value to the entry with the given path.
+         */
+        void Aggregate(std::map<std::string, Profiler::Entry>& entries, const std::string& path,
+                       long long value)
+        {
+            auto iter = entries.find(path);
+            if (iter == entries.end())
+            {
+                Profiler::Entry entry = { 0, 0, std::numeric_limits<long long>::max(),
+                                          std::numeric_limits<long long>::min() };
+                iter = entries.insert(std::make_pair(path, entry)).first;
+            }
+
+            Profiler::Entry& entry = iter->second;
+            ++entry.count;
+            entry.total += value;
+            entry.min = std::min(entry.min, value);
+            entry.max = std::max(entry.max, value);
+        }
+
+        /**
+         * Writes the entries as JSON objects, the unit is appended to the
+         * value names.
+         */
+        void WriteJSON(std::ostream& out, const std::map<std::string, Profiler::Entry>& entries,
+                       const std::string& unit)
+        {
+            bool first = true;
+            for (auto& entry : entries)
+            {
+                out << (first ? "\n" : ",\n");
+                out << "    {\"name\": \"" << entry.first << "\""
+                    << ", \"count\": " << entry.second.count
+                    << ", \"total" << unit << "\": " << entry.second.total
+                    << ", \"mean" << unit << "\": " << entry.second.total / (long long) entry.second.count
+                    << ", \"min" << unit << "\": " << entry.second.min
+                    << ", \"max" << unit << "\": " << entry.second.max << "}";
+                first = false;
+            }
+        }
+
+        /**
+         * Writes the entries as CSV lines with the given type.
+         */
+        void WriteCSV(std::ostream& out, const std::map<std::string, Profiler::Entry>& entries,
+                      const std::string& type)
+        {
+            for (auto& entry : entries)
+            {
+                out << entry.first << ";"
+                    << type << ";"
+                    << entry.second.count << ";"
+                    << entry.second.total << ";"
+                    << entry.second.total / (long long) entry.second.count << ";"
+                    << entry.second.min << ";"
+                    << entry.second.max << "\n";
+            }
+        }
+    }
+
+    Profiler::Profiler() : enabled_(false)
+    {
+        /* EMPTY */
+    }
+
+    void Profiler::SetEnabled(bool enabled)
+    {
+        Instance().enabled_ = enabled;
+    }
+
+    void Profiler::Record(const std::string& path, long long time)
+    {
+        Profiler& profiler = Instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        Aggregate(profiler.entries_, path, time);
+    }
+
+    void Profiler::RecordCounter(const std::string& name, long long value)
+    {
+        if (!IsEnabled()) return;
+
+        const std::string& scope = GetScopePath();
+        std::string path = scope.empty() ? name : scope + "/" + name;
+
+        Profiler& profiler = Instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        Aggregate(profiler.counters_, path, value);
+    }
+
+    std::string& Profiler::GetScopePath()
+    {
+        thread_local std::string path;
+        return path;
+    }
+
+    void Profiler::Clear()
+    {
+        Profiler& profiler = Instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        profiler.entries_.clear();
+        profiler.counters_.clear();
+    }
+
+    std::map<std::string, Profiler::Entry> Profiler::GetEntries()
+    {
+        Profiler& profiler = Instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        return profiler.entries_;
+    }
+
+    std::map<std::string, Profiler::Entry> Profiler::GetCounters()
+    {
+        Profiler& profiler = Instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex_);
+        return profiler.counters_;
+    }
+
+    void Profiler::WriteReport(const std::string& file_name)
+    {
+        std::map<std::string, Entry> entries = GetEntries();
+        std::map<std::string, Entry> counters = GetCounters();
+
+        std::ofstream out(file_name, std::ios::out);
+        if (!out.is_open())
+        {
+            throw "Unable to open file: " + file_name;
+        }
+
+        bool json = file_name.size() >= 5 &&
+                    file_name.compare(file_name.size() - 5, 5, ".json") == 0;
+
+        // The paths contain no quotes or delimiters, thus need no escaping
+        if (json)
+        {
+            out << "{\n  \"timers\": [";
+            WriteJSON(out, entries, "_ns");
+            out << "\n  ],\n  \"counters\": [";
+            WriteJSON(out, counters, "");
+            out << "\n  ]\n}\n";
+        }
+        else
+        {
+            out << "name;type;count;total;mean;min;max\n";
+            WriteCSV(out, entries, "ns");
+            WriteCSV(out, counters, "counter");
+        }
+    }
+
+    ScopedTimer::ScopedTimer(const std::string& name)
+            : active_(Profiler::IsEnabled()), parent_length_(0)
+    {
+        if (active_)
+        {
+            std::string& path = Profiler::GetScopePath();
+            parent_length_ = path.size();
+            if (!path.empty())
+            {
+                path += "/";
+            }
+            path += name;
+
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ScopedTimer::~ScopedTimer()
+    {
+        Stop();
+    }
+
+    void ScopedTimer::Stop()
+    {
+        if (active_)
+        {
+            long long time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_).count();
+
+            std::string& path = Profiler::GetScopePath();
+            Profiler::Record(path, time);
+            path.resize(parent_length_);
+            active_ = false;
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef GBMOT_PROFILER_H
+#define GBMOT_PROFILER_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <chrono>
+
+namespace util
+{
+    /**
+     * Utility class for measuring the time spent in the stages of a run.
+     * Is a singleton.
+     * The times are recorded by scoped timers and aggregated by the name of
+     * the scope. Nested scopes are named by the path of all enclosing scopes
+     * in the same thread, e.g. "berclaz/batch/graph".
+     * Counters, e.g. the edge relaxations of a solver, are aggregated the
+     * same way and named relative to the current scope.
+     */
+    class Profiler
+    {
+    public:
+        /**
+         * The aggregated values of one scope, times are in nanoseconds
+         */
+        struct Entry
+        {
+            size_t count;
+            long long total;
+            long long min;
+            long long max;
+        };
+    private:
+        /**
+         * -> Singleton
+         */
+        Profiler();
+
+        /**
+         * True, if the timers should record
+         */
+        bool enabled_;
+
+        /**
+         * The aggregated times by the path of the scope
+         */
+        std::map<std::string, Entry> entries_;
+
+        /**
+         * The aggregated counter values by the path of the counter
+         */
+        std::map<std::string, Entry> counters_;
+
+        /**
+         * Guards the entries and the counters
+         */
+        std::mutex mutex_;
+    public:
+        /**
+         * -> Singleton
+         */
+        Profiler(Profiler const&) = delete;
+
+        /**
+         * -> Singleton
+         */
+        void operator=(Profiler const&) = delete;
+
+        /**
+         * Gets THE instance of this singleton.
+         * Creates a new instance if not already created.
+         */
+        static Profiler& Instance()
+        {
+            static Profiler instance;
+            return instance;
+        }
+
+        /**
+         * Sets if the timers should record.
+         * @param enabled True, if the timers should record
+         */
+        static void SetEnabled(bool enabled);
+
+        /**
+         * If the timers record.
+         * @return True, if the timers record
+         */
+        static bool IsEnabled()
+        {
+            return Instance().enabled_;
+        }
+
+        /**
+         * Adds a measured time to the given scope.
+         * @param path The path of the scope
+         * @param time The measured time in nanoseconds
+         */
+        static void Record(const std::string& path, long long time);
+
+        /**
+         * Adds a counter value to the counter with the given name in the
+         * current scope of the calling thread.
+         * Does nothing if the profiler is disabled.
+         * @param name The name of the counter
+         * @param value The value to add
+         */
+        static void RecordCounter(const std::string& name, long long value);
+
+        /**
+         * Gets the path of the current scope of the calling thread.
+         * @return The scope path
+         */
+        static std::string& GetScopePath();
+
+        /**
+         * Removes all recorded times and counters.
+         */
+        static void Clear();
+
+        /**
+         * Gets a copy of all recorded times.
+         * @return The aggregated times by the path of the scope
+         */
+        static std::map<std::string, Entry> GetEntries();
+
+        /**
+         * Gets a copy of all recorded counters.
+         * @return The aggregated counter values by the path of the counter
+         */
+        static std::map<std::string, Entry> GetCounters();
+
+        /**
+         * Writes all recorded times and counters into the given file.
+         * Files ending with .json are written as JSON, all other files as CSV.
+         * @param file_name The file to write into
+         */
+        static void WriteReport(const std::string& file_name);
+    };
+
+    /**
+     * Measures the time until it is destroyed and records it in the profiler.
+     * Does nothing if the profiler is disabled when the timer is created.
+     */
+    class ScopedTimer
+    {
+    private:
+        /**
+         * True, if the profiler was enabled on creation
+         */
+        bool active_;
+
+        /**
+         * The length of the enclosing scope path
+         */
+        size_t parent_length_;
+
+        /**
+         * The time the timer was created
+         */
+        std::chrono::steady_clock::time_point start_;
+    public:
+        /**
+         * Starts measuring the scope with the given name.
+         * @param name The name of the scope, appended to the enclosing scope
+         */
+        ScopedTimer(const std::string& name);
+
+        /**
+         * Stops measuring and records the time, if not already stopped.
+         */
+        ~ScopedTimer();
+
+        /**
+         * Stops measuring and records the time before the end of the scope.
+         */
+        void Stop();
+
+        ScopedTimer(ScopedTimer const&) = delete;
+
+        void operator=(ScopedTimer const&) = delete;
+    };
+}
+
+
+#endif //GBMOT_PROFILER_H
@@ -0,0 +1,90 @@
+#include "Random.h"
+#include "MyMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace util
+{
+    namespace
+    {
+        // Larger means are split into parts, the product of the uniform
+        // values would underflow otherwise
+        const double MAX_POISSON_PART = 500.0;
+    }
+
+    Random::Random(uint64_t seed)
+            : engine_(seed),
+              has_next_normal_(false),
+              next_normal_(0.0)
+    {
+    }
+
+    double Random::Uniform()
+    {
+        // The upper 53 bits fill the mantissa of a double
+        return (engine_() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double Random::Uniform(double min, double max)
+    {
+        return min + (max - min) * Uniform();
+    }
+
+    int Random::UniformInt(int min, int max)
+    {
+        // The bias of the modulo is negligible for the small ranges used
+        uint64_t range = (uint64_t) ((int64_t) max - (int64_t) min) + 1;
+        return (int) ((int64_t) min + (int64_t) (engine_() % range));
+    }
+
+    bool Random::Bernoulli(double probability)
+    {
+        return Uniform() < probability;
+    }
+
+    double Random::Normal(double mean, double deviation)
+    {
+        if (has_next_normal_)
+        {
+            has_next_normal_ = false;
+            return mean + deviation * next_normal_;
+        }
+
+        // One minus the value is in (0, 1], thus the logarithm is finite
+        double radius = std::sqrt(-2.0 * std::log(1.0 - Uniform()));
+        double angle = 2.0 * MyMath::PI * Uniform();
+
+        next_normal_ = radius * std::sin(angle);
+        has_next_normal_ = true;
+
+        return mean + deviation * radius * std::cos(angle);
+    }
+
+    size_t Random::SmallPoisson(double mean)
+    {
+        double limit = std::exp(-mean);
+        double product = Uniform();
+        size_t count = 0;
+        while (product > limit)
+        {
+            product *= Uniform();
+            ++count;
+        }
+
+        return count;
+    }
+
+    size_t Random::Poisson(double mean)
+    {
+        // The sum of poisson distributed values is poisson distributed
+        size_t count = 0;
+        while (mean > 0.0)
+        {
+            double part = std::min(mean, MAX_POISSON_PART);
+            count += SmallPoisson(part);
+            mean -= part;
+        }
+
+        return count;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef GBMOT_RANDOM_H
+#define GBMOT_RANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace util
+{
+    /**
+     * Random number generator with the same sequence on every standard library.
+     * The engine of the standard library is fully specified, but its
+     * distributions are implementation-defined, thus the values are
+     * transformed here. Generated data and the golden tracks of the
+     * regression cases depend on these sequences.
+     */
+    class Random
+    {
+    private:
+        /**
+         * The engine, its raw output is equal on every standard library
+         */
+        std::mt19937_64 engine_;
+
+        /**
+         * True, if the second value of the last normal pair is unused
+         */
+        bool has_next_normal_;
+
+        /**
+         * The second value of the last normal pair
+         */
+        double next_normal_;
+
+        /**
+         * Draws a poisson distributed value by multiplying uniform values.
+         * @param mean The mean, at most a few hundred to not underflow
+         * @return The value
+         */
+        size_t SmallPoisson(double mean);
+    public:
+        /**
+         * Creates a generator with the given seed.
+         * @param seed The seed of all values
+         */
+        explicit Random(uint64_t seed);
+
+        /**
+         * Draws a uniformly distributed value in [0, 1).
+         * @return The value
+         */
+        double Uniform();
+
+        /**
+         * Draws a uniformly distributed value in [min, max).
+         * @param min The minimum value
+         * @param max The maximum value
+         * @return The value
+         */
+        double Uniform(double min, double max);
+
+        /**
+         * Draws a uniformly distributed integer in [min, max].
+         * @param min The minimum value
+         * @param max The maximum value, not less than min
+         * @return The value
+         */
+        int UniformInt(int min, int max);
+
+        /**
+         * Draws true with the given probability.
+         * @param probability The probability in [0, 1]
+         * @return The value
+         */
+        bool Bernoulli(double probability);
+
+        /**
+         * Draws a normally distributed value with the Box-Muller transform.
+         * @param mean The mean
+         * @param deviation The standard deviation
+         * @return The value
+         */
+        double Normal(double mean, double deviation);
+
+        /**
+         * Draws a poisson distributed value.
+         * @param mean The mean, not negative
+         * @return The value
+         */
+        size_t Poisson(double mean);
+    };
+}
+
+
+#endif //GBMOT_RANDOM_H
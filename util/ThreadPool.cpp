@@ -0,0 +1,163 @@
+#include "ThreadPool.h"
+
+namespace util
+{
+    namespace
+    {
+        /**
+         * The pool and the queue of the current worker thread
+         */
+        thread_local const ThreadPool* current_pool = nullptr;
+        thread_local size_t current_queue = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t thread_count)
+            : pending_count_(0), unfinished_count_(0), sleeping_count_(0), next_queue_(0),
+              stop_(false)
+    {
+        if (thread_count == 0)
+        {
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            queues_.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+        }
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads_.push_back(std::thread(&ThreadPool::Work, this, i));
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        task_available_.notify_all();
+
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        // Keep tasks submitted by a task on the same thread
+        size_t index;
+        if (current_pool == this)
+        {
+            index = current_queue;
+        }
+        else
+        {
+            index = next_queue_++ % queues_.size();
+        }
+
+        // Counted before it is queued, thus the counts are never too low
+        ++unfinished_count_;
+        ++pending_count_;
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+
+        // A thread going to sleep counts itself before it checks the pending
+        // tasks, thus either it sees the task or the task sees the thread
+        if (sleeping_count_ > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            task_available_.notify_one();
+        }
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        tasks_done_.wait(lock, [this]() { return unfinished_count_ == 0; });
+    }
+
+    size_t ThreadPool::GetThreadCount() const
+    {
+        return threads_.size();
+    }
+
+    bool ThreadPool::PopTask(size_t index, std::function<void()>& task)
+    {
+        // The own tasks in submission order
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            if (!queues_[index]->tasks.empty())
+            {
+                task = std::move(queues_[index]->tasks.front());
+                queues_[index]->tasks.pop_front();
+                --pending_count_;
+                return true;
+            }
+        }
+
+        // The last task of another thread
+        for (size_t i = 1; i < queues_.size(); ++i)
+        {
+            WorkQueue& victim = *queues_[(index + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                --pending_count_;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::FinishTask()
+    {
+        if (--unfinished_count_ == 0)
+        {
+            // Taking the lock orders the notification after the check of a
+            // thread about to wait
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            tasks_done_.notify_all();
+        }
+    }
+
+    void ThreadPool::Work(size_t index)
+    {
+        current_pool = this;
+        current_queue = index;
+
+        while (true)
+        {
+            std::function<void()> task;
+            if (PopTask(index, task))
+            {
+                task();
+                FinishTask();
+                continue;
+            }
+
+            // Sleep until a task is submitted, a pending task may still be
+            // on its way into a queue, thus the queues are searched again
+            std::unique_lock<std::mutex> lock(mutex_);
+            ++sleeping_count_;
+            task_available_.wait(lock, [this]() { return stop_ || pending_count_ > 0; });
+            --sleeping_count_;
+
+            // Finish the remaining tasks before exiting
+            if (stop_ && pending_count_ == 0)
+            {
+                return;
+            }
+        }
+    }
+}
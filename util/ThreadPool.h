@@ -0,0 +1,153 @@
+#ifndef GBMOT_THREADPOOL_H
+#define GBMOT_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+    /**
+     * A fixed number of threads running the submitted tasks.
+     * Every thread has its own task queue and runs its tasks in submission
+     * order. Tasks are distributed round robin, tasks submitted by a running
+     * task are queued on the thread running it. A thread without tasks
+     * steals the most recently queued task of another thread.
+     * Every queue has its own lock, the lock of the pool is only taken to
+     * put a thread without tasks to sleep and to wake it.
+     * The tasks need to handle their own errors, an exception leaving a task
+     * terminates the program.
+     */
+    class ThreadPool
+    {
+    private:
+        /**
+         * The tasks of a single thread
+         */
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /**
+         * The worker threads
+         */
+        std::vector<std::thread> threads_;
+
+        /**
+         * The task queue of every thread
+         */
+        std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+        /**
+         * Guards the stop flag, only taken to sleep and to wake threads
+         */
+        std::mutex mutex_;
+
+        /**
+         * Signaled when a task is submitted to a sleeping pool or the pool
+         * is stopped
+         */
+        std::condition_variable task_available_;
+
+        /**
+         * Signaled when the last unfinished task finished
+         */
+        std::condition_variable tasks_done_;
+
+        /**
+         * The number of queued tasks not taken by a thread yet. Incremented
+         * before a task is queued, thus never less than the queued tasks
+         */
+        std::atomic<size_t> pending_count_;
+
+        /**
+         * The number of submitted tasks not finished yet
+         */
+        std::atomic<size_t> unfinished_count_;
+
+        /**
+         * The number of threads waiting for a task
+         */
+        std::atomic<size_t> sleeping_count_;
+
+        /**
+         * The queue to put the next task submitted from outside into
+         */
+        std::atomic<size_t> next_queue_;
+
+        /**
+         * True, if the threads should exit after the remaining tasks
+         */
+        bool stop_;
+
+        /**
+         * Takes a task from the given queue or steals one from another queue.
+         * Only the locks of the queues are taken.
+         *
+         * @param index The queue of the calling thread
+         * @param task The task to run
+         * @return True, if a task was found
+         */
+        bool PopTask(size_t index, std::function<void()>& task);
+
+        /**
+         * Counts a task as finished and wakes the waiting threads if it was
+         * the last one.
+         */
+        void FinishTask();
+
+        /**
+         * Runs the tasks until the pool is stopped.
+         *
+         * @param index The queue of the thread
+         */
+        void Work(size_t index);
+    public:
+        /**
+         * Creates a new pool and starts the threads.
+         *
+         * @param thread_count The number of threads, zero uses all available
+         *                     hardware threads
+         */
+        ThreadPool(size_t thread_count);
+
+        /**
+         * Runs the remaining tasks and joins the threads.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * Adds a task to run on one of the threads.
+         * Can be called from a running task.
+         *
+         * @param task The task to run
+         */
+        void Submit(std::function<void()> task);
+
+        /**
+         * Blocks until all submitted tasks are finished.
+         * Tasks submitted by running tasks are waited for too.
+         */
+        void Wait();
+
+        /**
+         * Gets the number of threads.
+         *
+         * @return The number of threads
+         */
+        size_t GetThreadCount() const;
+    };
+}
+
+
+#endif //GBMOT_THREADPOOL_H
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include "ValueTable.h"
+
+namespace util
+{
+    namespace
+    {
+        std::string JoinKeys(const std::vector<std::string>& keys)
+        {
+            std::string joined;
+            for (size_t i = 0; i < keys.size(); ++i)
+            {
+                joined += (i > 0 ? "," : "") + keys[i];
+            }
+            return joined;
+        }
+    }
+
+    ValueTable::ValueTable() : row_count_(0)
+    {
+        /* EMPTY */
+    }
+
+    ValueTable::ValueTable(const std::vector<std::string>& keys)
+            : keys_(keys), columns_(keys.size()), row_count_(0)
+    {
+        /* EMPTY */
+    }
+
+    void ValueTable::AppendRows(const std::vector<double>& values)
+    {
+        if (columns_.empty()) return;
+
+        size_t column_count = columns_.size();
+        size_t rows = values.size() / column_count;
+
+        for (size_t column = 0; column < column_count; ++column)
+        {
+            // Grow geometrically, thus appending many small blocks stays linear
+            std::vector<double>& target = columns_[column];
+            if (target.capacity() < row_count_ + rows)
+            {
+                target.reserve(std::max(row_count_ + rows, 2 * target.capacity()));
+            }
+
+            for (size_t row = 0; row < rows; ++row)
+            {
+                target.push_back(values[row * column_count + column]);
+            }
+        }
+
+        row_count_ += rows;
+    }
+
+    void ValueTable::AppendRows(const ValueTable& other)
+    {
+        // Find the column of every key in the other table, the order may differ
+        std::vector<size_t> sources(keys_.size());
+        for (size_t column = 0; column < keys_.size(); ++column)
+        {
+            sources[column] = other.GetColumnIndex(keys_[column]);
+        }
+        if (other.keys_.size() != keys_.size() ||
+                std::find(sources.begin(), sources.end(), other.keys_.size()) != sources.end())
+        {
+            throw "The columns of the tables differ: " + JoinKeys(keys_) + " and " +
+                  JoinKeys(other.keys_);
+        }
+
+        for (size_t column = 0; column < columns_.size(); ++column)
+        {
+            const std::vector<double>& source = other.columns_[sources[column]];
+            columns_[column].insert(columns_[column].end(), source.begin(), source.end());
+        }
+
+        row_count_ += other.row_count_;
+    }
+
+    void ValueTable::AppendRow(const std::vector<double>& values)
+    {
+        for (size_t column = 0; column < columns_.size(); ++column)
+        {
+            columns_[column].push_back(column < values.size() ? values[column] : 0.0);
+        }
+
+        ++row_count_;
+    }
+
+    void ValueTable::Reserve(size_t row_count)
+    {
+        for (auto& column : columns_)
+        {
+            column.reserve(row_count);
+        }
+    }
+
+    void ValueTable::Clear()
+    {
+        for (auto& column : columns_)
+        {
+            column.clear();
+        }
+
+        row_count_ = 0;
+    }
+
+    size_t ValueTable::GetColumnIndex(const std::string& key) const
+    {
+        for (size_t i = 0; i < keys_.size(); ++i)
+        {
+            if (keys_[i] == key)
+            {
+                return i;
+            }
+        }
+
+        return keys_.size();
+    }
+
+    const std::vector<double>& ValueTable::GetColumn(const std::string& key)
+    {
+        size_t index = GetColumnIndex(key);
+
+        // Missing values are treated as zero
+        if (index == keys_.size())
+        {
+            keys_.push_back(key);
+            columns_.push_back(std::vector<double>(row_count_, 0.0));
+        }
+
+        return columns_[index];
+    }
+
+    const std::vector<double>& ValueTable::GetColumn(size_t index) const
+    {
+        return columns_[index];
+    }
+
+    const std::vector<std::string>& ValueTable::GetKeys() const
+    {
+        return keys_;
+    }
+
+    size_t ValueTable::GetColumnCount() const
+    {
+        return columns_.size();
+    }
+
+    size_t ValueTable::GetRowCount() const
+    {
+        return row_count_;
+    }
+}
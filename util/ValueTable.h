@@ -0,0 +1,134 @@
+#ifndef GBMOT_VALUETABLE_H
+#define GBMOT_VALUETABLE_H
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace util
+{
+    /**
+     * Class for storing values read from a CSV file column by column.
+     * Every key of the header has its own contiguous column, thus the keys
+     * only need to be resolved once per column instead of once per value.
+     */
+    class ValueTable
+    {
+    private:
+        /**
+         * The keys of the columns
+         */
+        std::vector<std::string> keys_;
+
+        /**
+         * The values, the first dimension is the column, the second the row.
+         * Adding a column does not invalidate references to other columns.
+         */
+        std::deque<std::vector<double>> columns_;
+
+        /**
+         * The number of rows
+         */
+        size_t row_count_;
+    public:
+        /**
+         * Creates an empty table without any columns.
+         */
+        ValueTable();
+
+        /**
+         * Creates an empty table with one column per key.
+         *
+         * @param keys The keys of the columns
+         */
+        ValueTable(const std::vector<std::string>& keys);
+
+        /**
+         * Appends the given rows.
+         * The values are stored row major, one value per column in each row.
+         *
+         * @param values The values to append, the size needs to be a multiple
+         *               of the column count
+         */
+        void AppendRows(const std::vector<double>& values);
+
+        /**
+         * Appends all rows of the given table.
+         * Both tables need to have the same keys, the columns are matched by
+         * their key. Throws if the keys differ.
+         *
+         * @param other The table to take the rows from
+         */
+        void AppendRows(const ValueTable& other);
+
+        /**
+         * Appends a single row.
+         *
+         * @param values The values of the row, one value per column
+         */
+        void AppendRow(const std::vector<double>& values);
+
+        /**
+         * Reserves memory for the given number of rows in every column.
+         *
+         * @param row_count The number of rows to reserve memory for
+         */
+        void Reserve(size_t row_count);
+
+        /**
+         * Removes all rows but keeps the columns.
+         */
+        void Clear();
+
+        /**
+         * Gets the index of the column with the given key.
+         *
+         * @param key The key of the column
+         * @return The index of the column or the column count if there is no
+         *         column with the given key
+         */
+        size_t GetColumnIndex(const std::string& key) const;
+
+        /**
+         * Gets the column with the given key.
+         * If there is no column with the given key, a column filled with zeros
+         * is added.
+         *
+         * @param key The key of the column
+         * @return The values of the column
+         */
+        const std::vector<double>& GetColumn(const std::string& key);
+
+        /**
+         * Gets the column at the given index.
+         *
+         * @param index The index of the column
+         * @return The values of the column
+         */
+        const std::vector<double>& GetColumn(size_t index) const;
+
+        /**
+         * Gets the keys of all columns.
+         *
+         * @return The keys
+         */
+        const std::vector<std::string>& GetKeys() const;
+
+        /**
+         * Gets the number of columns.
+         *
+         * @return The column count
+         */
+        size_t GetColumnCount() const;
+
+        /**
+         * Gets the number of rows.
+         *
+         * @return The row count
+         */
+        size_t GetRowCount() const;
+    };
+}
+
+
+#endif //GBMOT_VALUETABLE_H
@@ -6,9 +6,299 @@
 #include "Logger.h"
 #include "../core/ObjectDataAngular.h"
 #include "FileIO.h"
+#include "ImagePrefetcher.h"
+#include "../core/FrameIndex.h"
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <thread>
 
 namespace util
 {
+    Visualizer::Visualizer()
+    {
+        prefetch_size_ = 16;
+        decode_thread_count_ = std::min(std::max(std::thread::hardware_concurrency(), 1u), 4u);
+        video_codec_ = "MJPG";
+        video_fps_ = 24.0;
+        headless_ = false;
+    }
+
+    void Visualizer::SetVideoOutput(const std::string& video_file, const std::string& codec,
+                                    double fps)
+    {
+        video_file_ = video_file;
+        video_codec_ = codec;
+        video_fps_ = fps;
+    }
+
+    void Visualizer::SetHeadless(bool headless)
+    {
+        headless_ = headless;
+    }
+
+    void Visualizer::SetPrefetchSize(size_t prefetch_size)
+    {
+        prefetch_size_ = prefetch_size;
+    }
+
+    void Visualizer::SetDecodeThreadCount(size_t thread_count)
+    {
+        decode_thread_count_ = thread_count;
+    }
+
+    void Visualizer::ExportFrames(std::vector<core::TrackletPtr>& tracks,
+                                  std::vector<cv::Scalar>& colors,
+                                  const std::string& image_folder,
+                                  const std::vector<std::string>& image_files,
+                                  const FrameFunction& encode, const FrameFunction& write)
+    {
+        // Invert the tracks once, thus drawing a frame only visits the
+        // objects in that frame
+        core::FrameIndex index(tracks);
+
+        size_t thread_count = decode_thread_count_;
+        if (thread_count == 0)
+        {
+            thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        // At most this many finished frames wait for the writer
+        size_t window_size = std::max(prefetch_size_, thread_count);
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::map<size_t, std::pair<cv::Mat, std::vector<unsigned char>>> finished;
+        size_t next_frame = 0;
+        size_t next_write = 0;
+
+        // The first exception thrown by a worker or the writer, all threads
+        // stop once it is set and it is rethrown after they are joined
+        std::exception_ptr error;
+
+        // Every worker decodes, draws and encodes whole frames
+        auto work = [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                condition.wait(lock, [&]
+                {
+                    return error || next_frame >= image_files.size() ||
+                           next_frame < next_write + window_size;
+                });
+                if (error || next_frame >= image_files.size()) break;
+
+                size_t frame = next_frame++;
+                lock.unlock();
+
+                cv::Mat image;
+                std::vector<unsigned char> buffer;
+                try
+                {
+                    image = cv::imread(image_folder + "/" + image_files[frame], 1);
+                    for (auto& entry : index.GetFrame(frame))
+                    {
+                        entry.object->Visualize(image, colors[entry.track]);
+                    }
+
+                    encode(frame, image, buffer);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    condition.notify_all();
+                    break;
+                }
+
+                lock.lock();
+                finished[frame] = std::make_pair(image, std::vector<unsigned char>());
+                finished[frame].second.swap(buffer);
+                condition.notify_all();
+            }
+        };
+
+        // The writer consumes the frames in order
+        auto write_ordered = [&]()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (next_write < image_files.size())
+            {
+                condition.wait(lock, [&] { return error || finished.count(next_write) > 0; });
+                if (error) break;
+
+                std::pair<cv::Mat, std::vector<unsigned char>> result;
+                result.first = finished[next_write].first;
+                result.second.swap(finished[next_write].second);
+                finished.erase(next_write);
+                size_t frame = next_write;
+                lock.unlock();
+
+                try
+                {
+                    write(frame, result.first, result.second);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    condition.notify_all();
+                    break;
+                }
+
+                lock.lock();
+                ++next_write;
+                condition.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads.push_back(std::thread(work));
+        }
+        std::thread writer(write_ordered);
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        writer.join();
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void Visualizer::WriteFrames(std::vector<core::TrackletPtr>& tracks,
+                                 std::vector<cv::Scalar>& colors,
+                                 const std::string& image_folder,
+                                 const std::vector<std::string>& image_files,
+                                 const std::string& output_folder)
+    {
+        bool write_images = !output_folder.empty();
+        bool write_video = !video_file_.empty();
+        int fourcc = 0;
+        if (write_video)
+        {
+            if (video_codec_.size() == 4)
+            {
+                fourcc = cv::VideoWriter::fourcc(video_codec_[0], video_codec_[1],
+                                                 video_codec_[2], video_codec_[3]);
+            }
+            else
+            {
+                util::Logger::LogError("Invalid video codec: " + video_codec_);
+                write_video = false;
+            }
+        }
+        if (!write_images && !write_video)
+        {
+            return;
+        }
+
+        // Encode the images in the workers with the format of the input file,
+        // the video writer encodes the frames in the writer thread
+        auto encode = [&](size_t frame, cv::Mat& image, std::vector<unsigned char>& buffer)
+        {
+            if (write_images)
+            {
+                std::string extension = ".png";
+                size_t dot = image_files[frame].rfind('.');
+                if (dot != std::string::npos)
+                {
+                    extension = image_files[frame].substr(dot);
+                }
+                if (image.empty() || !cv::imencode(extension, image, buffer))
+                {
+                    buffer.clear();
+                }
+            }
+
+            // Only the encoded image is kept if no video is written
+            if (!write_video)
+            {
+                image = cv::Mat();
+            }
+        };
+
+        // The video is opened with the size of the first frame
+        cv::VideoWriter writer;
+        cv::Size frame_size;
+        auto write = [&](size_t frame, cv::Mat& image, std::vector<unsigned char>& buffer)
+        {
+            if (write_images)
+            {
+                WriteImage(output_folder + image_files[frame], buffer);
+            }
+            if (write_video)
+            {
+                WriteVideoFrame(writer, frame_size, fourcc, image, image_files[frame]);
+            }
+        };
+
+        ExportFrames(tracks, colors, image_folder, image_files, encode, write);
+
+        writer.release();
+    }
+
+    void Visualizer::WriteImage(const std::string& file_name,
+                                const std::vector<unsigned char>& buffer)
+    {
+        if (buffer.empty())
+        {
+            util::Logger::LogError("Unable to encode image: " + file_name);
+            return;
+        }
+
+        std::ofstream out(file_name, std::ios::out | std::ios::binary);
+        if (!out.is_open())
+        {
+            util::Logger::LogError("Unable to open file: " + file_name);
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    }
+
+    void Visualizer::WriteVideoFrame(cv::VideoWriter& writer, cv::Size& frame_size, int fourcc,
+                                     const cv::Mat& image, const std::string& image_file)
+    {
+        if (image.empty())
+        {
+            util::Logger::LogError("Unable to read image: " + image_file);
+            return;
+        }
+
+        if (!writer.isOpened())
+        {
+            frame_size = image.size();
+            if (!writer.open(video_file_, fourcc, video_fps_, frame_size, true))
+            {
+                util::Logger::LogError("Unable to open video: " + video_file_);
+                return;
+            }
+        }
+
+        if (image.size() != frame_size)
+        {
+            util::Logger::LogError("Image size differs from the video size: " + image_file);
+            return;
+        }
+
+        writer.write(image);
+    }
+
     int Visualizer::GetTime()
     {
         return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -20,13 +310,18 @@ namespace util
                              std::string output_path, std::string title, size_t first_frame,
                              int play_fps, int grid_width, int grid_height)
     {
-        util::Logger::LogInfo("Displaying data");
+        GBMOT_LOG_INFO("Displaying data");
 
         size_t current_frame = first_frame;
 
         // Load images
         std::vector<std::string> image_files;
         util::FileIO::ListFiles(image_folder, image_files);
+        std::vector<std::string> image_paths;
+        for (auto& image_file : image_files)
+        {
+            image_paths.push_back(image_folder + "/" + image_file);
+        }
 
         // Generate a random color for each individual track
         std::vector<cv::Scalar> colors;
@@ -47,33 +342,35 @@ namespace util
 
         //TODO move to extra class
         //TODO create necessary directories
-        if (output)
+        // The images and the video are drawn from the same decoded frames
+        if (output || !video_file_.empty())
         {
-            util::Logger::LogInfo("Start writing output images");
-            for (size_t i = 0; i < image_files.size(); ++i)
-            {
-                cv::Mat image = cv::imread(image_folder + "/" + image_files[i], 1);
-                for (size_t j = 0; j < tracks.size(); ++j)
-                {
-                    tracks[j]->Visualize(image, colors[j], i, 0, 0);
-                }
-                cv::imwrite(output_path + "/images/" + image_files[i], image);
-            }
-            util::Logger::LogInfo("Finished writing output images");
+            GBMOT_LOG_INFO("Start writing output images and video");
+            WriteFrames(tracks, colors, image_folder, image_files,
+                        output ? output_path + "/images/" : "");
+            GBMOT_LOG_INFO("Finished writing output images and video");
+        }
+
+        // Batch servers have no display to open a window on
+        if (headless_)
+        {
+            return;
         }
 
         // Create window
         cv::namedWindow(title, cv::WindowFlags::WINDOW_AUTOSIZE);
 
         // Display frames and data
+        ImagePrefetcher prefetcher(image_paths, prefetch_size_, decode_thread_count_);
         int target_delay = 1000 / play_fps;
         int last_frame_time = GetTime();
         int current_delay, current_frame_time;
         bool play = false;
+        bool reverse = false;
         while (true)
         {
-            // Display image
-            cv::Mat image = cv::imread(image_folder + "/" + image_files[current_frame], 1);
+            // Display image, the cached image is kept unmodified
+            cv::Mat image = prefetcher.Get(current_frame, reverse).clone();
 
             // Draw grid
             if (grid_width > 0 && grid_height > 0)
@@ -105,16 +402,11 @@ namespace util
             int key;
             if (play)
             {
+                // Only wait for the remaining time of the frame, but at least
+                // once to let the window draw the image
                 current_frame_time = GetTime();
-                current_delay = last_frame_time - current_frame_time;
-                if (current_delay < target_delay)
-                {
-                    key = cv::waitKey(target_delay - current_delay);
-                }
-                else
-                {
-                    key = 0;
-                }
+                current_delay = current_frame_time - last_frame_time;
+                key = cv::waitKey(std::max(target_delay - current_delay, 1));
                 last_frame_time = GetTime();
             }
             else
@@ -134,6 +426,7 @@ namespace util
 
             if (play || key == 1048676) // D
             {
+                reverse = false;
                 if (current_frame < image_files.size() - 1)
                 {
                     current_frame++;
@@ -146,6 +439,7 @@ namespace util
             }
             else if (key == 1048673) // A
             {
+                reverse = true;
                 if (current_frame > 0)
                 {
                     current_frame--;
@@ -11,6 +11,7 @@
 #include "../core/Tracklet.h"
 #include "dirent.h"
 #include <chrono>
+#include <functional>
 #include <random>
 
 namespace util
@@ -21,16 +22,147 @@ namespace util
     class Visualizer
     {
     private:
+        /**
+         * The number of decoded images kept around the displayed frame
+         */
+        size_t prefetch_size_;
+
+        /**
+         * The number of threads decoding images in the background or
+         * rendering the output images
+         */
+        size_t decode_thread_count_;
+
+        /**
+         * The file to write the visualized frames into as a video, empty to
+         * not write a video
+         */
+        std::string video_file_;
+
+        /**
+         * The four character code of the video codec
+         */
+        std::string video_codec_;
+
+        /**
+         * The frame rate of the video
+         */
+        double video_fps_;
+
+        /**
+         * True, if no window should be opened
+         */
+        bool headless_;
+
         /**
          * Gets the current time in milliseconds.
          * @return the current time in ms
          */
         int GetTime();
+
+        /**
+         * Function called with the frame index, the visualized image and an
+         * encoding buffer.
+         */
+        typedef std::function<void(size_t, cv::Mat&, std::vector<unsigned char>&)> FrameFunction;
+
+        /**
+         * Draws the tracks onto every image. The frames are decoded, drawn and
+         * encoded by multiple workers and passed to a single writer thread in
+         * order. If a worker or the writer throws, all threads stop and the
+         * first exception is rethrown once they are joined.
+         * @param tracks The tracks to draw
+         * @param colors The color of every track
+         * @param image_folder The folder containing the images
+         * @param image_files The names of the images, the index is the frame
+         * @param encode Called by the workers after drawing a frame
+         * @param write Called by the writer thread for every frame in order
+         */
+        void ExportFrames(std::vector<core::TrackletPtr>& tracks,
+                          std::vector<cv::Scalar>& colors,
+                          const std::string& image_folder,
+                          const std::vector<std::string>& image_files,
+                          const FrameFunction& encode, const FrameFunction& write);
+
+        /**
+         * Draws the tracks onto every image and writes the images into the
+         * output folder and the frames into the video file, if one is set.
+         * Every frame is decoded and drawn once for both outputs. The images
+         * are encoded in parallel, the video is encoded by the writer thread.
+         * @param tracks The tracks to draw
+         * @param colors The color of every track
+         * @param image_folder The folder containing the images
+         * @param image_files The names of the images, the index is the frame
+         * @param output_folder The folder to write the images into, including
+         *                      the trailing separator, empty to not write images
+         */
+        void WriteFrames(std::vector<core::TrackletPtr>& tracks,
+                         std::vector<cv::Scalar>& colors,
+                         const std::string& image_folder,
+                         const std::vector<std::string>& image_files,
+                         const std::string& output_folder);
+
+        /**
+         * Writes an encoded image into a file.
+         * @param file_name The file to write
+         * @param buffer The encoded image, empty if the encoding failed
+         */
+        void WriteImage(const std::string& file_name, const std::vector<unsigned char>& buffer);
+
+        /**
+         * Writes a frame into the video, the video is opened with the size
+         * of the first frame.
+         * @param writer The video writer
+         * @param frame_size The size of the video, set when it is opened
+         * @param fourcc The four character code of the codec
+         * @param image The visualized frame
+         * @param image_file The name of the image, for error messages
+         */
+        void WriteVideoFrame(cv::VideoWriter& writer, cv::Size& frame_size, int fourcc,
+                             const cv::Mat& image, const std::string& image_file);
     public:
+        /**
+         * Creates a visualizer prefetching 16 images with up to four threads.
+         */
+        Visualizer();
+
+        /**
+         * Sets a video file to write the visualized frames into when
+         * displaying. The video has the size of the first image.
+         * @param video_file The file to write, empty to not write a video
+         * @param codec The four character code of the codec, e.g. MJPG
+         * @param fps The frame rate of the video
+         */
+        void SetVideoOutput(const std::string& video_file, const std::string& codec,
+                            double fps);
+
+        /**
+         * Sets if a window should be opened when displaying. Without a window
+         * only the output images and video are written.
+         * @param headless True, to not open a window
+         */
+        void SetHeadless(bool headless);
+
+        /**
+         * Sets the number of decoded images kept around the displayed frame.
+         * @param prefetch_size The number of images
+         */
+        void SetPrefetchSize(size_t prefetch_size);
+
+        /**
+         * Sets the number of threads decoding images in the background and
+         * rendering the output images.
+         * @param thread_count The number of threads, zero to use all available
+         *                     hardware threads
+         */
+        void SetDecodeThreadCount(size_t thread_count);
+
         /**
          * Displays the given tracks in an window.
          * Use D for next frame, A for previous frame, F to toggle auto play and
          * ESC to exit.
+         * The images are decoded in background threads ahead of the current
+         * frame in the stepping direction.
          * If a grid size greater zero is specified a grid will be overlayed.
          *
          * @param tracks The tracks to display